@@ -0,0 +1,148 @@
+/// \file AimBatch.cpp
+/// \brief Code for the turret aiming batch CAimBatch.
+
+#include "AimBatch.h"
+
+#include <cfloat>
+
+#include <emmintrin.h>
+
+/// Coefficients of the odd polynomial that approximates `atan` on [0, 1],
+/// from Hastings. With float rounding its error is less than 1.2e-5 radians,
+/// thousands of times smaller than the angle within which a turret stops
+/// swivelling.
+
+static const float ATAN_C1 =  0.9998660f; ///< Coefficient of x.
+static const float ATAN_C3 = -0.3302995f; ///< Coefficient of x^3.
+static const float ATAN_C5 =  0.1801410f; ///< Coefficient of x^5.
+static const float ATAN_C7 = -0.0851330f; ///< Coefficient of x^7.
+static const float ATAN_C9 =  0.0208351f; ///< Coefficient of x^9.
+
+/// Compute `atan2` of four pairs of numbers at once. The smaller of `|x|`
+/// and `|y|` is divided by the larger to get a ratio in [0, 1] whose `atan`
+/// is the polynomial, which is then reflected into the right octant by the
+/// signs and relative sizes of `x` and `y`. The larger one is kept above the
+/// smallest normal float, so that `atan2(0, 0)` is 0 instead of NaN.
+/// \param y Four y coordinates.
+/// \param x Four x coordinates.
+/// \return Four angles in [-pi, pi].
+
+static inline __m128 Atan2(__m128 y, __m128 x){
+  const __m128 sign = _mm_set1_ps(-0.0f); //sign bit only
+  const __m128 ax = _mm_andnot_ps(sign, x); //|x|
+  const __m128 ay = _mm_andnot_ps(sign, y); //|y|
+
+  const __m128 lo = _mm_min_ps(ax, ay); //smaller
+  const __m128 hi = _mm_max_ps(_mm_max_ps(ax, ay), _mm_set1_ps(FLT_MIN)); //larger
+  const __m128 a = _mm_div_ps(lo, hi); //ratio in [0, 1]
+  const __m128 s = _mm_mul_ps(a, a); //ratio squared
+
+  __m128 r = _mm_set1_ps(ATAN_C9); //Horner's rule
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C7));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C5));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C3));
+  r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(ATAN_C1));
+  r = _mm_mul_ps(r, a); //atan of ratio, in [0, pi/4]
+
+  const __m128 steep = _mm_cmpgt_ps(ay, ax); //more than 45 degrees from the x axis
+  r = _mm_or_ps(_mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(XM_PIDIV2), r)), _mm_andnot_ps(steep, r));
+
+  const __m128 left = _mm_cmplt_ps(x, _mm_setzero_ps()); //pointing left
+  r = _mm_or_ps(_mm_and_ps(left, _mm_sub_ps(_mm_set1_ps(XM_PI), r)), _mm_andnot_ps(left, r));
+
+  return _mm_or_ps(r, _mm_and_ps(sign, y)); //below the x axis is negative
+} //Atan2
+
+/// Construct a batch with the tracking settings shared by every turret.
+/// \param delta Angle discrepancy within which a turret stops swivelling and can fire.
+/// \param speed Rotation speed when tracking.
+
+CAimBatch::CAimBatch(float delta, float speed):
+  m_fAngleDelta(delta), m_fTrackingSpeed(speed){
+} //constructor
+
+/// Set the number of aims. The arrays are padded with zeros to a multiple of
+/// four, and only reallocated if they grow.
+/// \param n Number of aims.
+
+void CAimBatch::Resize(size_t n){
+  m_nSize = n;
+  const size_t padded = (n + 3) & ~(size_t)3; //next multiple of 4
+
+  m_vecX.assign(padded, 0.0f);
+  m_vecY.assign(padded, 0.0f);
+  m_vecRoll.assign(padded, 0.0f);
+  m_vecRotSpeed.resize(padded);
+  m_vecOnTarget.resize(padded);
+} //Resize
+
+/// Set one aim. Aims may be set from different threads at the same time as
+/// long as they have different indices.
+/// \param i Index, less than the number of aims.
+/// \param v Vector from the turret to its target.
+/// \param roll Turret orientation.
+
+void CAimBatch::Set(size_t i, const Vector2& v, float roll){
+  m_vecX[i] = v.x;
+  m_vecY[i] = v.y;
+  m_vecRoll[i] = roll;
+} //Set
+
+/// Aim all turrets, four at a time. The difference between each turret's
+/// orientation and the angle to its target is wrapped into [-pi, pi] by
+/// subtracting the nearest multiple of 2 pi, so orientations needn't be
+/// normalized. A turret swivels clockwise if the difference is more than the
+/// allowable discrepancy, counterclockwise if it is less than minus that,
+/// and not at all otherwise, and it can fire if the difference is strictly
+/// within the allowable discrepancy.
+
+void CAimBatch::Aim(){
+  const __m128 delta = _mm_set1_ps(m_fAngleDelta);
+  const __m128 minusDelta = _mm_set1_ps(-m_fAngleDelta);
+  const __m128 speed = _mm_set1_ps(m_fTrackingSpeed);
+  const __m128 minusSpeed = _mm_set1_ps(-m_fTrackingSpeed);
+  const __m128 twoPi = _mm_set1_ps(XM_2PI);
+  const __m128 invTwoPi = _mm_set1_ps(1.0f/XM_2PI);
+  const __m128 sign = _mm_set1_ps(-0.0f); //sign bit only
+
+  for(size_t i=0; i<m_vecX.size(); i+=4){
+    const __m128 theta = Atan2(_mm_loadu_ps(&m_vecY[i]), _mm_loadu_ps(&m_vecX[i])); //angle to target
+    __m128 diff = _mm_sub_ps(_mm_loadu_ps(&m_vecRoll[i]), theta); //difference with orientation
+
+    const __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(diff, invTwoPi))); //nearest whole turns
+    diff = _mm_sub_ps(diff, _mm_mul_ps(turns, twoPi)); //now in [-pi, pi]
+
+    const __m128 cw = _mm_cmpgt_ps(diff, delta); //turn clockwise
+    const __m128 ccw = _mm_cmplt_ps(diff, minusDelta); //turn counterclockwise
+    _mm_storeu_ps(&m_vecRotSpeed[i], _mm_or_ps(_mm_and_ps(cw, minusSpeed), _mm_and_ps(ccw, speed)));
+
+    const int on = _mm_movemask_ps(_mm_cmplt_ps(_mm_andnot_ps(sign, diff), delta)); //facing close enough
+
+    for(size_t j=0; j<4; j++)
+      m_vecOnTarget[i + j] = (uint8_t)((on >> j) & 1);
+  } //for
+} //Aim
+
+/// Get the number of aims.
+/// \return Number of aims.
+
+const size_t CAimBatch::GetSize() const{
+  return m_nSize;
+} //GetSize
+
+/// Get the rotation speed worked out by the last `Aim()`.
+/// \param i Index.
+/// \return Rotation speed.
+
+const float CAimBatch::GetRotSpeed(size_t i) const{
+  return m_vecRotSpeed[i];
+} //GetRotSpeed
+
+/// Get whether a turret was facing close enough to its target to fire at the
+/// last `Aim()`.
+/// \param i Index.
+/// \return true if close enough to fire.
+
+const bool CAimBatch::GetOnTarget(size_t i) const{
+  return m_vecOnTarget[i] != 0;
+} //GetOnTarget
@@ -0,0 +1,49 @@
+/// \file AimBatch.h
+/// \brief Interface for the turret aiming batch CAimBatch.
+
+#ifndef __L4RC_GAME_AIMBATCH_H__
+#define __L4RC_GAME_AIMBATCH_H__
+
+#include "GameDefines.h"
+
+#include <cstdint>
+#include <vector>
+
+/// \brief A batch of turret aims.
+///
+/// The aiming of many turrets at once. Each aim is the vector from a turret
+/// to its target and the turret's orientation, and the result is the speed
+/// that the turret should swivel at, toward the target at the tracking speed
+/// or not at all if it is close enough, and whether it is close enough to
+/// fire. The inputs and results are kept in separate arrays, one value per
+/// turret, rather than in one array of structures, so that `Aim()` can load
+/// four turrets at a time into SSE registers and work out all four angles to
+/// their targets with a polynomial approximation of `atan2f` instead of four
+/// library calls. The arrays are padded to a multiple of four so that there
+/// is no scalar tail, and they keep their memory from one batch to the next.
+
+class CAimBatch{
+  private:
+    size_t m_nSize = 0; ///< Number of aims.
+    float m_fAngleDelta = 0; ///< Allowable angle discrepancy.
+    float m_fTrackingSpeed = 0; ///< Rotation speed when tracking.
+
+    std::vector<float> m_vecX; ///< Target x offsets.
+    std::vector<float> m_vecY; ///< Target y offsets.
+    std::vector<float> m_vecRoll; ///< Turret orientations.
+    std::vector<float> m_vecRotSpeed; ///< Resulting rotation speeds.
+    std::vector<uint8_t> m_vecOnTarget; ///< Resulting facing close enough to fire flags.
+
+  public:
+    CAimBatch(float=0.05f, float=1.7f); ///< Constructor.
+
+    void Resize(size_t); ///< Set number of aims.
+    void Set(size_t, const Vector2&, float); ///< Set an aim.
+    void Aim(); ///< Aim all turrets.
+
+    const size_t GetSize() const; ///< Get number of aims.
+    const float GetRotSpeed(size_t) const; ///< Get a rotation speed.
+    const bool GetOnTarget(size_t) const; ///< Get whether facing close enough to fire.
+}; //CAimBatch
+
+#endif //__L4RC_GAME_AIMBATCH_H__
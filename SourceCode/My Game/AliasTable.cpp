@@ -0,0 +1,75 @@
+/// \file AliasTable.cpp
+/// \brief Code for the alias table CAliasTable.
+
+#include "AliasTable.h"
+
+#include <algorithm>
+
+/// Build the table from a list of weights by Vose's method. Scale the weights
+/// so that they average 1, then sort the outcomes into those under 1 and
+/// those at or over. Repeatedly fill the column of an outcome under 1 with
+/// its own probability and the rest from an outcome over 1, which then has
+/// that much less left to give and moves to the other list if it drops
+/// under 1. Whatever is left over at the end is 1 give or take rounding
+/// error. Negative weights count as zero. If the weights are all zero, the
+/// table is empty.
+/// \param w Weights, one per outcome.
+
+void CAliasTable::Build(const std::vector<float>& w){
+  m_vecProb.clear();
+  m_vecAlias.clear();
+
+  const UINT n = (UINT)w.size(); //number of outcomes
+  float sum = 0; //total weight
+
+  for(float f: w)
+    sum += std::max(f, 0.0f);
+
+  if(n == 0 || sum <= 0)return; //nothing to pick from
+
+  m_vecProb.resize(n);
+  m_vecAlias.resize(n);
+
+  std::vector<float> scaled(n); //weights scaled to average 1
+  std::vector<UINT> small, large; //outcomes under 1, and at or over
+
+  for(UINT i=0; i<n; i++){
+    scaled[i] = std::max(w[i], 0.0f)*n/sum;
+    (scaled[i] < 1.0f? small: large).push_back(i);
+  } //for
+
+  while(!small.empty() && !large.empty()){
+    const UINT s = small.back(); small.pop_back();
+    const UINT l = large.back(); large.pop_back();
+
+    m_vecProb[s] = scaled[s];
+    m_vecAlias[s] = l;
+
+    scaled[l] = (scaled[l] + scaled[s]) - 1.0f; //what l has left to give
+    (scaled[l] < 1.0f? small: large).push_back(l);
+  } //while
+
+  for(UINT i: large){ //full columns
+    m_vecProb[i] = 1.0f;
+    m_vecAlias[i] = i;
+  } //for
+
+  for(UINT i: small){ //full columns short by rounding error
+    m_vecProb[i] = 1.0f;
+    m_vecAlias[i] = i;
+  } //for
+} //Build
+
+/// Test whether there is anything to pick from.
+/// \return true if there are no outcomes with weight.
+
+const bool CAliasTable::empty() const{
+  return m_vecProb.empty();
+} //empty
+
+/// Get the number of outcomes, including any with zero weight.
+/// \return Number of outcomes.
+
+const size_t CAliasTable::size() const{
+  return m_vecProb.size();
+} //size
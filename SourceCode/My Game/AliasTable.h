@@ -0,0 +1,45 @@
+/// \file AliasTable.h
+/// \brief Interface for the alias table CAliasTable.
+
+#ifndef __L4RC_GAME_ALIASTABLE_H__
+#define __L4RC_GAME_ALIASTABLE_H__
+
+#include "Defines.h"
+
+#include <vector>
+
+/// \brief An alias table.
+///
+/// Picks one of a fixed set of outcomes at random with given weights in
+/// constant time, however many outcomes there are, using Walker's alias
+/// method as built by Vose. Each outcome gets a column that holds the
+/// probability of keeping it and an alias to use instead otherwise, so a
+/// sample is one random column and one random float compared against it.
+/// Building the table takes time linear in the number of outcomes, so it is
+/// built once when the weights are loaded.
+
+class CAliasTable{
+  private:
+    std::vector<float> m_vecProb; ///< Probability of keeping each column.
+    std::vector<UINT> m_vecAlias; ///< Outcome to use instead of each column.
+
+  public:
+    void Build(const std::vector<float>&); ///< Build from weights.
+
+    const bool empty() const; ///< Has no outcomes.
+    const size_t size() const; ///< Number of outcomes.
+
+    template<class T> const UINT Sample(T&) const; ///< Pick an outcome.
+}; //CAliasTable
+
+/// Pick an outcome at random with probability proportional to its weight.
+/// The table must not be empty.
+/// \param rng Random number generator with `Below()` and `Float()`.
+/// \return Index of the outcome picked.
+
+template<class T> const UINT CAliasTable::Sample(T& rng) const{
+  const UINT i = (UINT)rng.Below((uint32_t)m_vecProb.size()); //column
+  return rng.Float() < m_vecProb[i]? i: m_vecAlias[i];
+} //Sample
+
+#endif //__L4RC_GAME_ALIASTABLE_H__
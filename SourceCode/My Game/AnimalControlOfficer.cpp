@@ -1,64 +1,121 @@
-/// \file AnimalControlOfficer.cpp
-/// \brief Code for the Animal Control Officer object class CAnimalControlOfficer.
-
-#include "AnimalControlOfficer.h"
-#include "ComponentIncludes.h"
-#include "Particle.h"
-#include "ParticleEngine.h"
-#include "Helpers.h"
-#include "Player.h"
-
-/// Create and initialize an AnimalControlOfficer object given its initial position.
-/// \param pos Initial position of AnimalControlOfficer.
-
-CAnimalControlOfficer::CAnimalControlOfficer(const Vector2& pos) :
-    CObject(eSprite::AnimalControlOfficer, pos)
-{
-    m_fRoll = -XM_PIDIV2; //facing up
-    m_vVelocity = Vector2(0.0f, 64.0f); //going up
-    m_fXScale = m_fYScale = 0.5f; //scale
-    m_fRadius *= m_fXScale; //scale the bounding circle radius
-
-    m_bIsTarget = true;
-    m_bStatic = false;
-    m_bIsAnimalControlOfficer = true;
-} //constructor
-
-/// Destructor.
-
-CAnimalControlOfficer::~CAnimalControlOfficer() {
-} //destructor
-
-void CAnimalControlOfficer::move() {
-    if (m_pPlayer != nullptr)
-    {
-        Follow(m_pPlayer->m_vPos);
-        CObject::move(); //move like a default object
-    }
-} //move
-
-void CAnimalControlOfficer::Follow(const Vector2& pos) {
-    Vector2 v = pos - m_vPos; //vector from target to ghost
-
-    if (abs(v.x) > 50 && abs(v.y) > 50)
-    {
-        v.x = v.x / 8;
-        v.y = v.y / 8;
-        m_vVelocity = v;
-    }
-    else if (abs(v.x) > 25 && abs(v.y) > 25)
-    {
-        v.x = v.x / 4;
-        v.x = v.x / 4;
-    }
-    else
-    {
-        v.x = v.x;
-        v.y = v.y;
-        m_vVelocity = v;
-    }
-} //Follow
-
-void CAnimalControlOfficer::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
-    if (m_bDead)return; //already dead, bail out
+/// \file AnimalControlOfficer.cpp
+/// \brief Code for the Animal Control Officer object class CAnimalControlOfficer.
+
+#include "AnimalControlOfficer.h"
+#include "ComponentIncludes.h"
+#include "Particle.h"
+#include "ParticleEngine.h"
+#include "Helpers.h"
+#include "Player.h"
+#include "PathHierarchy.h"
+#include "TileManager.h"
+
+/// Create and initialize an AnimalControlOfficer object given its initial position.
+/// \param pos Initial position of AnimalControlOfficer.
+
+CAnimalControlOfficer::CAnimalControlOfficer(const Vector2& pos) :
+    CObject(eSprite::AnimalControlOfficer, pos)
+{
+    Roll() = -XM_PIDIV2; //facing up
+    m_bSerialMove = true; //shares the path finders
+
+    SetFlag(eObjectFlag::Target);
+    SetFlag(eObjectFlag::AnimalControlOfficer);
+} //constructor
+
+/// Destructor.
+
+CAnimalControlOfficer::~CAnimalControlOfficer() {
+} //destructor
+
+void CAnimalControlOfficer::move() {
+    if (m_pPlayer != nullptr)
+    {
+        Follow(m_pPlayer->GetPos());
+        CObject::move(); //move like a default object
+    }
+} //move
+
+/// Chase the player. When more than 50 units away, head along a path to the
+/// player, which goes around the walls, at a speed that grows with the
+/// length of the rest of the path. If there is no path, head straight at the
+/// player at a speed that grows with distance instead. When close, home
+/// straight in.
+/// \param pos Player position.
+
+void CAnimalControlOfficer::Follow(const Vector2& pos) {
+    Vector2 v = pos - Pos(); //vector from officer to target
+
+    if (v.LengthSquared() > 50 * 50)
+    {
+        float len = 0; //length of the rest of the path
+        const Vector2 dir = NextWaypoint(pos, len); //way around the walls
+        if (dir.LengthSquared() > 0)v = len * dir; //distance along the path
+
+        v.x = v.x / 8;
+        v.y = v.y / 8;
+        Velocity() = v;
+    }
+    else if (v.LengthSquared() > 25 * 25)
+    {
+        v.x = v.x / 4;
+        v.x = v.x / 4;
+    }
+    else
+    {
+        v.x = v.x;
+        v.y = v.y;
+        Velocity() = v;
+    }
+} //Follow
+
+/// Get the direction to the next waypoint on the path to the player. A new
+/// path is only found when the player has moved to another tile or the map
+/// has changed, so the path finder runs a few times a second at most. The
+/// hierarchical path finder is used, which hands short paths on to JPS. A
+/// waypoint counts as reached once it is within a quarter of a tile.
+/// \param pos Player position.
+/// \param len [out] Length of the rest of the path, or 0 if there is no path.
+/// \return Unit direction, or zero if there is no path.
+
+const Vector2 CAnimalControlOfficer::NextWaypoint(const Vector2& pos, float& len) {
+    size_t i, j; //player's tile
+
+    if (m_pTileManager->GetTile(pos, i, j))
+    {
+        const size_t goal = i * m_pTileManager->GetWidth() + j; //index of player's tile
+        const UINT version = m_pTileManager->GetVersion(); //map version
+
+        if (goal != m_nPathGoal || version != m_nPathVersion)
+        {
+            m_nPathGoal = goal;
+            m_nPathVersion = version;
+            m_nWaypoint = 0;
+            m_pPathHierarchy->FindPath(Pos(), pos, m_vecPath); //empty if none
+        }
+    }
+
+    const float r = m_pTileManager->GetTileSize() / 4; //close enough to a waypoint
+
+    while (m_nWaypoint + 1 < m_vecPath.size() &&
+        Vector2::DistanceSquared(Pos(), m_vecPath[m_nWaypoint]) < r * r)
+        m_nWaypoint++;
+
+    len = 0;
+
+    if (m_nWaypoint >= m_vecPath.size())
+        return Vector2::Zero; //no path
+
+    Vector2 dir = m_vecPath[m_nWaypoint] - Pos(); //to next waypoint
+    len = dir.Length();
+
+    for (size_t k = m_nWaypoint + 1; k < m_vecPath.size(); k++) //rest of the path
+        len += Vector2::Distance(m_vecPath[k - 1], m_vecPath[k]);
+
+    dir.Normalize();
+    return dir;
+} //NextWaypoint
+
+void CAnimalControlOfficer::CollisionResponse(const Vector2& norm, float d, CObject* pObj) {
+    if (m_bDead)return; //already dead, bail out
 } //CollisionResponse
\ No newline at end of file
@@ -1,28 +1,36 @@
-/// \file AnimalControlOfficer.h
-/// \brief Interface for the Animal Control Officer class CAnimalControlOfficer.
-
-#ifndef __L4RC_GAME_AnimalControlOfficer_H__
-#define __L4RC_GAME_AnimalControlOfficer_H__
-
-#include "Object.h"
-#include "Common.h"
-
-/// \brief The AnimalControlOfficer object. 
-///
-/// CAnimalControlOfficer is the abstract representation of an Animal Control Officer object.
-
-class CAnimalControlOfficer : public CObject {
-    friend class CObjectManager; ///< Object manager is a friend.
-
-protected:
-    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
-
-public:
-    CAnimalControlOfficer(const Vector2&); ///< Constructor. 
-    ~CAnimalControlOfficer(); ///< Destructor. 
-
-    virtual void move(); ///< Move AnimalControlOfficer.
-    void Follow(const Vector2&);
-}; //CAnimalControlOfficer
-
-#endif //__L4RC_GAME_AnimalControlOfficer_H__
+/// \file AnimalControlOfficer.h
+/// \brief Interface for the Animal Control Officer class CAnimalControlOfficer.
+
+#ifndef __L4RC_GAME_AnimalControlOfficer_H__
+#define __L4RC_GAME_AnimalControlOfficer_H__
+
+#include "Object.h"
+#include "Common.h"
+
+#include <vector>
+
+/// \brief The AnimalControlOfficer object. 
+///
+/// CAnimalControlOfficer is the abstract representation of an Animal Control Officer object.
+
+class CAnimalControlOfficer : public CObject {
+    friend class CObjectManager; ///< Object manager is a friend.
+
+protected:
+    std::vector<Vector2> m_vecPath; ///< Waypoints to the player.
+    size_t m_nWaypoint = 0; ///< Index of next waypoint.
+    size_t m_nPathGoal = SIZE_MAX; ///< Tile that the path goes to.
+    UINT m_nPathVersion = 0; ///< Map version that the path was found on.
+
+    const Vector2 NextWaypoint(const Vector2&, float&); ///< Get direction to next waypoint.
+    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+
+public:
+    CAnimalControlOfficer(const Vector2&); ///< Constructor. 
+    ~CAnimalControlOfficer(); ///< Destructor. 
+
+    virtual void move(); ///< Move AnimalControlOfficer.
+    void Follow(const Vector2&); ///< Chase the player.
+}; //CAnimalControlOfficer
+
+#endif //__L4RC_GAME_AnimalControlOfficer_H__
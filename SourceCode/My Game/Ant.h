@@ -1,41 +1,46 @@
-/// \file Ant.h
-/// \brief Interface for the ant object class CAnt.
-
-#ifndef __L4RC_GAME_ANT_H__
-#define __L4RC_GAME_ANT_H__
-
-#include "Object.h"
-#include "Common.h"
-
-/// \brief The ant object. 
-///
-/// CAnt is the abstract representation of an ant object.
-
-class CAnt: public CObject{
-  friend class CObjectManager; ///< Object manager is a friend.
-
-  protected: 
-    const UINT m_nMaxHealth = 1; ///<Maximum health.
-    UINT m_nHealth = m_nMaxHealth; ///<Current health.
-
-    LEventTimer* m_pFrameEvent = nullptr; ///< Frame event timer.
-    
-    LEventTimer* m_pStrayEvent = nullptr; ///< Stray event timer.
-    bool m_bStrayParity = true; ///< Stray from path left or right.
-
-    bool m_bPreferPosRot = true; ///< Prefer positive rotation.
-
-    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
-    virtual void DeathFX(); ///< Death special effects.
-
-    void StrayFromPath(); ///< Stray randomly from path.
-    void UpdateFramenumber(); ///< Update frame number.
-
-  public:
-    CAnt(const Vector2&); ///< Constructor. 
-    ~CAnt(); ///< Destructor. 
-
-    virtual void move(); ///< Move ant.
-}; //CAnt
-
+/// \file Ant.h
+/// \brief Interface for the ant object class CAnt.
+
+#ifndef __L4RC_GAME_ANT_H__
+#define __L4RC_GAME_ANT_H__
+
+#include "Object.h"
+#include "Common.h"
+
+/// \brief The ant object. 
+///
+/// CAnt is the abstract representation of an ant object.
+
+class CAnt: public CObject{
+  friend class CObjectManager; ///< Object manager is a friend.
+
+  protected: 
+    const UINT m_nMaxHealth = 1; ///<Maximum health.
+    UINT m_nHealth = m_nMaxHealth; ///<Current health.
+
+    CSimTimer* m_pFrameEvent = nullptr; ///< Frame event timer.
+    
+    CSimTimer* m_pStrayEvent = nullptr; ///< Stray event timer.
+    bool m_bStrayParity = true; ///< Stray from path left or right.
+    bool m_bStrayPending = false; ///< A deferred stray is waiting to run.
+
+    bool m_bPreferPosRot = true; ///< Prefer positive rotation.
+
+    Vector2 m_vSteer = Vector2::Zero; ///< Crowd steering, set by the object manager.
+    const float m_fMaxTurn = 4.0f; ///< Fastest turn when steering, in radians per second.
+
+    virtual void CollisionResponse(const Vector2&, float, CObject* = nullptr); ///< Collision response.
+    virtual void DeathFX(); ///< Death special effects.
+
+    void StrayFromPath(float, float); ///< Stray randomly from path.
+    void Steer(); ///< Turn to keep clear of other ants.
+    void UpdateFramenumber(); ///< Update frame number.
+
+  public:
+    CAnt(const Vector2&); ///< Constructor. 
+    ~CAnt(); ///< Destructor. 
+
+    virtual void move(); ///< Move ant.
+}; //CAnt
+
 #endif //__L4RC_GAME_ANT_H__
\ No newline at end of file
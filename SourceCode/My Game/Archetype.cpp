@@ -0,0 +1,173 @@
+/// \file Archetype.cpp
+/// \brief Code for the archetype table CArchetypeTable.
+
+#include "Archetype.h"
+#include "SpriteRenderer.h"
+#include "Settings.h"
+
+SArchetype CArchetypeTable::m_sTable[(UINT)eSprite::Size];
+SImageSize CArchetypeTable::m_sImageSize[(UINT)eSprite::Size];
+
+/// Read the width and height of an image from the header of a PNG file,
+/// which is the only image format that the game uses. The width and height
+/// are the first two fields of the IHDR chunk, which must come first, as
+/// 32-bit big-endian integers.
+/// \param filename Name of PNG file.
+/// \param s [out] Image size.
+/// \return true if the file was opened and has a PNG header.
+
+bool CArchetypeTable::ReadPngSize(const std::string& filename, SImageSize& s){
+  FILE* input = nullptr; //input file handle
+  fopen_s(&input, filename.c_str(), "rb");
+  if(input == nullptr)return false; //bail out
+
+  unsigned char header[24]; //signature, chunk length, chunk type, width, height
+  const bool bRead = fread(header, sizeof(header), 1, input) == 1;
+  fclose(input);
+
+  if(!bRead || memcmp(header + 1, "PNG", 3) != 0 || memcmp(header + 12, "IHDR", 4) != 0)
+    return false; //not a PNG file
+
+  auto BigEndian = [&](UINT i){
+    return (UINT)header[i] << 24 | (UINT)header[i + 1] << 16 |
+      (UINT)header[i + 2] << 8 | (UINT)header[i + 3];
+  }; //BigEndian
+
+  s.m_fWidth = (float)BigEndian(16);
+  s.m_fHeight = (float)BigEndian(20);
+  return true;
+} //ReadPngSize
+
+/// Read the sprite sizes from the image files listed in the `sprites` tag of
+/// `gamesettings.xml`, for use in place of the renderer's when running
+/// headless. A sprite tag either names a single image file, or a file name
+/// and an extension for a sequence of numbered frame images, or a sprite
+/// sheet and the rectangles of its frames. Sprites that can't be found keep
+/// a size of zero.
+/// \param pSettings Pointer to the settings tag.
+/// \param vecSprites Sprite types and their names in `gamesettings.xml`.
+
+void CArchetypeTable::ReadImageSizes(tinyxml2::XMLElement* pSettings,
+  const std::vector<std::pair<eSprite, const char*>>& vecSprites)
+{
+  if(pSettings == nullptr)return; //no settings
+
+  tinyxml2::XMLElement* pSprites = pSettings->FirstChildElement("sprites");
+  if(pSprites == nullptr)return; //no sprites tag
+
+  const char* path = pSprites->Attribute("path");
+  const std::string strPath = path? std::string(path) + "\\": ""; //image folder
+
+  for(const auto& p: vecSprites){ //for each sprite type
+    tinyxml2::XMLElement* pTag = pSprites->FirstChildElement("sprite");
+
+    while(pTag && pTag->Attribute("name", p.second) == nullptr)
+      pTag = pTag->NextSiblingElement("sprite"); //find its tag
+
+    if(pTag == nullptr)continue; //not listed
+
+    SImageSize& s = m_sImageSize[(UINT)p.first]; //shorthand
+    s.m_nNumFrames = std::max(1u, pTag->UnsignedAttribute("frames", 1));
+
+    const char* file = pTag->Attribute("file");
+    const char* ext = pTag->Attribute("ext");
+    tinyxml2::XMLElement* pFrame = pTag->FirstChildElement("frame");
+
+    if(pFrame != nullptr){ //sprite sheet, so use the first frame
+      s.m_fWidth = pFrame->FloatAttribute("right") - pFrame->FloatAttribute("left");
+      s.m_fHeight = pFrame->FloatAttribute("bottom") - pFrame->FloatAttribute("top");
+    } //if
+
+    else if(file != nullptr && ext != nullptr) //numbered frame images
+      ReadPngSize(strPath + file + "0." + ext, s);
+
+    else if(file != nullptr) //single image
+      ReadPngSize(strPath + file, s);
+  } //for
+} //ReadImageSizes
+
+/// Fill in the archetype for one sprite type from the size of its image,
+/// which comes from the renderer if there is one and from the image files
+/// otherwise. This must only be called for sprites that have actually been
+/// loaded or read.
+/// \param t Sprite type.
+/// \param scale Sprite scale.
+/// \param bScaleRadius Whether the bounding circle shrinks with the sprite.
+/// \param bStatic Whether objects of this type are static.
+/// \param layer Draw layer.
+/// \param v Initial velocity (defaults to zero).
+
+void CArchetypeTable::Set(eSprite t, float scale, bool bScaleRadius,
+  bool bStatic, eLayer layer, const Vector2& v)
+{
+  SArchetype& a = m_sTable[(UINT)t]; //shorthand
+
+  SImageSize s = m_sImageSize[(UINT)t]; //read from image files
+
+  if(m_pRenderer != nullptr){ //ask the renderer
+    s.m_fWidth = m_pRenderer->GetWidth(t);
+    s.m_fHeight = m_pRenderer->GetHeight(t);
+    s.m_nNumFrames = m_pRenderer->GetNumFrames((UINT)t);
+  } //if
+
+  const float w = s.m_fWidth; //sprite width
+  const float h = s.m_fHeight; //sprite height
+
+  a.m_fWidth = w;
+  a.m_fRadius = std::max(w, h)/2; //bounding circle radius
+  if(bScaleRadius)a.m_fRadius *= scale; //scale the bounding circle radius
+  a.m_fScale = scale;
+  a.m_bStatic = bStatic;
+  a.m_eLayer = layer;
+  a.m_vVelocity = v;
+  a.m_nNumFrames = s.m_nNumFrames;
+} //Set
+
+/// Build the archetype table. This must be called once after the images
+/// have been loaded and before any objects are created. Note that ghosts and
+/// the boss turret are drawn at half size but have always collided at full
+/// size, so their bounding circles are deliberately left unscaled.
+
+void CArchetypeTable::Build(){
+  Set(eSprite::Tile, 1.0f, false, true, eLayer::Floor);
+
+  //creatures
+
+  Set(eSprite::Player,     1.0f, false, false, eLayer::Creature);
+  Set(eSprite::Turret,     1.0f, false, true,  eLayer::Creature);
+  Set(eSprite::MGTurret,   1.0f, false, true,  eLayer::Creature);
+  Set(eSprite::BossTurret, 0.5f, false, true,  eLayer::Creature);
+  Set(eSprite::Ant,        0.5f, true,  false, eLayer::Creature, Vector2(0.0f, 64.0f));
+  Set(eSprite::Ghost,      0.5f, false, false, eLayer::Creature, Vector2(0.0f, 20.0f));
+  Set(eSprite::AnimalControlOfficer, 0.5f, true, false, eLayer::Creature, Vector2(0.0f, 64.0f));
+
+  //bullets
+
+  Set(eSprite::Bullet,  1.0f, false, false, eLayer::Bullet);
+  Set(eSprite::Bullet2, 1.0f, false, false, eLayer::Bullet);
+
+  //powerups
+
+  Set(eSprite::Health,          1.0f, false, true, eLayer::Pickup);
+  Set(eSprite::HealthUp,        1.0f, false, true, eLayer::Pickup);
+  Set(eSprite::StaminaUp,       1.0f, false, true, eLayer::Pickup);
+  Set(eSprite::FocusUp,         1.0f, false, true, eLayer::Pickup);
+  Set(eSprite::MovementSpeedUp, 1.0f, false, true, eLayer::Pickup);
+  Set(eSprite::DamageUp,        1.0f, false, true, eLayer::Pickup);
+} //Build
+
+/// Reader function for an archetype.
+/// \param t Sprite type.
+/// \return The archetype for that sprite type.
+
+const SArchetype& CArchetypeTable::Get(eSprite t){
+  return m_sTable[(UINT)t];
+} //Get
+
+/// Reader function for an archetype.
+/// \param n Sprite index.
+/// \return The archetype for that sprite index.
+
+const SArchetype& CArchetypeTable::Get(UINT n){
+  return m_sTable[n];
+} //Get
@@ -0,0 +1,67 @@
+/// \file Archetype.h
+/// \brief Interface for the archetype table CArchetypeTable.
+
+#ifndef __L4RC_GAME_ARCHETYPE_H__
+#define __L4RC_GAME_ARCHETYPE_H__
+
+#include "GameDefines.h"
+#include "Common.h"
+
+#include <utility>
+
+namespace tinyxml2{class XMLElement;}
+
+/// \brief An object archetype.
+///
+/// The properties that every object of a given sprite type starts out with.
+/// These used to be computed in each object's constructor by asking the
+/// renderer for the sprite size and then rescaling by hand.
+
+struct SArchetype{
+  float m_fWidth = 0; ///< Unscaled sprite width.
+  float m_fRadius = 0; ///< Bounding circle radius.
+  float m_fScale = 1; ///< Sprite scale.
+  bool m_bStatic = true; ///< Is static (does not move).
+  eLayer m_eLayer = eLayer::Creature; ///< Draw layer.
+  Vector2 m_vVelocity; ///< Initial velocity.
+  size_t m_nNumFrames = 1; ///< Number of animation frames.
+}; //SArchetype
+
+/// \brief An image size.
+///
+/// The size of a sprite's image and its number of frames, as read from the
+/// image files when there is no renderer to ask.
+
+struct SImageSize{
+  float m_fWidth = 0; ///< Image width.
+  float m_fHeight = 0; ///< Image height.
+  size_t m_nNumFrames = 1; ///< Number of animation frames.
+}; //SImageSize
+
+/// \brief The archetype table.
+///
+/// A table of archetypes indexed by sprite type. It is built exactly once,
+/// after the images have been loaded, so that creating an object only has to
+/// copy its archetype instead of querying the renderer. When running without
+/// a renderer, the sprite sizes are read from the headers of the image files
+/// listed in `gamesettings.xml` instead.
+
+class CArchetypeTable: public CCommon{
+  private:
+    static SArchetype m_sTable[(UINT)eSprite::Size]; ///< Archetypes indexed by sprite.
+    static SImageSize m_sImageSize[(UINT)eSprite::Size]; ///< Image sizes if headless.
+
+    static bool ReadPngSize(const std::string&, SImageSize&); ///< Read size from PNG file.
+
+    static void Set(eSprite, float, bool, bool, eLayer,
+      const Vector2& = Vector2::Zero); ///< Set an archetype.
+
+  public:
+    static void ReadImageSizes(tinyxml2::XMLElement*,
+      const std::vector<std::pair<eSprite, const char*>>&); ///< Read image sizes from files.
+    static void Build(); ///< Build the table from the loaded images.
+    static const SArchetype& Get(eSprite); ///< Get archetype by sprite type.
+    static const SArchetype& Get(UINT); ///< Get archetype by sprite index.
+}; //CArchetypeTable
+
+#endif //__L4RC_GAME_ARCHETYPE_H__
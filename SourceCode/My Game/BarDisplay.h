@@ -1,26 +1,26 @@
-/// \file BarDisplay.h
-/// \brief Interface for the BarDisplay object class CBarDisplay.
-/*
-#ifndef __L4RC_GAME_BARDISPLAY_H__
-#define __L4RC_GAME_BARDISPLAY_H__
-
-#include "Object.h"
-#include "Common.h"
-
-class CBarDisplay// : public CCommon
-{
-protected:
-	//eSprite sprite;
-	//int i;
-	//Vector2 pos;
-
-public:
-	CBarDisplay(); ///< Constructor.
-	//void Release();
-	LSpriteDesc2D Draw(eSprite, const int, const int, const Vector2);
-private:
-
-}; //CBarDisplay
-
-#endif //__L4RC_GAME_BARDISPLAY_H__
+/// \file BarDisplay.h
+/// \brief Interface for the BarDisplay object class CBarDisplay.
+/*
+#ifndef __L4RC_GAME_BARDISPLAY_H__
+#define __L4RC_GAME_BARDISPLAY_H__
+
+#include "Object.h"
+#include "Common.h"
+
+class CBarDisplay// : public CCommon
+{
+protected:
+	//eSprite sprite;
+	//int i;
+	//Vector2 pos;
+
+public:
+	CBarDisplay(); ///< Constructor.
+	//void Release();
+	LSpriteDesc2D Draw(eSprite, const int, const int, const Vector2);
+private:
+
+}; //CBarDisplay
+
+#endif //__L4RC_GAME_BARDISPLAY_H__
 */
\ No newline at end of file
@@ -0,0 +1,72 @@
+/// \file BodyArray.cpp
+/// \brief Code for the object body array CBodyArray.
+
+#include "BodyArray.h"
+
+/// Add a body at the back of the arrays, at rest and with no radius.
+/// \param pos Position.
+/// \param roll Orientation.
+
+void CBodyArray::Add(const Vector2& pos, float roll){
+  m_vecPos.push_back(pos);
+  m_vecRadius.push_back(0);
+  m_vecVelocity.push_back(Vector2::Zero);
+  m_vecRoll.push_back(roll);
+  m_vecRotSpeed.push_back(0);
+  m_vecSpeed.push_back(0);
+} //Add
+
+/// Remove a body by moving the body at the back of the arrays into its
+/// place, as the object manager does with the objects.
+/// \param i Index of the body to remove.
+
+void CBodyArray::Remove(size_t i){
+  m_vecPos[i] = m_vecPos.back();
+  m_vecPos.pop_back();
+
+  m_vecRadius[i] = m_vecRadius.back();
+  m_vecRadius.pop_back();
+
+  m_vecVelocity[i] = m_vecVelocity.back();
+  m_vecVelocity.pop_back();
+
+  m_vecRoll[i] = m_vecRoll.back();
+  m_vecRoll.pop_back();
+
+  m_vecRotSpeed[i] = m_vecRotSpeed.back();
+  m_vecRotSpeed.pop_back();
+
+  m_vecSpeed[i] = m_vecSpeed.back();
+  m_vecSpeed.pop_back();
+} //Remove
+
+/// Reserve space for bodies so that the arrays aren't reallocated while
+/// they are being added.
+/// \param n Number of bodies.
+
+void CBodyArray::Reserve(size_t n){
+  m_vecPos.reserve(n);
+  m_vecRadius.reserve(n);
+  m_vecVelocity.reserve(n);
+  m_vecRoll.reserve(n);
+  m_vecRotSpeed.reserve(n);
+  m_vecSpeed.reserve(n);
+} //Reserve
+
+/// Remove all bodies. The arrays keep their memory.
+
+void CBodyArray::clear(){
+  m_vecPos.clear();
+  m_vecRadius.clear();
+  m_vecVelocity.clear();
+  m_vecRoll.clear();
+  m_vecRotSpeed.clear();
+  m_vecSpeed.clear();
+} //clear
+
+/// Get the number of bodies.
+/// \return Number of bodies.
+
+const size_t CBodyArray::GetSize() const{
+  return m_vecPos.size();
+} //GetSize
@@ -0,0 +1,44 @@
+/// \file BodyArray.h
+/// \brief Interface for the object body array CBodyArray.
+
+#ifndef __L4RC_GAME_BODYARRAY_H__
+#define __L4RC_GAME_BODYARRAY_H__
+
+#include "GameDefines.h"
+
+#include <vector>
+
+/// \brief The object bodies.
+///
+/// The parts of the objects that are read and written on every step: where
+/// they are, which way they face, how they move, and how big they are. They
+/// are kept in separate arrays, one value per object at the object's index
+/// in the object manager's object array, rather than in the objects
+/// themselves, so that the loops that move, steer, aim and collide the
+/// objects stream through only the values that they use. The quadratic
+/// overlap test, for instance, reads 12 bytes per object from the position
+/// and radius arrays instead of a `CObject` or a proxy copied out of one.
+/// Bodies are removed by swapping with the back, like the objects are.
+
+class CBodyArray{
+  friend class CObjectManager; ///< Iterates the arrays.
+  friend class CObject; ///< Reaches its own body.
+
+  private:
+    std::vector<Vector2> m_vecPos; ///< Positions.
+    std::vector<float> m_vecRadius; ///< Bounding circle radii.
+    std::vector<Vector2> m_vecVelocity; ///< Velocities.
+    std::vector<float> m_vecRoll; ///< Orientations.
+    std::vector<float> m_vecRotSpeed; ///< Rotational speeds.
+    std::vector<float> m_vecSpeed; ///< Speeds.
+
+  public:
+    void Add(const Vector2&, float); ///< Add a body at the back.
+    void Remove(size_t); ///< Swap-remove a body.
+    void Reserve(size_t); ///< Reserve space for bodies.
+    void clear(); ///< Remove all bodies.
+
+    const size_t GetSize() const; ///< Get number of bodies.
+}; //CBodyArray
+
+#endif //__L4RC_GAME_BODYARRAY_H__
@@ -0,0 +1,171 @@
+/// \file BulletPattern.cpp
+/// \brief Code for the boss bullet patterns CBulletPattern.
+
+#include "BulletPattern.h"
+#include "Settings.h"
+
+#include <algorithm>
+#include <cstring>
+
+std::vector<SBulletPattern> CBulletPattern::m_vecPatterns;
+std::vector<SBossPhase> CBulletPattern::m_vecPhases;
+
+/// Use the built-in patterns and phases, which are what the boss did before
+/// its patterns were data: an aimed stream of single bullets while its
+/// health is above 60, a stream of single bullets while spinning at 0.4
+/// turns per second while its health is above 30, and then a random choice
+/// between the two every five seconds.
+
+void CBulletPattern::SetDefaults(){
+  m_vecPatterns.assign(2, SBulletPattern());
+
+  SBulletPattern& aimed = m_vecPatterns[0]; //shorthand
+  aimed.m_strName = "aimed";
+  aimed.m_eAim = ePatternAim::Player;
+  aimed.m_fInterval = 0.2f;
+
+  SBulletPattern& spin = m_vecPatterns[1]; //shorthand
+  spin.m_strName = "spin";
+  spin.m_eAim = ePatternAim::Spin;
+  spin.m_fSpin = 0.4f*XM_2PI;
+  spin.m_fInterval = 0.1f;
+
+  m_vecPhases.assign(3, SBossPhase());
+  m_vecPhases[0].m_nHealth = 60;
+  m_vecPhases[0].m_vecPatterns = {0};
+  m_vecPhases[1].m_nHealth = 30;
+  m_vecPhases[1].m_vecPatterns = {1};
+  m_vecPhases[2].m_nHealth = 0;
+  m_vecPhases[2].m_vecPatterns = {0, 1};
+} //SetDefaults
+
+/// Set the default patterns and phases, then replace them with the ones in
+/// the `boss` tag of `gamesettings.xml`, if it has any usable phases. Each
+/// `pattern` tag has a name, an `aim` of `player` or `spin`, and any of the
+/// optional attributes `spin` in degrees per second, `interval` in seconds,
+/// `bullets`, `spread` and `turn` in degrees, `burst`, `rest` in seconds,
+/// `speed`, and `jitter`. Each `phase` tag has a `health` that it is used
+/// above, a `switch` interval in seconds, and a `use` tag naming each of its
+/// patterns. Uses of unknown patterns are ignored.
+/// \param pSettings Pointer to the settings tag.
+
+void CBulletPattern::Load(tinyxml2::XMLElement* pSettings){
+  SetDefaults();
+
+  if(pSettings == nullptr)return; //no settings, use defaults
+
+  tinyxml2::XMLElement* pBoss = pSettings->FirstChildElement("boss");
+  if(pBoss == nullptr)return; //no boss tag, use defaults
+
+  std::vector<SBulletPattern> vecPatterns; //patterns read so far
+  const float fDegrees = XM_PI/180.0f; //radians per degree
+
+  for(tinyxml2::XMLElement* pTag = pBoss->FirstChildElement("pattern");
+    pTag; pTag = pTag->NextSiblingElement("pattern"))
+  {
+    const char* name = pTag->Attribute("name");
+    if(name == nullptr)continue; //can't be used without a name
+
+    SBulletPattern p;
+    p.m_strName = name;
+    p.m_eAim = pTag->Attribute("aim", "spin")? ePatternAim::Spin: ePatternAim::Player;
+    p.m_fSpin = fDegrees*pTag->FloatAttribute("spin", 0.0f);
+    p.m_fInterval = std::max(0.001f, pTag->FloatAttribute("interval", p.m_fInterval));
+    p.m_nBullets = std::max(1u, pTag->UnsignedAttribute("bullets", p.m_nBullets));
+    p.m_fSpread = fDegrees*pTag->FloatAttribute("spread", 0.0f);
+    p.m_fTurn = fDegrees*pTag->FloatAttribute("turn", 0.0f);
+    p.m_nBurst = pTag->UnsignedAttribute("burst", p.m_nBurst);
+    p.m_fRest = std::max(0.0f, pTag->FloatAttribute("rest", p.m_fRest));
+    p.m_fSpeed = pTag->FloatAttribute("speed", p.m_fSpeed);
+    p.m_fJitter = pTag->FloatAttribute("jitter", p.m_fJitter);
+
+    vecPatterns.push_back(p);
+  } //for
+
+  std::vector<SBossPhase> vecPhases; //phases read so far
+
+  for(tinyxml2::XMLElement* pTag = pBoss->FirstChildElement("phase");
+    pTag; pTag = pTag->NextSiblingElement("phase"))
+  {
+    SBossPhase phase;
+    phase.m_nHealth = pTag->UnsignedAttribute("health", 0);
+    phase.m_fSwitch = std::max(0.001f, pTag->FloatAttribute("switch", phase.m_fSwitch));
+
+    for(tinyxml2::XMLElement* pUse = pTag->FirstChildElement("use");
+      pUse; pUse = pUse->NextSiblingElement("use"))
+    {
+      const char* name = pUse->Attribute("pattern");
+      if(name == nullptr)continue; //no pattern
+
+      auto it = std::find_if(vecPatterns.begin(), vecPatterns.end(),
+        [&](const SBulletPattern& p){return p.m_strName == name;});
+      if(it == vecPatterns.end())continue; //unknown pattern
+
+      phase.m_vecPatterns.push_back((UINT)(it - vecPatterns.begin()));
+    } //for
+
+    if(!phase.m_vecPatterns.empty())
+      vecPhases.push_back(phase);
+  } //for
+
+  if(vecPhases.empty())return; //nothing usable, keep the defaults
+
+  std::stable_sort(vecPhases.begin(), vecPhases.end(),
+    [](const SBossPhase& a, const SBossPhase& b){return a.m_nHealth > b.m_nHealth;});
+
+  m_vecPatterns = vecPatterns;
+  m_vecPhases = vecPhases;
+} //Load
+
+/// Get the phase for the boss's health, which is the first phase whose
+/// threshold the health is above, or the last phase if there is none.
+/// \param health Boss's health.
+/// \return Phase index.
+
+const UINT CBulletPattern::GetPhase(UINT health){
+  for(UINT i=0; i<(UINT)m_vecPhases.size(); i++)
+    if(health > m_vecPhases[i].m_nHealth)
+      return i;
+
+  return (UINT)m_vecPhases.size() - 1;
+} //GetPhase
+
+/// Get a phase.
+/// \param i Phase index.
+/// \return The phase.
+
+const SBossPhase& CBulletPattern::GetBossPhase(UINT i){
+  return m_vecPhases[i];
+} //GetBossPhase
+
+/// Get a pattern.
+/// \param i Pattern index.
+/// \return The pattern.
+
+const SBulletPattern& CBulletPattern::GetPattern(UINT i){
+  return m_vecPatterns[i];
+} //GetPattern
+
+/// Get the directions of the bullets in one volley of a pattern. A single
+/// bullet goes straight down the center. A full circle is split into equal
+/// parts with the first bullet on the center, and a smaller arc is split
+/// with a bullet at each end.
+/// \param p Pattern.
+/// \param center Direction of the center of the volley.
+/// \param angles [out] Bullet directions. Its memory is reused.
+
+void CBulletPattern::GetVolley(const SBulletPattern& p, float center, std::vector<float>& angles){
+  angles.clear();
+
+  if(p.m_nBullets == 1){
+    angles.push_back(center);
+    return;
+  } //if
+
+  const bool bRing = p.m_fSpread >= XM_2PI - 0.001f; //full circle
+  const float step = bRing? XM_2PI/p.m_nBullets: p.m_fSpread/(p.m_nBullets - 1); //between bullets
+  const float start = bRing? center: center - 0.5f*p.m_fSpread; //first bullet
+
+  for(UINT i=0; i<p.m_nBullets; i++)
+    angles.push_back(start + i*step);
+} //GetVolley
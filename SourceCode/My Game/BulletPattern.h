@@ -0,0 +1,83 @@
+/// \file BulletPattern.h
+/// \brief Interface for the boss bullet patterns CBulletPattern.
+
+#ifndef __L4RC_GAME_BULLETPATTERN_H__
+#define __L4RC_GAME_BULLETPATTERN_H__
+
+#include "GameDefines.h"
+
+#include <string>
+#include <vector>
+
+namespace tinyxml2{class XMLElement;}
+
+/// \brief Bullet pattern aim enumerated type.
+///
+/// How the boss turns while firing a pattern. `Player` swivels towards the
+/// player and only fires while the player can be seen. `Spin` turns at a
+/// constant speed and fires all the time.
+
+enum class ePatternAim{
+  Player, Spin
+}; //ePatternAim
+
+/// \brief A bullet pattern.
+///
+/// Volleys of bullets fired at a fixed interval. Each volley is a fan of
+/// bullets spread evenly across an arc centered on the direction that the
+/// boss is facing, or a ring if the arc is a full circle. The center of each
+/// volley can be turned a little further than the last to make a spiral, and
+/// volleys can come in bursts with a rest after each one.
+
+struct SBulletPattern{
+  std::string m_strName; ///< Name, for phases to refer to.
+  ePatternAim m_eAim = ePatternAim::Player; ///< How the boss turns.
+  float m_fSpin = 0; ///< Rotation speed when spinning, in radians per second.
+  float m_fInterval = 0.2f; ///< Seconds between volleys.
+  UINT m_nBullets = 1; ///< Bullets per volley.
+  float m_fSpread = 0; ///< Arc that a volley covers, in radians.
+  float m_fTurn = 0; ///< Angle added to the center of each volley, in radians.
+  UINT m_nBurst = 0; ///< Volleys per burst, or 0 for no bursts.
+  float m_fRest = 0; ///< Extra seconds after each burst.
+  float m_fSpeed = 500.0f; ///< Bullet speed.
+  float m_fJitter = 0.1f; ///< Largest random deflection.
+}; //SBulletPattern
+
+/// \brief A boss phase.
+///
+/// The patterns that the boss fires while its health is above a threshold.
+/// If there is more than one, it picks one at random on entering the phase
+/// and again at a fixed interval.
+
+struct SBossPhase{
+  UINT m_nHealth = 0; ///< Used while the boss's health is above this.
+  std::vector<UINT> m_vecPatterns; ///< Indices of patterns to pick from.
+  float m_fSwitch = 5.0f; ///< Seconds between picks.
+}; //SBossPhase
+
+/// \brief The boss bullet patterns.
+///
+/// The boss's bullet patterns and the phases that use them, read from the
+/// `boss` tag in `gamesettings.xml` once at startup, so that new patterns
+/// and harder phases don't need a rebuild. If the tag is missing, or has no
+/// usable phases, the built-in defaults are used, which are an aimed stream
+/// of single bullets, then a spinning stream, then a random choice between
+/// the two every five seconds.
+
+class CBulletPattern{
+  private:
+    static std::vector<SBulletPattern> m_vecPatterns; ///< Patterns.
+    static std::vector<SBossPhase> m_vecPhases; ///< Phases in decreasing order of health.
+
+    static void SetDefaults(); ///< Use the built-in patterns.
+
+  public:
+    static void Load(tinyxml2::XMLElement*); ///< Load patterns from settings.
+
+    static const UINT GetPhase(UINT); ///< Get the phase for a health.
+    static const SBossPhase& GetBossPhase(UINT); ///< Get a phase.
+    static const SBulletPattern& GetPattern(UINT); ///< Get a pattern.
+    static void GetVolley(const SBulletPattern&, float, std::vector<float>&); ///< Get a volley's bullet angles.
+}; //CBulletPattern
+
+#endif //__L4RC_GAME_BULLETPATTERN_H__
@@ -1,21 +1,35 @@
-/// \file Common.cpp
-/// \brief Code for the class CCommon.
-///
-/// This file contains declarations and initial values
-/// for CCommon's static member variables.
-
-#include "Common.h"
-
-//ExtRenderer* CCommon::m_pRenderer = nullptr;
-LSpriteRenderer* CCommon::m_pRenderer = nullptr;
-CObjectManager* CCommon::m_pObjectManager = nullptr;
-LParticleEngine2D* CCommon::m_pParticleEngine = nullptr;
-CTileManager* CCommon::m_pTileManager = nullptr; 
-CBarDisplay* CCommon::m_pBarDisplay = nullptr;
-
-bool CCommon::m_bDrawAABBs = false;
-bool CCommon::m_bGodMode = false;
-bool CCommon::m_bAnimalControlOfficerSpawned = false;
-
-Vector2 CCommon::m_vWorldSize = Vector2::Zero;
-CPlayer* CCommon::m_pPlayer = nullptr;
+/// \file Common.cpp
+/// \brief Code for the class CCommon.
+///
+/// This file contains declarations and initial values
+/// for CCommon's static member variables.
+
+#include "Common.h"
+
+//ExtRenderer* CCommon::m_pRenderer = nullptr;
+LSpriteRenderer* CCommon::m_pRenderer = nullptr;
+CObjectManager* CCommon::m_pObjectManager = nullptr;
+CParticleSystem* CCommon::m_pParticleSystem = nullptr;
+CTileManager* CCommon::m_pTileManager = nullptr; 
+CBarDisplay* CCommon::m_pBarDisplay = nullptr;
+CJobSystem* CCommon::m_pJobSystem = nullptr;
+CRenderThread* CCommon::m_pRenderThread = nullptr;
+CFrameBudget* CCommon::m_pFrameBudget = nullptr;
+CRateScheduler* CCommon::m_pScheduler = nullptr;
+CRngService* CCommon::m_pRng = nullptr;
+CFlowField* CCommon::m_pFlowField = nullptr;
+CPathFinder* CCommon::m_pPathFinder = nullptr;
+CPathHierarchy* CCommon::m_pPathHierarchy = nullptr;
+
+bool CCommon::m_bDrawAABBs = false;
+bool CCommon::m_bGodMode = false;
+bool CCommon::m_bAnimalControlOfficerSpawned = false;
+
+float CCommon::m_fSimStep = 1.0f/120.0f;
+float CCommon::m_fSimTime = 0;
+UINT CCommon::m_nSimSteps = 0;
+float CCommon::m_fSimAlpha = 0;
+
+Vector2 CCommon::m_vWorldSize = Vector2::Zero;
+Vector3 CCommon::m_vCameraPos = Vector3::Zero;
+CPlayer* CCommon::m_pPlayer = nullptr;
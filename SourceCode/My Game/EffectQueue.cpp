@@ -0,0 +1,49 @@
+/// \file EffectQueue.cpp
+/// \brief Code for the effect queue CEffectQueue.
+
+#include "EffectQueue.h"
+
+thread_local CEffectQueue* CEffectQueue::m_pCurrent = nullptr;
+
+/// Queue an effect if this thread is capturing effects. If it isn't, then
+/// the caller is on the main thread and should go ahead and do it now.
+/// \param f Function call that does the effect.
+/// \return true If the effect was queued.
+
+bool CEffectQueue::Defer(const std::function<void()>& f){
+  if(m_pCurrent == nullptr)return false; //not capturing
+
+  m_pCurrent->m_vecEffects.push_back(f);
+  return true;
+} //Defer
+
+/// Queue an effect if this thread is capturing effects, and otherwise do it
+/// now.
+/// \param f Function call that does the effect.
+
+void CEffectQueue::Post(const std::function<void()>& f){
+  if(!Defer(f))f();
+} //Post
+
+/// Make this the queue that effects on the calling thread are captured in.
+
+void CEffectQueue::Begin(){
+  m_pCurrent = this;
+} //Begin
+
+/// Stop capturing effects on the calling thread.
+
+void CEffectQueue::End(){
+  m_pCurrent = nullptr;
+} //End
+
+/// Run the queued effects in the order in which they were queued, then clear
+/// the queue. This must be called on the main thread. Effects that are run
+/// here are not captured again, because the main thread isn't capturing.
+
+void CEffectQueue::Flush(){
+  for(auto& f: m_vecEffects)
+    f();
+
+  m_vecEffects.clear(); //keeps its capacity from frame to frame
+} //Flush
@@ -0,0 +1,36 @@
+/// \file EffectQueue.h
+/// \brief Interface for the effect queue CEffectQueue.
+
+#ifndef __L4RC_GAME_EFFECTQUEUE_H__
+#define __L4RC_GAME_EFFECTQUEUE_H__
+
+#include <vector>
+#include <functional>
+
+/// \brief The effect queue.
+///
+/// While objects are being moved or are responding to collisions on worker
+/// threads, anything that touches shared state, such as firing a gun,
+/// playing a sound, or drawing from a shared random number generator, is
+/// captured as a function call in the effect queue of the current thread
+/// instead of being done immediately. Each job works on a contiguous range of
+/// objects or contacts, and the queues are flushed on the main thread in
+/// range order afterwards, so the effects happen in the same order however
+/// the work was split up.
+
+class CEffectQueue{
+  private:
+    static thread_local CEffectQueue* m_pCurrent; ///< This thread's queue.
+
+    std::vector<std::function<void()>> m_vecEffects; ///< Queued effects.
+
+  public:
+    static bool Defer(const std::function<void()>&); ///< Queue an effect.
+    static void Post(const std::function<void()>&); ///< Queue an effect or do it now.
+
+    void Begin(); ///< Start capturing effects on this thread.
+    void End(); ///< Stop capturing effects on this thread.
+    void Flush(); ///< Run and clear the queued effects.
+}; //CEffectQueue
+
+#endif //__L4RC_GAME_EFFECTQUEUE_H__
@@ -0,0 +1,126 @@
+/// \file FlowField.cpp
+/// \brief Code for the flow field CFlowField.
+
+#include "FlowField.h"
+#include "TileManager.h"
+
+/// Rebuild the field if the target has moved to another tile or the map has
+/// changed since it was last built. A target off the map leaves the field
+/// as it is.
+/// \param target Target position.
+
+void CFlowField::Update(const Vector2& target){
+  size_t i, j; //target tile
+  if(!m_pTileManager->GetTile(target, i, j))return; //off the map
+
+  const size_t n = i*m_pTileManager->GetWidth() + j; //index of target tile
+
+  if(n != m_nTarget || m_nVersion != m_pTileManager->GetVersion())
+    Build(n);
+} //Update
+
+/// Build the field toward a tile. First a breadth-first search out from the
+/// target tile gives the number of steps to it from every tile that can
+/// reach it, moving up, down, left, or right. Then each tile's direction is
+/// the unit vector to whichever of its eight neighbors is closest to the
+/// target, with diagonal neighbors only allowed if neither tile beside the
+/// diagonal is a wall, so that chasers don't try to squeeze past corners.
+/// Walls, tiles that can't reach the target, and the target tile itself
+/// have no direction.
+/// \param n Index of target tile.
+
+void CFlowField::Build(size_t n){
+  const CTileManager* p = m_pTileManager; //shorthand
+  m_nWidth = p->GetWidth();
+  m_nHeight = p->GetHeight();
+  m_nTarget = n;
+  m_nVersion = p->GetVersion();
+  m_nBuilds++;
+
+  const size_t size = m_nWidth*m_nHeight; //number of tiles
+  m_vecDist.assign(size, UINT_MAX);
+  m_vecDir.assign(size, Vector2::Zero);
+  m_vecQueue.clear();
+
+  m_vecDist[n] = 0;
+  m_vecQueue.push_back((UINT)n);
+
+  const int di[4] = {-1, 1, 0, 0}; //row offsets of orthogonal neighbors
+  const int dj[4] = {0, 0, -1, 1}; //column offsets of orthogonal neighbors
+
+  for(size_t k=0; k<m_vecQueue.size(); k++){ //breadth-first search
+    const size_t i = m_vecQueue[k]/m_nWidth; //row
+    const size_t j = m_vecQueue[k]%m_nWidth; //column
+    const UINT d = m_vecDist[m_vecQueue[k]] + 1; //steps to neighbors
+
+    for(int e=0; e<4; e++){
+      const size_t i1 = i + di[e], j1 = j + dj[e]; //neighbor, wraps if off the map
+      if(p->IsWall(i1, j1))continue; //includes off the map
+
+      const size_t m = i1*m_nWidth + j1; //neighbor index
+
+      if(d < m_vecDist[m]){ //not seen yet
+        m_vecDist[m] = d;
+        m_vecQueue.push_back((UINT)m);
+      } //if
+    } //for
+  } //for
+
+  for(UINT m: m_vecQueue){ //directions for the reachable tiles
+    const size_t i = m/m_nWidth; //row
+    const size_t j = m%m_nWidth; //column
+
+    UINT best = m_vecDist[m]; //closest distance to target so far
+    Vector2 dir = Vector2::Zero; //direction to closest neighbor
+
+    for(int a=-1; a<=1; a++) //row offset
+      for(int b=-1; b<=1; b++){ //column offset
+        const size_t i1 = i + a, j1 = j + b; //neighbor
+        if((a == 0 && b == 0) || p->IsWall(i1, j1))continue;
+        if(a != 0 && b != 0 && (p->IsWall(i1, j) || p->IsWall(i, j1)))continue; //corner
+
+        const UINT d = m_vecDist[i1*m_nWidth + j1]; //neighbor's distance
+
+        if(d < best || (d == best && d < m_vecDist[m] && (a == 0 || b == 0))){ //prefer straight
+          best = d;
+          dir = Vector2((float)b, (float)-a); //rows count down
+        } //if
+      } //for
+
+    dir.Normalize();
+    m_vecDir[m] = dir;
+  } //for
+} //Build
+
+/// Get the direction to move in to reach the target from a point.
+/// \param pos Point.
+/// \return Unit direction, or zero if the point is on the target tile, on a
+/// wall, off the map, or can't reach the target.
+
+const Vector2 CFlowField::GetDirection(const Vector2& pos) const{
+  size_t i, j; //tile under pos
+  if(m_vecDir.empty() || !m_pTileManager->GetTile(pos, i, j))return Vector2::Zero;
+  if(i >= m_nHeight || j >= m_nWidth)return Vector2::Zero; //built for another map
+
+  return m_vecDir[i*m_nWidth + j];
+} //GetDirection
+
+/// Get the number of steps to the target from a point.
+/// \param pos Point.
+/// \return Steps, moving up, down, left, or right, or `UINT_MAX` if the target
+/// can't be reached.
+
+const UINT CFlowField::GetDistance(const Vector2& pos) const{
+  size_t i, j; //tile under pos
+  if(m_vecDist.empty() || !m_pTileManager->GetTile(pos, i, j))return UINT_MAX;
+  if(i >= m_nHeight || j >= m_nWidth)return UINT_MAX; //built for another map
+
+  return m_vecDist[i*m_nWidth + j];
+} //GetDistance
+
+/// Reader function for the number of times the field has been built.
+/// \return Number of builds.
+
+const UINT CFlowField::GetBuilds() const{
+  return m_nBuilds;
+} //GetBuilds
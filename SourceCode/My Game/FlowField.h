@@ -0,0 +1,47 @@
+/// \file FlowField.h
+/// \brief Interface for the flow field CFlowField.
+
+#ifndef __L4RC_GAME_FLOWFIELD_H__
+#define __L4RC_GAME_FLOWFIELD_H__
+
+#include "Common.h"
+
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+/// \brief A flow field.
+///
+/// For every tile of the map, the number of steps to a target tile and the
+/// direction to move in to get there around the walls. It is built by a
+/// breadth-first search out from the target over the non-wall tiles, and
+/// each tile's direction points at the neighbor, including the diagonal ones
+/// that don't cut a wall corner, that is closest to the target. The field
+/// toward the player is shared by every chaser, so it is only rebuilt when
+/// the player moves to another tile or the map changes, and following it
+/// costs a chaser one table lookup per step however many chasers there are.
+/// It must only be updated on the main thread, but can be read from any
+/// thread in between.
+
+class CFlowField: public CCommon{
+  private:
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    size_t m_nTarget = SIZE_MAX; ///< Index of target tile.
+    UINT m_nVersion = 0; ///< Map version that the field was built from.
+    UINT m_nBuilds = 0; ///< Number of times built.
+
+    std::vector<UINT> m_vecDist; ///< Steps to the target from each tile.
+    std::vector<Vector2> m_vecDir; ///< Direction to move in from each tile.
+    std::vector<UINT> m_vecQueue; ///< Search queue, kept for its capacity.
+
+    void Build(size_t); ///< Build the field toward a tile.
+
+  public:
+    void Update(const Vector2&); ///< Rebuild if the target tile or map changed.
+    const Vector2 GetDirection(const Vector2&) const; ///< Get direction to move in.
+    const UINT GetDistance(const Vector2&) const; ///< Get steps to the target.
+    const UINT GetBuilds() const; ///< Get number of times built.
+}; //CFlowField
+
+#endif //__L4RC_GAME_FLOWFIELD_H__
@@ -0,0 +1,131 @@
+/// \file FrameBudget.cpp
+/// \brief Code for the frame budget manager CFrameBudget.
+
+#include "FrameBudget.h"
+
+#include <algorithm>
+
+/// Post a task to be run when there is time for it.
+/// \param p Priority.
+/// \param f Function call that does the task.
+/// \param pOwner Object that the task belongs to, or nullptr if none.
+
+void CFrameBudget::Post(eTaskPriority p, const std::function<void()>& f,
+  const void* pOwner)
+{
+  SDeferredTask t;
+  t.m_fnTask = f;
+  t.m_pOwner = pOwner;
+  t.m_nFrame = m_nFrame;
+
+  m_dqTasks[(UINT)p].push_back(t);
+} //Post
+
+/// Throw away the waiting tasks that belong to an owner. This is called when
+/// the owner is deleted, so that its tasks don't touch it afterwards.
+/// \param pOwner Owner.
+
+void CFrameBudget::Cancel(const void* pOwner){
+  if(pOwner == nullptr)return; //tasks with no owner are never cancelled
+
+  for(std::deque<SDeferredTask>& dq: m_dqTasks)
+    dq.erase(std::remove_if(dq.begin(), dq.end(),
+      [=](const SDeferredTask& t){return t.m_pOwner == pOwner;}), dq.end());
+} //Cancel
+
+/// Throw away all waiting tasks, for example when a new level starts.
+
+void CFrameBudget::Clear(){
+  for(std::deque<SDeferredTask>& dq: m_dqTasks)
+    dq.clear();
+} //Clear
+
+/// Run waiting tasks, highest priority first and oldest first within a
+/// priority, until the time since the start of the frame goes over budget.
+/// After that only tasks that have waited `m_nMaxDelay` frames are run.
+/// Tasks posted by the tasks run here wait for the next frame. Must be called
+/// once per frame on the main thread.
+/// \param tStart When the frame started.
+
+void CFrameBudget::Run(std::chrono::steady_clock::time_point tStart){
+  using namespace std::chrono;
+
+  auto Elapsed = [&](){ //time since start of frame in ms
+    return duration<float, std::milli>(steady_clock::now() - tStart).count();
+  }; //Elapsed
+
+  const auto t0 = steady_clock::now();
+  SBudgetStats& s = m_sStats; //shorthand
+
+  s.m_nRun = s.m_nForced = s.m_nDeferred = 0;
+
+  for(std::deque<SDeferredTask>& dq: m_dqTasks){ //for each priority, highest first
+    size_t n = dq.size(); //tasks waiting at the start
+
+    while(n > 0){
+      const bool bOverdue = m_nFrame - dq.front().m_nFrame >= m_nMaxDelay;
+      const bool bOver = m_bEnabled && Elapsed() > m_fBudget; //over budget
+
+      if(bOver && !bOverdue)break; //the rest can wait
+
+      const std::function<void()> f = dq.front().m_fnTask; //may post more tasks
+      dq.pop_front();
+      n--;
+      f();
+      n = std::min(n, dq.size()); //in case the task cancelled some
+
+      s.m_nRun++;
+      if(bOver)s.m_nForced++;
+    } //while
+
+    s.m_nDeferred += (UINT)n;
+  } //for
+
+  s.m_fTaskTime = duration<float, std::milli>(steady_clock::now() - t0).count();
+  s.m_bOverrun = Elapsed() > m_fBudget;
+
+  s.m_nFrames++;
+  s.m_nTotalRun += s.m_nRun;
+  s.m_nTotalDeferred += s.m_nDeferred;
+  if(s.m_bOverrun)s.m_nOverruns++;
+
+  m_nFrame++;
+} //Run
+
+/// Set the time budget and the maximum delay.
+/// \param t Time budget per frame in ms.
+/// \param n Most frames that a task may wait.
+
+void CFrameBudget::SetBudget(float t, UINT n){
+  m_fBudget = std::max(t, 0.0f);
+  m_nMaxDelay = std::max(n, 1u);
+} //SetBudget
+
+/// Turn deferral on or off. When it is off, every task is run on the frame in
+/// which it was posted.
+/// \param b true to defer tasks when over budget.
+
+void CFrameBudget::SetEnabled(bool b){
+  m_bEnabled = b;
+} //SetEnabled
+
+/// Reader function for the enabled flag.
+/// \return true if tasks are deferred when over budget.
+
+const bool CFrameBudget::IsEnabled() const{
+  return m_bEnabled;
+} //IsEnabled
+
+/// Reader function for the time budget.
+/// \return Time budget per frame in ms.
+
+const float CFrameBudget::GetBudget() const{
+  return m_fBudget;
+} //GetBudget
+
+/// Reader function for the statistics.
+/// \return Statistics.
+
+const SBudgetStats& CFrameBudget::GetStats() const{
+  return m_sStats;
+} //GetStats
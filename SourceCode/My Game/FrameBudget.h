@@ -0,0 +1,83 @@
+/// \file FrameBudget.h
+/// \brief Interface for the frame budget manager CFrameBudget.
+
+#ifndef __L4RC_GAME_FRAMEBUDGET_H__
+#define __L4RC_GAME_FRAMEBUDGET_H__
+
+#include <chrono>
+#include <deque>
+#include <functional>
+
+#include "Defines.h"
+
+/// \brief Deferrable task priority.
+///
+/// Higher priority tasks are run first. `Size` is the number of priorities.
+
+enum class eTaskPriority{
+  High, Normal, Low, Size
+}; //eTaskPriority
+
+/// \brief A deferrable task.
+
+struct SDeferredTask{
+  std::function<void()> m_fnTask; ///< Function call that does the task.
+  const void* m_pOwner = nullptr; ///< Object that the task belongs to, if any.
+  UINT m_nFrame = 0; ///< Frame on which the task was posted.
+}; //SDeferredTask
+
+/// \brief Frame budget statistics.
+
+struct SBudgetStats{
+  UINT m_nRun = 0; ///< Tasks run last frame.
+  UINT m_nForced = 0; ///< Tasks run last frame over budget because they were overdue.
+  UINT m_nDeferred = 0; ///< Tasks left waiting at the end of last frame.
+  float m_fTaskTime = 0; ///< Time spent on tasks last frame in ms.
+  bool m_bOverrun = false; ///< Last frame went over budget.
+
+  UINT m_nFrames = 0; ///< Frames so far.
+  UINT m_nTotalRun = 0; ///< Tasks run so far.
+  UINT m_nTotalDeferred = 0; ///< Times a task was left waiting at the end of a frame.
+  UINT m_nOverruns = 0; ///< Frames that went over budget.
+}; //SBudgetStats
+
+/// \brief The frame budget manager.
+///
+/// Work that can slip a frame without harm, such as power-up drops, the
+/// straying of far away ants, particle spawns, and debug HUD text, is posted
+/// here with a priority instead of being done right away. Once the
+/// simulation for a frame is done, `Run()` does the waiting tasks in priority
+/// order, oldest first, for as long as the time since the start of the frame
+/// is under budget. Whatever is left waits for the next frame, except that a
+/// task that has waited `m_nMaxDelay` frames is run anyway so that nothing
+/// waits forever. A task posted with an owner is thrown away if its owner is
+/// deleted before it runs. When disabled, every task is run on the frame it
+/// was posted, which is what replays and the headless runner need, since a
+/// wall-clock budget would make the outcome depend on how fast the machine is.
+/// The task queues must only be touched on the main thread.
+
+class CFrameBudget{
+  private:
+    std::deque<SDeferredTask> m_dqTasks[(UINT)eTaskPriority::Size]; ///< Waiting tasks, one queue per priority.
+
+    bool m_bEnabled = true; ///< Defer tasks when over budget.
+    float m_fBudget = 8.0f; ///< Time budget per frame in ms.
+    UINT m_nMaxDelay = 8; ///< Most frames that a task may wait.
+    UINT m_nFrame = 0; ///< Current frame number.
+
+    SBudgetStats m_sStats; ///< Statistics.
+
+  public:
+    void Post(eTaskPriority, const std::function<void()>&, const void* = nullptr); ///< Post a task.
+    void Cancel(const void*); ///< Throw away an owner's tasks.
+    void Clear(); ///< Throw away all tasks.
+    void Run(std::chrono::steady_clock::time_point); ///< Run tasks within budget.
+
+    void SetBudget(float, UINT); ///< Set time budget and maximum delay.
+    void SetEnabled(bool); ///< Turn deferral on or off.
+    const bool IsEnabled() const; ///< Reader function for enabled flag.
+    const float GetBudget() const; ///< Reader function for time budget.
+    const SBudgetStats& GetStats() const; ///< Reader function for statistics.
+}; //CFrameBudget
+
+#endif //__L4RC_GAME_FRAMEBUDGET_H__
@@ -1,1010 +1,1725 @@
-/// \file Game.cpp
-/// \brief Code for the game class CGame.
-
-#include "Game.h"
-
-#include "GameDefines.h"
-//#include "ExtRenderer.h"
-#include "SpriteRenderer.h"
-#include "ComponentIncludes.h"
-#include "ParticleEngine.h"
-#include "TileManager.h"
-
-#include "shellapi.h"
-
-#include "Player.h"     //to get access to player's health for display of 'healthbar'
-#include "BarDisplay.h"
-
-/// Delete the renderer, the object manager, and the tile manager. The renderer
-/// needs to be deleted before this destructor runs so it will be done elsewhere.
-
-CGame::~CGame()
-{
-    delete m_pParticleEngine;
-    delete m_pObjectManager;
-    delete m_pTileManager;
-    delete m_pBarDisplay;
-} //destructor
-
-/// Initialize the renderer, the tile manager and the object manager, load 
-/// images and sounds, and begin the game.
-
-void CGame::Initialize()
-{
-    //m_pRenderer = new ExtRenderer(eSpriteMode::Batched2D);
-    m_pRenderer = new LSpriteRenderer(eSpriteMode::Batched2D);
-    m_pRenderer->Initialize(eSprite::Size);
-    LoadImages(); //load images from xml file list
-
-    m_pTileManager = new CTileManager((size_t)m_pRenderer->GetWidth(eSprite::Tile));
-    m_pObjectManager = new CObjectManager; //set up the object manager 
-    LoadSounds(); //load the sounds for this game
-
-    m_pParticleEngine = new LParticleEngine2D(m_pRenderer);
-
-    BeginGame();
-} //Initialize
-
-/// Load the specific images needed for this game. This is where `eSprite`
-/// values from `GameDefines.h` get tied to the names of sprite tags in
-/// `gamesettings.xml`. Those sprite tags contain the name of the corresponding
-/// image file. If the image tag or the image file are missing, then the game
-/// should abort from deeper in the Engine code leaving you with an error
-/// message in a dialog box.
-
-void CGame::LoadImages()
-{
-    m_pRenderer->BeginResourceUpload();
-
-    m_pRenderer->Load(eSprite::Tile, "tile");
-    m_pRenderer->Load(eSprite::Player, "player");
-    m_pRenderer->Load(eSprite::Bullet, "bullet");
-    m_pRenderer->Load(eSprite::Bullet2, "bullet2");
-    m_pRenderer->Load(eSprite::Smoke, "smoke");
-    m_pRenderer->Load(eSprite::Spark, "spark");
-    m_pRenderer->Load(eSprite::Turret, "turret");
-    m_pRenderer->Load(eSprite::MGTurret, "MGturret");
-    m_pRenderer->Load(eSprite::Line, "greenline");
-    m_pRenderer->Load(eSprite::Bar, "bar");
-
-    //powerups
-    m_pRenderer->Load(eSprite::Health, "health");
-    m_pRenderer->Load(eSprite::HealthUp, "healthup");
-    m_pRenderer->Load(eSprite::StaminaUp, "staminaup");
-    m_pRenderer->Load(eSprite::FocusUp, "focusup");
-    m_pRenderer->Load(eSprite::MovementSpeedUp, "movementspeedup");
-    m_pRenderer->Load(eSprite::DamageUp, "damageup");
-
-    m_pRenderer->Load(eSprite::Door, "door");
-    m_pRenderer->Load(eSprite::BossTurret, "bossturret");
-    m_pRenderer->Load(eSprite::AnimalControlOfficer, "animalcontrolofficer");
-    m_pRenderer->Load(eSprite::Ghost, "ghost");
-    m_pRenderer->Load(eSprite::AntSpriteSheet, "antwalk");
-    m_pRenderer->Load(eSprite::Ant, "ant");
-
-    m_pRenderer->EndResourceUpload();
-} //LoadImages
-
-/// Initialize the audio player and load game sounds.
-
-void CGame::LoadSounds()
-{
-    m_pAudio->Initialize(eSound::Size);
-
-    m_pAudio->Load(eSound::Grunt, "grunt");
-    m_pAudio->Load(eSound::Clang, "clang");
-    m_pAudio->Load(eSound::Gun, "gun");
-    m_pAudio->Load(eSound::Ricochet, "ricochet");
-    m_pAudio->Load(eSound::Start, "start");
-    m_pAudio->Load(eSound::Boom, "boom");
-    m_pAudio->Load(eSound::Ow, "ow");
-    m_pAudio->Load(eSound::FeroLoop, "feroLoop");
-    m_pAudio->Load(eSound::FeroLoop, "feroLoop");
-    m_pAudio->Load(eSound::SlowMoStart, "slowMoStart");
-    m_pAudio->Load(eSound::SlowMoEnd, "slowMoEnd");
-
-    //Load Garrett's Sounds
-    //Gun Sounds
-    m_pAudio->Load(eSound::Pistolclick, "9MMclick");       //
-    m_pAudio->Load(eSound::Pistolreload, "9MMreload");  //
-    m_pAudio->Load(eSound::AKreload, "AKreload");   //
-    m_pAudio->Load(eSound::AKrack, "AKrack");
-    m_pAudio->Load(eSound::AKclick, "AKclick");   //
-    m_pAudio->Load(eSound::bulletload, "bulletload");   //
-    //Guitar Sounds
-    m_pAudio->Load(eSound::Bend1, "Bend1"); //
-    m_pAudio->Load(eSound::Bend2, "Bend2");
-    m_pAudio->Load(eSound::Bend3, "Bend3"); //
-    m_pAudio->Load(eSound::Chug1, "Chug1"); //
-    m_pAudio->Load(eSound::Chug2, "Chug2"); //
-    m_pAudio->Load(eSound::PowerChord1, "PowerChord1"); //
-    m_pAudio->Load(eSound::PowerChord2, "PowerChord2"); //
-    m_pAudio->Load(eSound::PowerChord3, "PowerChord3"); //
-    m_pAudio->Load(eSound::PowerChord4, "PowerChord4");
-    m_pAudio->Load(eSound::Slide1, "Slide1"); //
-    m_pAudio->Load(eSound::Octave1, "Octave1");  //
-    m_pAudio->Load(eSound::HappyChord1, "HappyChord1"); //
-} //LoadSounds
-
-/// Release all of the DirectX12 objects by deleting the renderer.
-
-void CGame::Release() {
-    delete m_pRenderer;
-    m_pRenderer = nullptr; //for safety
-    //m_pBarDisplay->Release();
-} //Release
-
-/// Ask the object manager to create a player object and turrets specified by
-/// the tile manager.
-
-void CGame::CreateObjects()
-{
-    std::vector<Vector2> turretpos; //vector of turret positions
-    std::vector<Vector2> MGTurretPos; //vector of MG turret positions
-    std::vector<Vector2> antpos; //vector of ant positions
-    Vector2 playerpos; //player positions
-    std::vector<Vector2> ghostpos; //vector of ghost positions
-    std::vector<Vector2> bosspos; //boss positions
-
-    m_pTileManager->GetObjects(turretpos, MGTurretPos, antpos, playerpos, ghostpos, bosspos); //get positions
-
-    m_pPlayer = (CPlayer*)m_pObjectManager->create(eSprite::Player, playerpos);
-
-    for (const Vector2& pos : turretpos)
-        m_pObjectManager->create(eSprite::Turret, pos);
-
-    for (const Vector2& pos : MGTurretPos)
-        m_pObjectManager->create(eSprite::MGTurret, pos);
-
-    for (const Vector2& pos : antpos)
-        m_pObjectManager->create(eSprite::Ant, pos);
-
-    for (const Vector2& pos : ghostpos)
-        m_pObjectManager->create(eSprite::Ghost, pos);
-
-    for (const Vector2& pos : bosspos)
-        m_pObjectManager->create(eSprite::BossTurret, pos);
-
-} //CreateObjects
-
-/// Call this function to start a new game. This should be re-entrant so that
-/// you can restart a new game without having to shut down and restart the
-/// program. Clear the particle engine to get rid of any existing particles,
-/// delete any old objects out of the object manager and create some new ones.
-
-void CGame::BeginGame()
-{
-    m_pParticleEngine->clear(); //clear old particles
-
-    if (m_pRandom->randf() < 0.5f)
-    {
-        if (m_pRandom->randf() < 0.5f)
-        {
-            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
-            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1a.txt"); break;
-            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2a.txt"); break;
-            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3a.txt"); break;
-            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4a.txt"); break;
-            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5a.txt"); break;
-            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6a.txt"); break;
-            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7a.txt"); break;
-            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8a.txt"); break;
-            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9a.txt"); break;
-            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
-            } //switch
-        }
-        else
-        {
-            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
-            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1c.txt"); break;
-            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2c.txt"); break;
-            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3c.txt"); break;
-            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4c.txt"); break;
-            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5c.txt"); break;
-            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6c.txt"); break;
-            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7c.txt"); break;
-            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8c.txt"); break;
-            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9c.txt"); break;
-            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
-            } //switch
-        }
-    }
-    else
-    {
-        if (m_pRandom->randf() < 0.5f)
-        {
-            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
-            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1b.txt"); break;
-            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2b.txt"); break;
-            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3b.txt"); break;
-            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4b.txt"); break;
-            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5b.txt"); break;
-            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6b.txt"); break;
-            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7b.txt"); break;
-            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8b.txt"); break;
-            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9b.txt"); break;
-            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
-            } //switch
-        }
-        else
-        {
-            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
-            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1d.txt"); break;
-            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2d.txt"); break;
-            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3d.txt"); break;
-            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4d.txt"); break;
-            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5d.txt"); break;
-            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6d.txt"); break;
-            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7d.txt"); break;
-            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8d.txt"); break;
-            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9d.txt"); break;
-            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
-            } //switch
-        }
-    }
-
-    //### Uncomment whichever level you want to test, and comment out the above switch case ###
-    //m_pTileManager->LoadMap("Media\\Maps\\map1.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map2.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map3.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map4.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map5.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map6.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map7.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map8.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\map9.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\boss.txt");
-    //m_pTileManager->LoadMap("Media\\Maps\\TEST.txt");
-    //###                                                                                   ###
-
-    m_pObjectManager->clear(); //clear old objects
-    CreateObjects(); //create new objects (must be after map is loaded)
-
-    //Update the player's stat values after the player object has been created
-    m_pPlayer->m_nMaxHealth = m_nMaxHealthS;
-    m_pPlayer->m_nMaxFocus = m_nMaxFocusS;
-    m_pPlayer->m_nMaxStamina = m_nMaxStaminaS;
-    m_pPlayer->m_fMovementSpeed = m_fMovementSpeedS;
-    m_pPlayer->m_fMovementSpeedModifier = m_fMovementSpeedModifierS;
-    m_pPlayer->m_nDamageUpgrades = m_nDamageUpgradesS;
-    m_pPlayer->m_nHealth = m_nHealthS;
-    m_pPlayer->m_nFocus = m_nFocusS;
-    m_pPlayer->m_nStamina = m_nStaminaS;
-    m_pPlayer->m_nWeaponSelector = m_nWeaponSelectorS;
-
-    //m_pAudio->stop(); //stop all  currently playing sounds
-    m_pAudio->play(eSound::Chug1); //play start-of-game sound
-    m_eGameState = eGameState::Playing; //now playing
-} //BeginGame
-
-/// Poll the keyboard state and respond to the key presses that happened since
-/// the last frame.
-
-void CGame::KeyboardHandler()
-{
-    float first_push = 0, second_push = 0;     //time float for double pressing keys (used for dashing)
-
-    m_pKeyboard->GetState(); //get current keyboard state
-
-    if (m_pKeyboard->TriggerDown(VK_F1)) //help
-        ShellExecute(0, 0, "https://larc.unt.edu/code/topdown/", 0, 0, SW_SHOW);
-
-    if (m_pKeyboard->TriggerDown(VK_F2)) //toggle frame rate
-        m_bDrawFrameRate = !m_bDrawFrameRate;
-
-    if (m_pKeyboard->TriggerDown(VK_F3)) //toggle AABB drawing
-        m_bDrawAABBs = !m_bDrawAABBs;
-
-    if (m_pKeyboard->TriggerDown(VK_BACK)) //start game
-        BeginGame();
-
-    if (m_pPlayer) 
-    { //safety
-
-        if (m_pKeyboard->TriggerDown(VK_UP)) //move forwards
-            m_pPlayer->SetSpeed(100.0f);
-
-        if (m_pKeyboard->TriggerUp(VK_UP)) //stop
-            m_pPlayer->SetSpeed(0.0f);
-
-        //sprint: makes player move quickly towards where they are facing
-        if (m_pKeyboard->TriggerDown(VK_LSHIFT)) 
-        {
-            if (m_pPlayer->m_nStamina > 0)     //if stamina is not empty
-            {
-                m_pPlayer->m_fTimeLastDash = m_pTimer->GetTime();
-                m_pPlayer->m_bIsDashing = true;
-                m_pPlayer->m_nStamina--;    //immediately lower stamina on press, to prevent sprint spamming
-            }
-            else
-            {
-                m_pPlayer->SetSpeed(0.0f);
-            }
-        }
-
-        //stop sprinting
-        if (m_pKeyboard->TriggerUp(VK_LSHIFT)) 
-        {
-            m_pPlayer->SetSpeed(0.0f);
-            m_pPlayer->m_bIsDashing = false;
-        }
-
-        if (m_pKeyboard->TriggerDown(VK_RIGHT)) //rotate clockwise
-            m_pPlayer->SetRotSpeed(-2.5f);
-
-        if (m_pKeyboard->TriggerUp(VK_RIGHT)) //stop rotating clockwise
-            m_pPlayer->SetRotSpeed(0.0f);
-
-        if (m_pKeyboard->TriggerDown(VK_LEFT)) //rotate counterclockwise
-            m_pPlayer->SetRotSpeed(2.5f);
-
-        if (m_pKeyboard->TriggerUp(VK_LEFT)) //stop rotating counterclockwise
-            m_pPlayer->SetRotSpeed(0.0f);
-
-        if (m_pKeyboard->TriggerDown(VK_SPACE)) //fire gun
-        {
-            switch (m_pPlayer->m_nWeaponSelector)
-            {
-                case 0:
-                    if ((m_pPlayer->m_nRevolverMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
-                    {
-                        m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
-                        m_pPlayer->m_nRevolverMag -= 1; // remove 1 bullet from the magazine
-                    }
-                    else
-                    {
-                        m_pAudio->play(eSound::Pistolclick);
-                    }
-                    break;
-                case 1:  
-                    if ((m_pPlayer->m_nPistolMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
-                    {
-                        m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
-                        m_pPlayer->m_nPistolMag -= 1; // remove 1 bullet from the magazine
-                    }
-                    else
-                    {
-                        m_pAudio->play(eSound::Pistolclick);
-                    }
-                    break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
-                case 2:  
-                    if ((m_pPlayer->m_nShotgunMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
-                    {
-                        for (int i = 0; i < m_pPlayer->m_nShotgunPellets; i++)  //fire a bullet for whatever the damage modifier would be instead of actually increasing the damage
-                        {
-                            m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
-                        }
-
-                        m_pPlayer->m_nShotgunMag -= 1; // remove 1 bullet from the magazine
-                    }
-                    else
-                    {
-                        m_pAudio->play(eSound::AKclick);
-                    }
-                    break;
-                case 3:  break;
-                case 4:  break;
-            }
-
-        }
-
-
-        if (m_pKeyboard->Down('A'))     //strafe right
-        {
-            m_pPlayer->StrafeRight();   //set strafe right true in CPlayer::move()
-        }
-
-        if (m_pKeyboard->Down('D'))     //strafe left
-        {
-            m_pPlayer->StrafeLeft();
-        }
-        if (m_pKeyboard->Down('W'))  //strafe forward
-        {
-            m_pPlayer->StrafeForward();
-        }
-
-        if (m_pKeyboard->Down('S')) //strafe backward
-        {
-            m_pPlayer->StrafeBackward();
-        }
-
-        if (m_pKeyboard->TriggerDown('F')) //toggle focus mode
-        {
-            if (m_pPlayer->m_bIsFocusing == false)   //if not focusing, start focusing
-            {
-                m_pPlayer->m_fTimeLastFocus = m_pTimer->GetTime();  //get the time for when the player started focusing
-                m_pPlayer->m_bIsFocusing = true;
-                m_pAudio->play(eSound::SlowMoStart); //technically could break if past focus time? Is there a way to make this louder?
-            }
-            else if (m_pPlayer->m_bIsFocusing == true)
-            {
-                m_pPlayer->m_fTimeLastFocus = 0;    //reset player focus for safety
-                m_pPlayer->m_bIsFocusing = false;
-                m_pAudio->play(eSound::SlowMoEnd); //Technically could break if past focus time? Is there a way to make this louder?
-            }
-        }
-
-        if (m_pKeyboard->TriggerDown('R')) // Reload Currently Equiped Gun
-        {
-            switch (m_pPlayer->m_nWeaponSelector)
-            {
-                case 0: //The magnum is a revolver, so its ammo must be individually loaded (MASH THAT 'R' KEY!!!!)
-                    if (m_pPlayer->m_nRevolverMag < m_pPlayer->m_nRevolverFullMag)  //if gun is not full
-                    {
-                        m_pAudio->play(eSound::bulletload);
-                        m_pPlayer->m_fTimeLastReload = m_pTimer->GetTime(); //get reload time
-                        m_pPlayer->m_bIsReloading = true;  //set reloading to true
-                        m_pPlayer->m_nRevolverMag += 1; // add 1 bullet to the magazine
-                    }
-                    break;
-                case 1: //The pistol has a magazine, so it must take some time to reload, but it does every round all at once!
-                    if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nPistolMag != m_pPlayer->m_nPistolFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
-                    {
-                        m_pAudio->play(eSound::Pistolreload);
-                        m_pPlayer->m_fTimeLastReload = m_pTimer->GetTime(); //get reload time
-                        m_pPlayer->m_bIsReloading = true;  //set reloading to true
-                    }
-                    break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
-                case 2: //The shotgun has a magazine, so it must take some time to reload, but it does every round all at once!
-                    if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nShotgunMag != m_pPlayer->m_nShotgunFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
-                    {
-                        m_pAudio->play(eSound::AKreload);
-                        m_pPlayer->m_fTimeLastReload = m_pTimer->GetTime(); //get reload time
-                        m_pPlayer->m_bIsReloading = true;  //set reloading to true
-                    }
-                    break;
-                case 3:  break;
-                case 4:  break;
-            }
-        }
-
-        if (m_pKeyboard->TriggerDown('1')) // Switch to Revolver
-        {
-            m_pAudio->play(eSound::AKrack);
-            m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
-            m_pPlayer->m_nWeaponSelector = 0;
-            m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
-        }
-
-        if (m_pKeyboard->TriggerDown('2')) // Switch to Pistol
-        {
-            m_pAudio->play(eSound::AKrack);
-            m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
-            m_pPlayer->m_nWeaponSelector = 1;
-            m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
-        }
-
-        if (m_pKeyboard->TriggerDown('3')) // Switch to Shotgun
-        {
-            m_pAudio->play(eSound::AKrack);
-            m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
-            m_pPlayer->m_nWeaponSelector = 2;
-            m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
-        }
-
-        if (m_pKeyboard->TriggerDown('4')) // Switch to ______
-        {
-            //m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
-            //m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
-            //m_pPlayer->m_nWeaponSelector = 3;
-        }
-
-        if (m_pKeyboard->TriggerDown('5')) // Switch to ______
-        {
-            //m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
-            //m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
-            //m_pPlayer->m_nWeaponSelector = 4;
-        }
-
-        if (m_pKeyboard->TriggerDown('G')) //toggle god mode
-            m_bGodMode = !m_bGodMode;
-    } //if
-} //KeyboardHandler
-
-/// Poll the XBox controller state and respond to the controls there.
-
-void CGame::ControllerHandler()
-{
-    if (!m_pController->IsConnected())return;
-
-    m_pController->GetState(); //get state of controller's controls 
-
-    if (m_pPlayer) { //safety
-        m_pPlayer->SetSpeed(100 * m_pController->GetRTrigger());
-        m_pPlayer->Aim(m_pController->GetRThumb());
-
-        if (m_pController->GetButtonRSToggle()) //fire gun
-        {
-            switch (m_pPlayer->m_nWeaponSelector)
-            {
-            case 0:
-                if ((m_pPlayer->m_nRevolverMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
-                {
-                    m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
-                    m_pPlayer->m_nRevolverMag -= 1; // remove 1 bullet from the magazine
-                }
-                else
-                {
-                    m_pAudio->play(eSound::Pistolclick);
-                }
-                break;
-            case 1:
-                if ((m_pPlayer->m_nPistolMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
-                {
-                    m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
-                    m_pPlayer->m_nPistolMag -= 1; // remove 1 bullet from the magazine
-                }
-                else
-                {
-                    m_pAudio->play(eSound::Pistolclick);
-                }
-                break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
-            case 2:
-                if ((m_pPlayer->m_nShotgunMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
-                {
-                    for (int i = 0; i < m_pPlayer->m_nShotgunPellets; i++)  //fire a bullet for whatever the damage modifier would be instead of actually increasing the damage
-                    {
-                        m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
-                    }
-
-                    m_pPlayer->m_nShotgunMag -= 1; // remove 1 bullet from the magazine
-                }
-                else
-                {
-                    m_pAudio->play(eSound::AKclick);
-                }
-                break;
-            case 3:  break;
-            case 4:  break;
-            }
-
-        }
-        
-        //Reload
-        if (m_pController->GetButtonXToggle())
-        {
-            switch (m_pPlayer->m_nWeaponSelector)
-            {
-            case 0: //The magnum is a revolver, so its ammo must be individually loaded (MASH THAT 'R' KEY!!!!)
-                if (m_pPlayer->m_nRevolverMag < m_pPlayer->m_nRevolverFullMag)  //if gun is not full
-                {
-                    m_pAudio->play(eSound::bulletload);
-                    m_pPlayer->m_fTimeLastReload = m_pTimer->GetTime(); //get reload time
-                    m_pPlayer->m_bIsReloading = true;  //set reloading to true
-                    m_pPlayer->m_nRevolverMag += 1; // add 1 bullet to the magazine
-                }
-                break;
-            case 1: //The pistol has a magazine, so it must take some time to reload, but it does every round all at once!
-                if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nPistolMag != m_pPlayer->m_nPistolFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
-                {
-                    m_pAudio->play(eSound::Pistolreload);
-                    m_pPlayer->m_fTimeLastReload = m_pTimer->GetTime(); //get reload time
-                    m_pPlayer->m_bIsReloading = true;  //set reloading to true
-                }
-                break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
-            case 2: //The shotgun has a magazine, so it must take some time to reload, but it does every round all at once!
-                if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nShotgunMag != m_pPlayer->m_nShotgunFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
-                {
-                    m_pAudio->play(eSound::AKreload);
-                    m_pPlayer->m_fTimeLastReload = m_pTimer->GetTime(); //get reload time
-                    m_pPlayer->m_bIsReloading = true;  //set reloading to true
-                }
-                break;
-            case 3:  break;
-            case 4:  break;
-            }
-        }
-
-        //Start sprinting if you have stamina
-        if (m_pController->GetLTrigger() == 1)
-        {
-            if (m_pPlayer->m_nStamina > 0) {    //if stamina is not empty
-
-                m_pPlayer->m_bIsDashing = true;
-            }
-            else
-            {
-                m_pPlayer->SetSpeed(0.0f);
-            }
-        }
-
-        //Stop sprinting
-        if (m_pController->GetLTrigger() == 0)
-        {
-            m_pPlayer->SetSpeed(0.0f);
-            m_pPlayer->m_bIsDashing = false;
-        }
-
-        //Toggle focus
-        if (m_pController->GetButtonYToggle())
-        {
-            if (m_pPlayer->m_bIsFocusing == false)   //if not focusing, start focusing
-            {
-                m_pPlayer->m_fTimeLastFocus = m_pTimer->GetTime();  //get the time for when the player started focusing
-                m_pPlayer->m_bIsFocusing = true;
-                m_pAudio->play(eSound::SlowMoStart); //technically could break if past focus time? Is there a way to make this louder?
-            }
-            else if (m_pPlayer->m_bIsFocusing == true)
-            {
-                m_pPlayer->m_fTimeLastFocus = 0;    //reset player focus for safety
-                m_pPlayer->m_bIsFocusing = false;
-                m_pAudio->play(eSound::SlowMoEnd); //Technically could break if past focus time? Is there a way to make this louder?
-            }
-        }
-
-        //Change weapon up.
-        if (m_pController->GetButtonBToggle())
-        {
-            m_pAudio->play(eSound::AKrack);
-            m_pPlayer->m_nWeaponSelector++;
-
-            if (m_pPlayer->m_nWeaponSelector > 2)
-            {
-                m_pPlayer->m_nWeaponSelector = 0;
-            }
-        }
-
-        //Change weapon down.
-        if (m_pController->GetButtonAToggle())
-        {
-            m_pAudio->play(eSound::AKrack);
-            m_pPlayer->m_nWeaponSelector--;
-
-            if (m_pPlayer->m_nWeaponSelector < 0)
-            {
-                m_pPlayer->m_nWeaponSelector = 2;
-            }
-        }
-
-        if (m_pController->GetDPadRight()) //strafe right
-            m_pPlayer->StrafeLeft();
-
-        if (m_pController->GetDPadLeft()) //strafe left
-            m_pPlayer->StrafeRight();
-
-        if (m_pController->GetDPadDown()) //strafe back
-            m_pPlayer->StrafeBackward();
-
-        if (m_pController->GetDPadUp()) //strafe back
-            m_pPlayer->StrafeForward();
-    } //if
-} //ControllerHandler
-
-/// Draw the current frame rate to a hard-coded position in the window.
-/// The frame rate will be drawn in a hard-coded position using the font
-/// specified in `gamesettings.xml`.
-
-void CGame::DrawFrameRateText()
-{
-    const std::string s = std::to_string(m_pTimer->GetFPS()) + " fps"; //frame rate
-    const Vector2 pos(m_nWinWidth - 128.0f, 30.0f); //hard-coded position
-    m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
-} //DrawFrameRateText
-
-/// Draw the god mode text to a hard-coded position in the window using the
-/// font specified in `gamesettings.xml`.
-
-void CGame::DrawGodModeText()
-{
-    const Vector2 pos(64.0f, 270.0f); //hard-coded position
-    m_pRenderer->DrawScreenText("God Mode", pos); //draw to screen
-} //DrawGodModeText
-
-void CGame::DrawFocusModeText()
-{
-    const Vector2 pos(64.0f, 210.0f); //hard-coded position
-    m_pRenderer->DrawScreenText("Focusing!!!", pos); //draw to screen
-} //DrawFocusModeText 
-
-void CGame::DrawPlayerComboText()
-{
-    const Vector2 pos(64.0f, 180.0f); //hard-coded position
-    std::string combo_text = "COMBO: " + std::to_string(m_pPlayer->m_nCombo); //string for players combo
-    m_pRenderer->DrawScreenText(combo_text.c_str(), pos, Colors::Black); //draw player's combo to screen
-} //DrawPlayerComboText
-
-void CGame::DrawPlayerDamageText()       //draw player's damage (this is mostly for testing and may be removed later)
-{
-    const Vector2 pos(64.0f, 150.0f); //hard-coded position
-    std::string damage_text = "DAMAGE: " + std::to_string(m_pPlayer->m_nPlayerDamage); //string for players damage
-    m_pRenderer->DrawScreenText(damage_text.c_str(), pos, Colors::Black); //draw player's damage to screen
-} //DrawPlayerDamageText
-
-void CGame::DrawReloadingText()
-{
-    const Vector2 pos(64.0f, 240.0f); //hard-coded position
-    m_pRenderer->DrawScreenText("Reloading...", pos); //draw to screen
-} //DrawReloadingText 
-
-void CGame::DrawRevolverAmmoText()
-{
-    const Vector2 pos(64.0f, 300.0f); //hard-coded position
-    std::string gun_text = "Magnum: " + std::to_string(m_pPlayer->m_nRevolverMag) + "/" + std::to_string(m_pPlayer->m_nRevolverFullMag); //string for players gun ammo
-    m_pRenderer->DrawScreenText(gun_text.c_str(), pos, Colors::Black); //draw player's damage to screen
-}//DrawRevolverAmmo
-
-void CGame::DrawPistolAmmoText()
-{
-    const Vector2 pos(64.0f, 300.0f); //hard-coded position
-    std::string gun_text = "Pistol: " + std::to_string(m_pPlayer->m_nPistolMag) + "/" + std::to_string(m_pPlayer->m_nPistolFullMag); //string for players damage
-    m_pRenderer->DrawScreenText(gun_text.c_str(), pos, Colors::Black); //draw player's damage to screen
-}//DrawPistolAmmoText
-
-void CGame::DrawShotgunAmmoText()
-{
-    const Vector2 pos(64.0f, 300.0f); //hard-coded position
-    std::string gun_text = "Shotgun: " + std::to_string(m_pPlayer->m_nShotgunMag) + "/" + std::to_string(m_pPlayer->m_nShotgunFullMag); //string for players damage
-    m_pRenderer->DrawScreenText(gun_text.c_str(), pos, Colors::Black); //draw player's damage to screen
-}//DrawShotgunAmmoText
-
-void CGame::DrawBarDisplay(eSprite sprite, int p, int i, Vector2 pos)
-{
-    if (m_pPlayer != NULL)
-    { //if the player is alive
-        //std::string hp_text = "Heath: " + std::to_string(m_pPlayer->m_nHealth) + "/" + std::to_string(m_pPlayer->m_nMaxHealth); //string for players health
-        //m_pRenderer->DrawBoxFilled(64, m_nWinHeight - 50, 100, 100, Vector4(0.0, 0.0, 0.0, 255.0)); //This does not work and I do not know why
-        LSpriteDesc2D desc;
-        desc.m_nCurrentFrame = p;
-        desc.m_nSpriteIndex = (UINT)sprite; //sprite index forsprite index for barSprite
-        desc.m_vPos.x = pos.x;
-        desc.m_vPos.y = pos.y;
-        int width = m_pRenderer->GetWidth(eSprite::Bar);
-
-        for (int j = 0; j <= i; j++)
-        {
-            m_pRenderer->Draw(&desc);
-            //m_pObjectManager->create(sprite, pos);
-            desc.m_vPos.x += width + 1.0;
-        }
-    }
-} //DrawPlayerHealthDisplay
-
-void CGame::DrawPlayerHealthText()
-{
-
-    const Vector2 pos(64.0f, 30.0f); //hard-coded position
-    if (m_pPlayer != NULL)
-    { //if the player is alive
-        std::string hp_text = "Heath: " + std::to_string(m_pPlayer->m_nHealth) + "/" + std::to_string(m_pPlayer->m_nMaxHealth); //string for players health
-        m_pRenderer->DrawScreenText(hp_text.c_str(), pos, Colors::Red); //draw player's Heath to screen
-    }
-
-} //DrawPlayerHealthText 
-
-void CGame::DrawPlayerFocusText()
-{
-    const Vector2 pos(64.0f, 60.0f); //hard-coded position
-    if (m_pPlayer != NULL)
-    { //if the player is alive
-        std::string fp_text = "Focus: " + std::to_string(m_pPlayer->m_nFocus) + "/" + std::to_string(m_pPlayer->m_nMaxFocus); //string for players Focus
-        m_pRenderer->DrawScreenText(fp_text.c_str(), pos, Colors::Blue); //draw player's Focus to screen
-    }
-
-} //DrawPlayerFocusText 
-
-void CGame::DrawPlayerStaminaText()
-{
-    const Vector2 pos(64.0f, 90.0f); //hard-coded position
-    if (m_pPlayer != NULL)
-    { //if the player is alive
-        std::string sp_text = "Stamina: " + std::to_string(m_pPlayer->m_nStamina) + "/" + std::to_string(m_pPlayer->m_nMaxStamina); //string for players Stamina
-        m_pRenderer->DrawScreenText(sp_text.c_str(), pos, Colors::Green); //draw player's Stamina to screen
-    }
-
-} //DrawPlayerStaminaText 
-
-void CGame::DrawDifficultyText()
-{
-    const Vector2 pos(64.0f, 120.0f); //hard-coded position
-    if (m_pPlayer != NULL)
-    { //if the player is alive
-        std::string sp_text = "Difficulty Mod: " + std::to_string(m_pObjectManager->m_nDifficultyModifier); //string for players Stamina
-        m_pRenderer->DrawScreenText(sp_text.c_str(), pos, Colors::Black); //draw player's Stamina to screen
-    }
-
-}
-
-
-/// Ask the object manager to draw the game objects. The renderer is notified of
-/// the start and end of the frame so that it can let Direct3D do its
-/// pipelining jiggery-pokery.
-
-void CGame::RenderFrame()
-{
-    m_pRenderer->BeginFrame();
-    //m_pRenderer->BeginFrameExt(); //required before rendering
-
-    m_pObjectManager->draw(); //draw objects
-    m_pParticleEngine->Draw(); //draw particles
-    if (m_bDrawFrameRate)DrawFrameRateText(); //draw frame rate, if required
-    if (m_bGodMode)DrawGodModeText(); //draw god mode text, if required
-
-    if (m_pPlayer != nullptr)
-    {
-        DrawBarDisplay(eSprite::Bar, 0, m_pPlayer->m_nHealth-1, Vector2(20, 1055));//Display Healthbar //Also player is null at the start but fixes itself
-        DrawBarDisplay(eSprite::Bar, 1, m_pPlayer->m_nStamina-1, Vector2(20, 52));//Display Staminabar
-        DrawBarDisplay(eSprite::Bar, 2, m_pPlayer->m_nFocus-1, Vector2(20, 22));//Display Staminabar
-        switch (m_pPlayer->m_nWeaponSelector)//Weapon ammo displayed based on equipped weapon
-        {
-            case 0: DrawBarDisplay(eSprite::Bar, 3, m_pPlayer->m_nRevolverMag-1, Vector2(20, 1030)); break; //Draw Revolver ammo
-            case 1: DrawBarDisplay(eSprite::Bar, 4, m_pPlayer->m_nPistolMag - 1, Vector2(20, 1030)); break; //Draw Pistol Ammo
-            case 2: DrawBarDisplay(eSprite::Bar, 5, m_pPlayer->m_nShotgunMag - 1, Vector2(20, 1030)); break; //Draw Shotgun Ammo
-            case 3:  break;
-            case 4:  break;
-        }
-        if (m_pPlayer->m_bIsFocusing == true)
-            DrawFocusModeText(); //draw focus mode text, if focusing and alive
-        if (m_pPlayer->m_bIsReloading == true)
-            DrawReloadingText();
-        if (m_pPlayer->m_nCombo != 0)
-            DrawPlayerComboText();  //if the player's combo is greater than 0, display it
-        DrawPlayerDamageText();  //draw player's damage (this is mostly for testing and may be removed later)
-        DrawDifficultyText();
-        //Picking which weapon ammo to display based on which is currently equipped
-        /* Previous Text display
-        switch (m_pPlayer->m_nWeaponSelector)
-        {
-            case 0: DrawRevolverAmmoText(); break;
-            case 1: DrawPistolAmmoText(); break;
-            case 2: DrawShotgunAmmoText(); break;
-            case 3:  break;
-            case 4:  break;
-        }
-        */
-    }
-
-    DrawPlayerHealthText(); //draw players current and max health
-    DrawPlayerFocusText();  //draw players current and max focus
-    DrawPlayerStaminaText(); //draw players current and max stamina
-
-
-    //DrawPlayerHealthDisplay(); //draw players current and max health
-    
-
-    m_pRenderer->EndFrame();
-    //m_pRenderer->EndFrameExt(); //required after rendering
-} //RenderFrame
-
-/// Make the camera follow the player, but don't let it get too close to the
-/// edge unless the world is smaller than the window, in which case we just
-/// center everything.
-
-void CGame::FollowCamera()
-{
-    if (m_pPlayer == nullptr)return; //safety
-
-    Vector3 vCameraPos(m_pPlayer->GetPos()); //player position
-
-    if (m_vWorldSize.x > m_nWinWidth) { //world wider than screen
-        vCameraPos.x = std::max(vCameraPos.x, m_nWinWidth / 2.0f); //stay away from the left edge
-        vCameraPos.x = std::min(vCameraPos.x, m_vWorldSize.x - m_nWinWidth / 2.0f);  //stay away from the right edge
-    } //if
-    else vCameraPos.x = m_vWorldSize.x / 2.0f; //center horizontally.
-
-    if (m_vWorldSize.y > m_nWinHeight) { //world higher than screen
-        vCameraPos.y = std::max(vCameraPos.y, m_nWinHeight / 2.0f);  //stay away from the bottom edge
-        vCameraPos.y = std::min(vCameraPos.y, m_vWorldSize.y - m_nWinHeight / 2.0f); //stay away from the top edge
-    } //if
-    else vCameraPos.y = m_vWorldSize.y / 2.0f; //center vertically
-
-    m_pRenderer->SetCameraPos(vCameraPos); //camera to player
-} //FollowCamera
-
-/// This function will be called regularly to process and render a frame
-/// of animation, which involves the following. Handle keyboard input.
-/// Notify the audio player at the start of each frame so that it can prevent
-/// multiple copies of a sound from starting on the same frame.  
-/// Move the game objects. Render a frame of animation. 
-
-void CGame::ProcessFrame()
-{
-    KeyboardHandler(); //handle keyboard input
-    ControllerHandler(); //handle controller input
-    m_pAudio->BeginFrame(); //notify audio player that frame has begun
-
-    m_pTimer->Tick([&]() { //all time-dependent function calls should go here
-        m_pObjectManager->move(); //move all objects
-        FollowCamera(); //make camera follow player
-        m_pParticleEngine->step(); //advance particle animation
-
-    });
-
-    RenderFrame(); //render a frame of animation
-    ProcessGameState(); //check for end of game
-    MusicHandler(); //Handles Music and looping
-} //ProcessFrame
-
-void CGame::MusicHandler()
-{
-    if (!start)
-    {
-        m_pAudio->loop(eSound::FeroLoop); //play background music
-        start = true;
-    }
-}
-
-/// Take action appropriate to the current game state. If the game is currently
-/// playing, then if the player has been killed or all turrets have been
-/// killed, then enter the wait state. If the game has been in the wait
-/// state for longer than 3 seconds, then restart the game.
-
-void CGame::ProcessGameState()
-{
-    static float t = 0; //time at start of game
-    
-
-    switch (m_eGameState) {
-    case eGameState::Playing:
-        if (m_pTimer->GetTime() - t > 60.0f && !m_bAnimalControlOfficerSpawned && m_nNextLevel != 9) //Checks if it's been past a minute, if the animal control officer has already spawned, and if the level is not the boss level.
-        {
-            m_pObjectManager->create(eSprite::AnimalControlOfficer, m_pPlayer->startingPosition);   //Summons the animal control officer after a certain amount of time.
-            m_bAnimalControlOfficerSpawned = true;
-        }
-        if (m_pPlayer == nullptr || m_pObjectManager->GetNumEnemies() == 0) {       //MIGHT REMOVE SECOND COMPARISON
-
-            m_eGameState = eGameState::Waiting; //now waiting
-            t = m_pTimer->GetTime(); //start wait timer
-        } //if
-        break;
-
-    case eGameState::Waiting:
-        if (m_pTimer->GetTime() - t > 0.5f)  //0.5 seconds has elapsed since level end
-        {
-            if ((m_pObjectManager->GetNumEnemies() == 0) && (m_pPlayer != nullptr)) //player won and didn't die                   //HERE IS WHERE THE LEVEL ENDS!!!
-            {
-                m_pAudio->play(eSound::HappyChord1);    //Victory Sound
-
-                //Save the player's updated stats from powerups
-                m_nMaxHealthS = m_pPlayer->m_nMaxHealth;
-                m_nMaxFocusS = m_pPlayer->m_nMaxFocus;
-                m_nMaxStaminaS = m_pPlayer->m_nMaxStamina;
-                m_fMovementSpeedS = m_pPlayer->m_fMovementSpeed;
-                m_fMovementSpeedModifierS = m_pPlayer->m_fMovementSpeedModifier;
-                m_nDamageUpgradesS = m_pPlayer->m_nDamageUpgrades;
-                m_nHealthS = m_pPlayer->m_nHealth;
-                m_nFocusS = m_pPlayer->m_nFocus;
-                m_nStaminaS = m_pPlayer->m_nStamina;
-
-                m_nWeaponSelectorS = m_pPlayer->m_nWeaponSelector;  //Keep the same weapon equiped
-
-                if (incrementFlag == false)
-                    m_nNextLevel = (m_nNextLevel + 1); //advance next level
-
-                if (m_nNextLevel == 10)  //if the level is passed the max level, reset to the level after the first level
-                {
-                    m_nNextLevel = 0;   //reset to first level
-                }
-                if (incrementFlag == false)
-                    m_pObjectManager->m_nDifficultyModifier++;    //difficulty is increased
-
-                incrementFlag = true;
-            }
-            else if (m_pPlayer == nullptr)  //player died, reset all their stats and the level back to level 1
-            {
-                m_pAudio->play(eSound::Octave1);    //Loss Sound
-   
-                //MAKE SURE TO UPDATE THESE IF THEY ARE CHANGED IN PLAYER.h
-                m_nMaxHealthS = 15;
-                m_nMaxFocusS = 10;
-                m_nMaxStaminaS = 5;
-                m_fMovementSpeedS = 150.0f;
-                m_fMovementSpeedModifierS = 0.0f;
-                m_nDamageUpgradesS = 0;
-                m_nHealthS = 15;
-                m_nFocusS = 10;
-                m_nStaminaS = 5;
-
-                m_nNextLevel = 0;   //reset to first level
-                m_pObjectManager->m_nDifficultyModifier = 0;   //reset difficulty
-
-            }
-            if (m_pTimer->GetTime() - t > 3.0f) //wait for sound to play first
-            {
-                m_bAnimalControlOfficerSpawned = false;
-                incrementFlag = false;
-                BeginGame(); //restart game
-            }
-        } //if
-        break;
-    } //switch
+/// \file Game.cpp
+/// \brief Code for the game class CGame.
+
+#include "Game.h"
+
+#include "GameDefines.h"
+//#include "ExtRenderer.h"
+#include "SpriteRenderer.h"
+#include "ComponentIncludes.h"
+#include "ParticleSystem.h"
+#include "TileManager.h"
+
+#include "shellapi.h"
+
+#include "Player.h"     //to get access to player's health for display of 'healthbar'
+#include "BarDisplay.h"
+#include "Archetype.h"
+#include "JobSystem.h"
+#include "RenderThread.h"
+#include "FrameBudget.h"
+#include "RateScheduler.h"
+#include "Rng.h"
+#include "LootTable.h"
+#include "SpawnPool.h"
+#include "BulletPattern.h"
+#include "FlowField.h"
+#include "PathFinder.h"
+#include "PathHierarchy.h"
+
+/// Sprite types and the names of their sprite tags in `gamesettings.xml`.
+
+static const std::vector<std::pair<eSprite, const char*>> g_vecImages = {
+    {eSprite::Tile, "tile"},
+    {eSprite::Player, "player"},
+    {eSprite::Bullet, "bullet"},
+    {eSprite::Bullet2, "bullet2"},
+    {eSprite::Smoke, "smoke"},
+    {eSprite::Spark, "spark"},
+    {eSprite::Turret, "turret"},
+    {eSprite::MGTurret, "MGturret"},
+    {eSprite::Line, "greenline"},
+    {eSprite::Bar, "bar"},
+
+    //powerups
+    {eSprite::Health, "health"},
+    {eSprite::HealthUp, "healthup"},
+    {eSprite::StaminaUp, "staminaup"},
+    {eSprite::FocusUp, "focusup"},
+    {eSprite::MovementSpeedUp, "movementspeedup"},
+    {eSprite::DamageUp, "damageup"},
+
+    {eSprite::Door, "door"},
+    {eSprite::BossTurret, "bossturret"},
+    {eSprite::AnimalControlOfficer, "animalcontrolofficer"},
+    {eSprite::Ghost, "ghost"},
+    {eSprite::AntSpriteSheet, "antwalk"},
+    {eSprite::Ant, "ant"},
+}; //g_vecImages
+
+/// Delete the renderer, the object manager, and the tile manager. The renderer
+/// needs to be deleted before this destructor runs so it will be done elsewhere.
+
+CGame::~CGame()
+{
+    delete m_pParticleSystem;
+    delete m_pObjectManager;
+    delete m_pFrameBudget; //after the objects, which cancel their tasks in it
+    delete m_pScheduler;
+    delete m_pRng;
+    delete m_pPathHierarchy;
+    delete m_pPathFinder;
+    delete m_pFlowField;
+    delete m_pTileManager;
+    delete m_pBarDisplay;
+    delete m_pJobSystem;
+    delete m_pReplay; //closes the replay file
+    delete m_pInput;
+} //destructor
+
+/// Initialize the renderer, the tile manager and the object manager, load 
+/// images and sounds, and begin the game. When headless there is no renderer,
+/// so the sprite sizes are read from the image files instead, and the replay
+/// settings come from the headless runner instead of `gamesettings.xml`.
+
+void CGame::Initialize()
+{
+    if (m_bHeadless)
+        CArchetypeTable::ReadImageSizes(m_pXmlSettings, g_vecImages); //no renderer to ask
+
+    else
+    {
+        //m_pRenderer = new ExtRenderer(eSpriteMode::Batched2D);
+        m_pRenderer = new LSpriteRenderer(eSpriteMode::Batched2D);
+        m_pRenderer->Initialize(eSprite::Size);
+        LoadImages(); //load images from xml file list
+    } //else
+
+    CArchetypeTable::Build(); //must be after images are loaded
+    CLootTable::Load(m_pXmlSettings, g_vecImages); //enemy drops
+    CSpawnPool::Load(m_pXmlSettings, g_vecImages); //random enemies on maps
+    CBulletPattern::Load(m_pXmlSettings); //boss bullet patterns
+    LoadSimSettings(); //simulation rate
+    LoadRenderSettings(); //render thread
+    if (!m_bHeadless)LoadReplaySettings(); //record or play back
+
+    m_pJobSystem = new CJobSystem; //one thread per hardware thread
+    m_pRng = new CRngService; //seeded in StartReplay()
+    m_pFrameBudget = new CFrameBudget; //must be before any objects are created
+    LoadBudgetSettings(); //frame time budget
+    m_pScheduler = new CRateScheduler;
+    LoadRateSettings(); //subsystem update rates, must be after simulation settings
+    m_pTileManager = new CTileManager((size_t)CArchetypeTable::Get(eSprite::Tile).m_fWidth);
+    m_pFlowField = new CFlowField; //toward the player, for chasers
+    m_pPathFinder = new CPathFinder;
+    m_pPathHierarchy = new CPathHierarchy;
+    m_pObjectManager = new CObjectManager; //set up the object manager 
+    LoadAISettings(); //AI level of detail
+    m_pObjectManager->SetThinkInterval(m_pScheduler->GetInterval(eSubsystem::AI));
+    LoadSounds(); //load the sounds for this game
+
+    if (m_bHeadless) //nothing to draw with, so snapshots are thrown away
+        m_pRenderThread = new CRenderThread([](const SWorldSnapshot&) {}, false);
+
+    else
+    {
+        m_pParticleSystem = new CParticleSystem;
+        m_pRenderThread = new CRenderThread([&](const SWorldSnapshot& s) { RenderFrame(s); },
+            m_bRenderThread);
+    } //else
+
+    m_pInput = new CInput;
+    m_pReplay = new CReplay;
+    StartReplay(); //must be before anything random happens
+
+    BeginGame();
+} //Initialize
+
+/// Initialize the game to run without a window, renderer, or input devices.
+/// Every frame is one simulation step with no keys pressed, unless a replay
+/// file is given, in which case the input and frame times come from that.
+/// \param replay Name of replay file to play back, or empty for none.
+/// \param seed Random number seed if not playing back.
+
+void CGame::InitializeHeadless(const std::string& replay, UINT seed)
+{
+    m_bHeadless = true;
+    m_nSeed = seed;
+    m_eReplayMode = replay.empty() ? eReplayMode::Off : eReplayMode::Play;
+    m_strReplayFile = replay;
+
+    Initialize();
+} //InitializeHeadless
+
+/// Load the simulation rate and the maximum number of simulation steps per
+/// frame from the `simulation` tag in `gamesettings.xml`. If the tag is
+/// missing then the defaults are used.
+
+void CGame::LoadSimSettings()
+{
+    if (m_pXmlSettings == nullptr)return; //no settings, use defaults
+
+    tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("simulation");
+    if (pTag == nullptr)return; //no simulation tag, use defaults
+
+    const float fRate = pTag->FloatAttribute("rate", 1.0f/m_fSimStep); //steps per second
+    if (fRate > 0)m_fSimStep = 1.0f/fRate;
+
+    m_nMaxSimSteps = std::max(1u, pTag->UnsignedAttribute("maxsteps", m_nMaxSimSteps));
+} //LoadSimSettings
+
+/// Load whether to draw on a render thread from the `render` tag in
+/// `gamesettings.xml`. If the tag is missing then the default is used.
+
+void CGame::LoadRenderSettings()
+{
+    if (m_pXmlSettings == nullptr)return; //no settings, use defaults
+
+    tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("render");
+    if (pTag == nullptr)return; //no render tag, use defaults
+
+    m_bRenderThread = pTag->BoolAttribute("threaded", m_bRenderThread);
+} //LoadRenderSettings
+
+/// Load the AI level of detail from the `ai` tag in `gamesettings.xml`.
+/// AI runs at the full rate within distance `near` of the player, and at
+/// half the rate for each doubling of that distance, down to once every
+/// `maxinterval` steps. Setting `lod` to 0 runs all AI at the full rate.
+/// Ant crowd steering comes from the `crowd` tag. Ants steer away from ants
+/// closer than `distance` times the sum of their radii, and away from ants
+/// that they would hit within `avoidtime` seconds. Setting `separation` to 0
+/// turns crowd steering off. If a tag is missing then its defaults are used.
+/// Must be called after the object manager is created.
+
+void CGame::LoadAISettings()
+{
+    if (m_pXmlSettings == nullptr)return; //no settings, use defaults
+
+    tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("ai");
+
+    if (pTag != nullptr)
+        m_pObjectManager->SetThinkLOD(pTag->BoolAttribute("lod", true),
+            pTag->FloatAttribute("near", 1024.0f), pTag->UnsignedAttribute("maxinterval", 8));
+
+    pTag = m_pXmlSettings->FirstChildElement("crowd");
+
+    if (pTag != nullptr)
+        m_pObjectManager->SetSeparation(pTag->BoolAttribute("separation", true),
+            pTag->FloatAttribute("distance", 2.0f), pTag->FloatAttribute("avoidtime", 0.5f));
+} //LoadAISettings
+
+/// Load the update rates of the subsystems that don't need to be updated on
+/// every simulation step or every frame from the `rates` tag in
+/// `gamesettings.xml`. The rates are in updates per second, and 0 means
+/// every step for the AI and every frame for the rest. The physics runs at
+/// the simulation rate from the `simulation` tag. The AI runs on simulation
+/// steps, so its rate is rounded to a whole number of steps. If the tag is
+/// missing then the defaults are used. Must be called after the simulation
+/// settings are loaded and the scheduler is created.
+
+void CGame::LoadRateSettings()
+{
+    m_pScheduler->SetStep(eSubsystem::Physics, m_fSimStep, m_nMaxSimSteps);
+    m_pScheduler->SetRate(eSubsystem::Particles, 30.0f);
+
+    if (m_pXmlSettings == nullptr)return; //no settings, use defaults
+
+    tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("rates");
+    if (pTag == nullptr)return; //no rates tag, use defaults
+
+    m_pScheduler->SetRate(eSubsystem::AI, pTag->FloatAttribute("ai", 0.0f));
+    m_pScheduler->SetRate(eSubsystem::Camera, pTag->FloatAttribute("camera", 0.0f));
+    m_pScheduler->SetRate(eSubsystem::Particles, pTag->FloatAttribute("particles", 30.0f));
+} //LoadRateSettings
+
+/// Load the frame time budget for deferrable work, the most frames that a
+/// deferrable task may wait, and whether deferral is enabled, from the
+/// `budget` tag in `gamesettings.xml`. If the tag is missing then the
+/// defaults are used. Must be called after the frame budget manager is created.
+
+void CGame::LoadBudgetSettings()
+{
+    if (m_pXmlSettings == nullptr)return; //no settings, use defaults
+
+    tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("budget");
+    if (pTag == nullptr)return; //no budget tag, use defaults
+
+    m_pFrameBudget->SetBudget(pTag->FloatAttribute("ms", m_pFrameBudget->GetBudget()),
+        pTag->UnsignedAttribute("maxdelay", 8));
+    m_pFrameBudget->SetEnabled(pTag->BoolAttribute("enabled", true));
+} //LoadBudgetSettings
+
+/// Load the replay mode, the replay file name, the report file name, and
+/// whether to quit when playback ends from the `replay` tag in
+/// `gamesettings.xml`. The mode is one of `off`, `record`, or `play`. If the
+/// tag is missing then the defaults are used.
+
+void CGame::LoadReplaySettings()
+{
+    if (m_pXmlSettings == nullptr)return; //no settings, use defaults
+
+    tinyxml2::XMLElement* pTag = m_pXmlSettings->FirstChildElement("replay");
+    if (pTag == nullptr)return; //no replay tag, use defaults
+
+    const char* mode = pTag->Attribute("mode");
+
+    if (mode != nullptr)
+    {
+        if (strcmp(mode, "record") == 0)m_eReplayMode = eReplayMode::Record;
+        else if (strcmp(mode, "play") == 0)m_eReplayMode = eReplayMode::Play;
+        else m_eReplayMode = eReplayMode::Off;
+    } //if
+
+    const char* file = pTag->Attribute("file");
+    if (file != nullptr)m_strReplayFile = file;
+
+    const char* report = pTag->Attribute("report");
+    if (report != nullptr)m_strReplayReport = report;
+
+    m_bQuitAfterReplay = pTag->BoolAttribute("quit", m_bQuitAfterReplay);
+} //LoadReplaySettings
+
+/// Start recording or playing back, depending on the replay mode, and seed
+/// the random number service. A new recording, or a game that isn't being
+/// recorded, gets a random number seed from the clock, and a playback gets
+/// the seed and the simulation and AI settings from the recording. A headless
+/// run that isn't playing back uses the seed that it was given. All gameplay
+/// randomness comes from the random number service, so the same seed and the
+/// same input give the same game. For the same reason the frame budget
+/// manager runs every task on the frame it was posted when recording or
+/// playing back, instead of deferring tasks depending on how long the frame
+/// took.
+
+void CGame::StartReplay()
+{
+    SReplayHeader h;
+    bool bStarted = false; //recording or playing back
+
+    if (m_bHeadless)h.m_nSeed = m_nSeed; //seed given
+    else h.m_nSeed = (uint32_t)std::chrono::steady_clock::now().time_since_epoch().count();
+
+    if (m_eReplayMode == eReplayMode::Record)
+    {
+        h.m_fSimStep = m_fSimStep;
+        h.m_nMaxSimSteps = m_nMaxSimSteps;
+        h.m_nThinkInterval = m_pObjectManager->GetThinkInterval();
+        h.m_nThinkLOD = m_pObjectManager->GetThinkLOD() ? 1 : 0;
+        h.m_fThinkNear = m_pObjectManager->GetThinkNear();
+        h.m_nMaxThinkInterval = m_pObjectManager->GetMaxThinkInterval();
+        h.m_nSeparation = m_pObjectManager->GetSeparation() ? 1 : 0;
+        h.m_fSeparation = m_pObjectManager->GetSeparationDistance();
+        h.m_fAvoidTime = m_pObjectManager->GetAvoidTime();
+        bStarted = m_pReplay->Record(m_strReplayFile.c_str(), h);
+    } //if
+
+    else if (m_eReplayMode == eReplayMode::Play)
+    {
+        bStarted = m_pReplay->Play(m_strReplayFile.c_str(), h);
+
+        if (bStarted)
+        {
+            m_fSimStep = h.m_fSimStep; //simulate as recorded
+            m_nMaxSimSteps = h.m_nMaxSimSteps;
+            m_pScheduler->SetStep(eSubsystem::Physics, m_fSimStep, m_nMaxSimSteps);
+
+            m_pObjectManager->SetThinkInterval(h.m_nThinkInterval); //think as recorded
+            m_pObjectManager->SetThinkLOD(h.m_nThinkLOD != 0, h.m_fThinkNear, h.m_nMaxThinkInterval);
+            m_pObjectManager->SetSeparation(h.m_nSeparation != 0, h.m_fSeparation, h.m_fAvoidTime);
+        } //if
+    } //else if
+
+    m_pRng->Seed(h.m_nSeed);
+
+    if (bStarted || m_bHeadless)
+    {
+        m_pRenderThread->ResetStats(); //measure the replay only
+        m_pScheduler->ResetStats();
+        m_pFrameBudget->SetEnabled(false); //don't depend on the wall clock
+    } //if
+} //StartReplay
+
+/// Append a line describing the playback that just finished to the report
+/// file, with the render statistics, then stop playing back. After that the
+/// game either quits or carries on with live input.
+
+void CGame::EndPlayback()
+{
+    const SRenderStats r = m_pRenderThread->GetStats(); //render statistics
+
+    FILE* output = nullptr; //report file handle
+    fopen_s(&output, m_strReplayReport.c_str(), "a");
+
+    if (output != nullptr)
+    {
+        fprintf(output, "%s, %s: draw %.3f ms, latency %.3f ms, %.1f fps\n",
+            m_pReplay->GetSummary().c_str(), r.m_bThreaded ? "threaded" : "serial",
+            r.m_fRenderTime, r.m_fLatency, r.m_fFrameRate);
+        fclose(output);
+    } //if
+
+    m_pReplay->Stop();
+
+    if (m_bQuitAfterReplay)
+        PostQuitMessage(0); //all done
+} //EndPlayback
+
+/// Read this frame's input, either from the replay file or from the keyboard
+/// and controller. When the replay file runs out, playback ends and the
+/// input comes from the keyboard and controller from then on. When headless
+/// there is no keyboard or controller, so each frame is one simulation step
+/// with nothing pressed.
+
+void CGame::ReadInput()
+{
+    if (m_pReplay->IsPlaying())
+    {
+        SInputFrame f; //recorded input
+        
+        if (m_pReplay->ReadFrame(f))
+        {
+            m_pInput->SetFrame(f);
+            return;
+        } //if
+
+        EndPlayback(); //out of frames
+    } //if
+
+    if (m_bHeadless)
+    {
+        SInputFrame f; //nothing pressed
+        f.m_fFrameTime = m_fSimStep;
+        m_pInput->SetFrame(f);
+    } //if
+
+    else m_pInput->Poll();
+} //ReadInput
+
+/// Load the specific images needed for this game. This is where `eSprite`
+/// values from `GameDefines.h` get tied to the names of sprite tags in
+/// `gamesettings.xml`. Those sprite tags contain the name of the corresponding
+/// image file. If the image tag or the image file are missing, then the game
+/// should abort from deeper in the Engine code leaving you with an error
+/// message in a dialog box.
+
+void CGame::LoadImages()
+{
+    m_pRenderer->BeginResourceUpload();
+
+    for (const auto& p : g_vecImages)
+        m_pRenderer->Load(p.first, p.second);
+
+    m_pRenderer->EndResourceUpload();
+} //LoadImages
+
+/// Initialize the audio player and load game sounds.
+
+void CGame::LoadSounds()
+{
+    m_pAudio->Initialize(eSound::Size);
+
+    m_pAudio->Load(eSound::Grunt, "grunt");
+    m_pAudio->Load(eSound::Clang, "clang");
+    m_pAudio->Load(eSound::Gun, "gun");
+    m_pAudio->Load(eSound::Ricochet, "ricochet");
+    m_pAudio->Load(eSound::Start, "start");
+    m_pAudio->Load(eSound::Boom, "boom");
+    m_pAudio->Load(eSound::Ow, "ow");
+    m_pAudio->Load(eSound::FeroLoop, "feroLoop");
+    m_pAudio->Load(eSound::FeroLoop, "feroLoop");
+    m_pAudio->Load(eSound::SlowMoStart, "slowMoStart");
+    m_pAudio->Load(eSound::SlowMoEnd, "slowMoEnd");
+
+    //Load Garrett's Sounds
+    //Gun Sounds
+    m_pAudio->Load(eSound::Pistolclick, "9MMclick");       //
+    m_pAudio->Load(eSound::Pistolreload, "9MMreload");  //
+    m_pAudio->Load(eSound::AKreload, "AKreload");   //
+    m_pAudio->Load(eSound::AKrack, "AKrack");
+    m_pAudio->Load(eSound::AKclick, "AKclick");   //
+    m_pAudio->Load(eSound::bulletload, "bulletload");   //
+    //Guitar Sounds
+    m_pAudio->Load(eSound::Bend1, "Bend1"); //
+    m_pAudio->Load(eSound::Bend2, "Bend2");
+    m_pAudio->Load(eSound::Bend3, "Bend3"); //
+    m_pAudio->Load(eSound::Chug1, "Chug1"); //
+    m_pAudio->Load(eSound::Chug2, "Chug2"); //
+    m_pAudio->Load(eSound::PowerChord1, "PowerChord1"); //
+    m_pAudio->Load(eSound::PowerChord2, "PowerChord2"); //
+    m_pAudio->Load(eSound::PowerChord3, "PowerChord3"); //
+    m_pAudio->Load(eSound::PowerChord4, "PowerChord4");
+    m_pAudio->Load(eSound::Slide1, "Slide1"); //
+    m_pAudio->Load(eSound::Octave1, "Octave1");  //
+    m_pAudio->Load(eSound::HappyChord1, "HappyChord1"); //
+} //LoadSounds
+
+/// Stop the render thread, then release all of the DirectX12 objects by
+/// deleting the renderer.
+
+void CGame::Release() {
+    delete m_pRenderThread; //draws anything outstanding first
+    m_pRenderThread = nullptr; //for safety
+
+    delete m_pRenderer;
+    m_pRenderer = nullptr; //for safety
+    //m_pBarDisplay->Release();
+} //Release
+
+/// Ask the object manager to create a player object and the other objects
+/// listed in the spawn manifest made by the tile manager when it loaded the map.
+
+void CGame::CreateObjects()
+{
+    m_pPlayer = m_pObjectManager->Instantiate(m_pTileManager->GetManifest());
+} //CreateObjects
+
+/// Load a randomly chosen variant of the map for the current level from its
+/// text file.
+
+void CGame::LoadLevel()
+{
+    if (m_pRng->Get(eRngStream::Level).Float() < 0.5f)
+    {
+        if (m_pRng->Get(eRngStream::Level).Float() < 0.5f)
+        {
+            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
+            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1a.txt"); break;
+            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2a.txt"); break;
+            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3a.txt"); break;
+            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4a.txt"); break;
+            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5a.txt"); break;
+            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6a.txt"); break;
+            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7a.txt"); break;
+            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8a.txt"); break;
+            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9a.txt"); break;
+            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
+            } //switch
+        }
+        else
+        {
+            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
+            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1c.txt"); break;
+            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2c.txt"); break;
+            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3c.txt"); break;
+            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4c.txt"); break;
+            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5c.txt"); break;
+            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6c.txt"); break;
+            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7c.txt"); break;
+            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8c.txt"); break;
+            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9c.txt"); break;
+            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
+            } //switch
+        }
+    }
+    else
+    {
+        if (m_pRng->Get(eRngStream::Level).Float() < 0.5f)
+        {
+            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
+            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1b.txt"); break;
+            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2b.txt"); break;
+            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3b.txt"); break;
+            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4b.txt"); break;
+            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5b.txt"); break;
+            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6b.txt"); break;
+            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7b.txt"); break;
+            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8b.txt"); break;
+            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9b.txt"); break;
+            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
+            } //switch
+        }
+        else
+        {
+            switch (m_nNextLevel) {                                                 //HERE is where levels are loaded!!
+            case 0: m_pTileManager->LoadMap("Media\\Maps\\map1d.txt"); break;
+            case 1: m_pTileManager->LoadMap("Media\\Maps\\map2d.txt"); break;
+            case 2: m_pTileManager->LoadMap("Media\\Maps\\map3d.txt"); break;
+            case 3: m_pTileManager->LoadMap("Media\\Maps\\map4d.txt"); break;
+            case 4: m_pTileManager->LoadMap("Media\\Maps\\map5d.txt"); break;
+            case 5: m_pTileManager->LoadMap("Media\\Maps\\map6d.txt"); break;
+            case 6: m_pTileManager->LoadMap("Media\\Maps\\map7d.txt"); break;
+            case 7: m_pTileManager->LoadMap("Media\\Maps\\map8d.txt"); break;
+            case 8: m_pTileManager->LoadMap("Media\\Maps\\map9d.txt"); break;
+            case 9: m_pTileManager->LoadMap("Media\\Maps\\boss.txt"); break;
+            } //switch
+        }
+    }
+
+    //### Uncomment whichever level you want to test, and comment out the above switch case ###
+    //m_pTileManager->LoadMap("Media\\Maps\\map1.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map2.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map3.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map4.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map5.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map6.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map7.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map8.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\map9.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\boss.txt");
+    //m_pTileManager->LoadMap("Media\\Maps\\TEST.txt");
+    //###                                                                                   ###
+} //LoadLevel
+
+/// Take a snapshot of the level that was just loaded: the tile map, walls
+/// and spawn manifest, and the player's stats at the start of the level.
+
+void CGame::SaveLevel()
+{
+    SLevelSnapshot& s = m_sLevel; //shorthand
+
+    s.m_nLevel = m_nNextLevel;
+    s.m_nDifficulty = m_pObjectManager->m_nDifficultyModifier;
+    m_pTileManager->Save(s.m_sTiles);
+
+    s.m_nMaxHealthS = m_nMaxHealthS;
+    s.m_nHealthS = m_nHealthS;
+    s.m_nMaxFocusS = m_nMaxFocusS;
+    s.m_nFocusS = m_nFocusS;
+    s.m_nMaxStaminaS = m_nMaxStaminaS;
+    s.m_nStaminaS = m_nStaminaS;
+    s.m_fMovementSpeedS = m_fMovementSpeedS;
+    s.m_fMovementSpeedModifierS = m_fMovementSpeedModifierS;
+    s.m_nDamageUpgradesS = m_nDamageUpgradesS;
+    s.m_nWeaponSelectorS = m_nWeaponSelectorS;
+
+    s.m_bValid = true;
+} //SaveLevel
+
+/// Restore the level from the snapshot taken when it was loaded. The objects
+/// are created from the restored spawn manifest afterwards, as they would be
+/// after loading. The player's stats are only restored when restarting,
+/// since when the player dies they have just been reset on purpose.
+/// \param bStats true to restore the player's stats.
+
+void CGame::RestoreLevel(bool bStats)
+{
+    const SLevelSnapshot& s = m_sLevel; //shorthand
+
+    m_pTileManager->Restore(s.m_sTiles);
+
+    if (bStats)
+    {
+        m_nMaxHealthS = s.m_nMaxHealthS;
+        m_nHealthS = s.m_nHealthS;
+        m_nMaxFocusS = s.m_nMaxFocusS;
+        m_nFocusS = s.m_nFocusS;
+        m_nMaxStaminaS = s.m_nMaxStaminaS;
+        m_nStaminaS = s.m_nStaminaS;
+        m_fMovementSpeedS = s.m_fMovementSpeedS;
+        m_fMovementSpeedModifierS = s.m_fMovementSpeedModifierS;
+        m_nDamageUpgradesS = s.m_nDamageUpgradesS;
+        m_nWeaponSelectorS = s.m_nWeaponSelectorS;
+    } //if
+} //RestoreLevel
+
+/// Call this function to start a new game. This should be re-entrant so that
+/// you can restart a new game without having to shut down and restart the
+/// program. Clear the particle system to get rid of any existing particles,
+/// delete any old objects out of the object manager and create some new ones.
+/// The map and the particle system are read when drawing, so wait for the
+/// render thread to finish with them first. If the level and difficulty are
+/// the same as last time then the level is restored from the snapshot taken
+/// when it was loaded, otherwise it is loaded and a new snapshot is taken.
+/// Either way the path hierarchy is built for it.
+/// The time from here to the end of the first frame is measured.
+/// \param bRestart true to also restore the player's stats from the snapshot.
+
+void CGame::BeginGame(bool bRestart)
+{
+    m_tRestart = std::chrono::steady_clock::now(); //for timing the restart
+    m_bRestartPending = true;
+
+    m_pRenderThread->Flush(); //nothing is being drawn after this
+    m_pFrameBudget->Clear(); //nothing left over from the last level
+    m_bDebugHudPending = false; //just thrown away
+    m_pRenderThread->GetBackBuffer().m_vecParticles.clear(); //particles not yet created
+    if (m_pParticleSystem)m_pParticleSystem->clear(); //clear old particles
+
+    m_bRestored = m_sLevel.m_bValid && m_sLevel.m_nLevel == m_nNextLevel &&
+        m_sLevel.m_nDifficulty == m_pObjectManager->m_nDifficultyModifier; //same level again
+
+    if (m_bRestored)RestoreLevel(bRestart); //from snapshot
+    else LoadLevel(); //from map file
+
+    m_pPathHierarchy->Update(); //for the new map
+
+    m_pObjectManager->clear(); //clear old objects
+    CreateObjects(); //create new objects (must be after map is loaded)
+
+    //Update the player's stat values after the player object has been created
+    m_pPlayer->m_nMaxHealth = m_nMaxHealthS;
+    m_pPlayer->m_nMaxFocus = m_nMaxFocusS;
+    m_pPlayer->m_nMaxStamina = m_nMaxStaminaS;
+    m_pPlayer->m_fMovementSpeed = m_fMovementSpeedS;
+    m_pPlayer->m_fMovementSpeedModifier = m_fMovementSpeedModifierS;
+    m_pPlayer->m_nDamageUpgrades = m_nDamageUpgradesS;
+    m_pPlayer->m_nHealth = m_nHealthS;
+    m_pPlayer->m_nFocus = m_nFocusS;
+    m_pPlayer->m_nStamina = m_nStaminaS;
+    m_pPlayer->m_nWeaponSelector = m_nWeaponSelectorS;
+
+    if (!m_bRestored)SaveLevel(); //snapshot of the new level
+
+    //m_pAudio->stop(); //stop all  currently playing sounds
+    m_pAudio->play(eSound::Chug1); //play start-of-game sound
+    m_eGameState = eGameState::Playing; //now playing
+} //BeginGame
+
+/// Respond to the key presses in this frame's input, which is either the
+/// keyboard state or a recording of it.
+
+void CGame::KeyboardHandler()
+{
+    float first_push = 0, second_push = 0;     //time float for double pressing keys (used for dashing)
+
+    if (m_pInput->TriggerDown(VK_F1)) //help
+        ShellExecute(0, 0, "https://larc.unt.edu/code/topdown/", 0, 0, SW_SHOW);
+
+    if (m_pInput->TriggerDown(VK_F2)) //toggle frame rate
+        m_bDrawFrameRate = !m_bDrawFrameRate;
+
+    if (m_pInput->TriggerDown(VK_F3)) //toggle AABB drawing
+        m_bDrawAABBs = !m_bDrawAABBs;
+
+    if (m_pInput->TriggerDown(VK_F4)) //toggle job timings
+        m_bDrawJobTimes = !m_bDrawJobTimes;
+
+    if (m_pInput->TriggerDown(VK_F5)) //toggle render thread
+        m_pRenderThread->SetThreaded(!m_pRenderThread->IsThreaded());
+
+    if (m_pInput->TriggerDown(VK_F6)) //toggle AI level of detail
+        m_pObjectManager->SetThinkLOD(!m_pObjectManager->GetThinkLOD());
+
+    if (m_pInput->TriggerDown(VK_BACK)) //restart level
+        BeginGame(true);
+
+    if (m_pPlayer) 
+    { //safety
+
+        if (m_pInput->TriggerDown(VK_UP)) //move forwards
+            m_pPlayer->SetSpeed(100.0f);
+
+        if (m_pInput->TriggerUp(VK_UP)) //stop
+            m_pPlayer->SetSpeed(0.0f);
+
+        //sprint: makes player move quickly towards where they are facing
+        if (m_pInput->TriggerDown(VK_LSHIFT)) 
+        {
+            if (m_pPlayer->m_nStamina > 0)     //if stamina is not empty
+            {
+                m_pPlayer->m_fTimeLastDash = m_fSimTime;
+                m_pPlayer->m_bIsDashing = true;
+                m_pPlayer->m_nStamina--;    //immediately lower stamina on press, to prevent sprint spamming
+            }
+            else
+            {
+                m_pPlayer->SetSpeed(0.0f);
+            }
+        }
+
+        //stop sprinting
+        if (m_pInput->TriggerUp(VK_LSHIFT)) 
+        {
+            m_pPlayer->SetSpeed(0.0f);
+            m_pPlayer->m_bIsDashing = false;
+        }
+
+        if (m_pInput->TriggerDown(VK_RIGHT)) //rotate clockwise
+            m_pPlayer->SetRotSpeed(-2.5f);
+
+        if (m_pInput->TriggerUp(VK_RIGHT)) //stop rotating clockwise
+            m_pPlayer->SetRotSpeed(0.0f);
+
+        if (m_pInput->TriggerDown(VK_LEFT)) //rotate counterclockwise
+            m_pPlayer->SetRotSpeed(2.5f);
+
+        if (m_pInput->TriggerUp(VK_LEFT)) //stop rotating counterclockwise
+            m_pPlayer->SetRotSpeed(0.0f);
+
+        if (m_pInput->TriggerDown(VK_SPACE)) //fire gun
+        {
+            switch (m_pPlayer->m_nWeaponSelector)
+            {
+                case 0:
+                    if ((m_pPlayer->m_nRevolverMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
+                    {
+                        m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
+                        m_pPlayer->m_nRevolverMag -= 1; // remove 1 bullet from the magazine
+                    }
+                    else
+                    {
+                        m_pAudio->play(eSound::Pistolclick);
+                    }
+                    break;
+                case 1:  
+                    if ((m_pPlayer->m_nPistolMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
+                    {
+                        m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
+                        m_pPlayer->m_nPistolMag -= 1; // remove 1 bullet from the magazine
+                    }
+                    else
+                    {
+                        m_pAudio->play(eSound::Pistolclick);
+                    }
+                    break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
+                case 2:  
+                    if ((m_pPlayer->m_nShotgunMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
+                    {
+                        for (int i = 0; i < m_pPlayer->m_nShotgunPellets; i++)  //fire a bullet for whatever the damage modifier would be instead of actually increasing the damage
+                        {
+                            m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
+                        }
+
+                        m_pPlayer->m_nShotgunMag -= 1; // remove 1 bullet from the magazine
+                    }
+                    else
+                    {
+                        m_pAudio->play(eSound::AKclick);
+                    }
+                    break;
+                case 3:  break;
+                case 4:  break;
+            }
+
+        }
+
+
+        if (m_pInput->Down('A'))     //strafe right
+        {
+            m_pPlayer->StrafeRight();   //set strafe right true in CPlayer::move()
+        }
+
+        if (m_pInput->Down('D'))     //strafe left
+        {
+            m_pPlayer->StrafeLeft();
+        }
+        if (m_pInput->Down('W'))  //strafe forward
+        {
+            m_pPlayer->StrafeForward();
+        }
+
+        if (m_pInput->Down('S')) //strafe backward
+        {
+            m_pPlayer->StrafeBackward();
+        }
+
+        if (m_pInput->TriggerDown('F')) //toggle focus mode
+        {
+            if (m_pPlayer->m_bIsFocusing == false)   //if not focusing, start focusing
+            {
+                m_pPlayer->m_fTimeLastFocus = m_fSimTime;  //get the time for when the player started focusing
+                m_pPlayer->m_bIsFocusing = true;
+                m_pAudio->play(eSound::SlowMoStart); //technically could break if past focus time? Is there a way to make this louder?
+            }
+            else if (m_pPlayer->m_bIsFocusing == true)
+            {
+                m_pPlayer->m_fTimeLastFocus = 0;    //reset player focus for safety
+                m_pPlayer->m_bIsFocusing = false;
+                m_pAudio->play(eSound::SlowMoEnd); //Technically could break if past focus time? Is there a way to make this louder?
+            }
+        }
+
+        if (m_pInput->TriggerDown('R')) // Reload Currently Equiped Gun
+        {
+            switch (m_pPlayer->m_nWeaponSelector)
+            {
+                case 0: //The magnum is a revolver, so its ammo must be individually loaded (MASH THAT 'R' KEY!!!!)
+                    if (m_pPlayer->m_nRevolverMag < m_pPlayer->m_nRevolverFullMag)  //if gun is not full
+                    {
+                        m_pAudio->play(eSound::bulletload);
+                        m_pPlayer->m_fTimeLastReload = m_fSimTime; //get reload time
+                        m_pPlayer->m_bIsReloading = true;  //set reloading to true
+                        m_pPlayer->m_nRevolverMag += 1; // add 1 bullet to the magazine
+                    }
+                    break;
+                case 1: //The pistol has a magazine, so it must take some time to reload, but it does every round all at once!
+                    if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nPistolMag != m_pPlayer->m_nPistolFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
+                    {
+                        m_pAudio->play(eSound::Pistolreload);
+                        m_pPlayer->m_fTimeLastReload = m_fSimTime; //get reload time
+                        m_pPlayer->m_bIsReloading = true;  //set reloading to true
+                    }
+                    break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
+                case 2: //The shotgun has a magazine, so it must take some time to reload, but it does every round all at once!
+                    if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nShotgunMag != m_pPlayer->m_nShotgunFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
+                    {
+                        m_pAudio->play(eSound::AKreload);
+                        m_pPlayer->m_fTimeLastReload = m_fSimTime; //get reload time
+                        m_pPlayer->m_bIsReloading = true;  //set reloading to true
+                    }
+                    break;
+                case 3:  break;
+                case 4:  break;
+            }
+        }
+
+        if (m_pInput->TriggerDown('1')) // Switch to Revolver
+        {
+            m_pAudio->play(eSound::AKrack);
+            m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
+            m_pPlayer->m_nWeaponSelector = 0;
+            m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
+        }
+
+        if (m_pInput->TriggerDown('2')) // Switch to Pistol
+        {
+            m_pAudio->play(eSound::AKrack);
+            m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
+            m_pPlayer->m_nWeaponSelector = 1;
+            m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
+        }
+
+        if (m_pInput->TriggerDown('3')) // Switch to Shotgun
+        {
+            m_pAudio->play(eSound::AKrack);
+            m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
+            m_pPlayer->m_nWeaponSelector = 2;
+            m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
+        }
+
+        if (m_pInput->TriggerDown('4')) // Switch to ______
+        {
+            //m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
+            //m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
+            //m_pPlayer->m_nWeaponSelector = 3;
+        }
+
+        if (m_pInput->TriggerDown('5')) // Switch to ______
+        {
+            //m_pPlayer->UpdatePlayerDamage();    //switched weapon, update damage
+            //m_pPlayer->m_bIsReloading = false;  //cancel reloading if changing to a new gun
+            //m_pPlayer->m_nWeaponSelector = 4;
+        }
+
+        if (m_pInput->TriggerDown('G')) //toggle god mode
+            m_bGodMode = !m_bGodMode;
+    } //if
+} //KeyboardHandler
+
+/// Respond to the XBox controller controls in this frame's input, which is
+/// either the controller state or a recording of it.
+
+void CGame::ControllerHandler()
+{
+    if (!m_pInput->IsConnected())return;
+
+    if (m_pPlayer) { //safety
+        m_pPlayer->SetSpeed(100 * m_pInput->GetRTrigger());
+        m_pPlayer->Aim(m_pInput->GetRThumb());
+
+        if (m_pInput->GetButtonRSToggle()) //fire gun
+        {
+            switch (m_pPlayer->m_nWeaponSelector)
+            {
+            case 0:
+                if ((m_pPlayer->m_nRevolverMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
+                {
+                    m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
+                    m_pPlayer->m_nRevolverMag -= 1; // remove 1 bullet from the magazine
+                }
+                else
+                {
+                    m_pAudio->play(eSound::Pistolclick);
+                }
+                break;
+            case 1:
+                if ((m_pPlayer->m_nPistolMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
+                {
+                    m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
+                    m_pPlayer->m_nPistolMag -= 1; // remove 1 bullet from the magazine
+                }
+                else
+                {
+                    m_pAudio->play(eSound::Pistolclick);
+                }
+                break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
+            case 2:
+                if ((m_pPlayer->m_nShotgunMag > 0) && (m_pPlayer->m_bIsReloading == false))  //if gun is not empty
+                {
+                    for (int i = 0; i < m_pPlayer->m_nShotgunPellets; i++)  //fire a bullet for whatever the damage modifier would be instead of actually increasing the damage
+                    {
+                        m_pObjectManager->FireGun(m_pPlayer, eSprite::Bullet);  // fire the gun
+                    }
+
+                    m_pPlayer->m_nShotgunMag -= 1; // remove 1 bullet from the magazine
+                }
+                else
+                {
+                    m_pAudio->play(eSound::AKclick);
+                }
+                break;
+            case 3:  break;
+            case 4:  break;
+            }
+
+        }
+        
+        //Reload
+        if (m_pInput->GetButtonXToggle())
+        {
+            switch (m_pPlayer->m_nWeaponSelector)
+            {
+            case 0: //The magnum is a revolver, so its ammo must be individually loaded (MASH THAT 'R' KEY!!!!)
+                if (m_pPlayer->m_nRevolverMag < m_pPlayer->m_nRevolverFullMag)  //if gun is not full
+                {
+                    m_pAudio->play(eSound::bulletload);
+                    m_pPlayer->m_fTimeLastReload = m_fSimTime; //get reload time
+                    m_pPlayer->m_bIsReloading = true;  //set reloading to true
+                    m_pPlayer->m_nRevolverMag += 1; // add 1 bullet to the magazine
+                }
+                break;
+            case 1: //The pistol has a magazine, so it must take some time to reload, but it does every round all at once!
+                if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nPistolMag != m_pPlayer->m_nPistolFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
+                {
+                    m_pAudio->play(eSound::Pistolreload);
+                    m_pPlayer->m_fTimeLastReload = m_fSimTime; //get reload time
+                    m_pPlayer->m_bIsReloading = true;  //set reloading to true
+                }
+                break;   //pistol is a magazine based reload, so set 'm_bIsReloading' to true
+            case 2: //The shotgun has a magazine, so it must take some time to reload, but it does every round all at once!
+                if (m_pPlayer->m_bIsReloading != true && (m_pPlayer->m_nShotgunMag != m_pPlayer->m_nShotgunFullMag))  //if the player is already reloading don't reset the timer, and dont reload if the mag is already full
+                {
+                    m_pAudio->play(eSound::AKreload);
+                    m_pPlayer->m_fTimeLastReload = m_fSimTime; //get reload time
+                    m_pPlayer->m_bIsReloading = true;  //set reloading to true
+                }
+                break;
+            case 3:  break;
+            case 4:  break;
+            }
+        }
+
+        //Start sprinting if you have stamina
+        if (m_pInput->GetLTrigger() == 1)
+        {
+            if (m_pPlayer->m_nStamina > 0) {    //if stamina is not empty
+
+                m_pPlayer->m_bIsDashing = true;
+            }
+            else
+            {
+                m_pPlayer->SetSpeed(0.0f);
+            }
+        }
+
+        //Stop sprinting
+        if (m_pInput->GetLTrigger() == 0)
+        {
+            m_pPlayer->SetSpeed(0.0f);
+            m_pPlayer->m_bIsDashing = false;
+        }
+
+        //Toggle focus
+        if (m_pInput->GetButtonYToggle())
+        {
+            if (m_pPlayer->m_bIsFocusing == false)   //if not focusing, start focusing
+            {
+                m_pPlayer->m_fTimeLastFocus = m_fSimTime;  //get the time for when the player started focusing
+                m_pPlayer->m_bIsFocusing = true;
+                m_pAudio->play(eSound::SlowMoStart); //technically could break if past focus time? Is there a way to make this louder?
+            }
+            else if (m_pPlayer->m_bIsFocusing == true)
+            {
+                m_pPlayer->m_fTimeLastFocus = 0;    //reset player focus for safety
+                m_pPlayer->m_bIsFocusing = false;
+                m_pAudio->play(eSound::SlowMoEnd); //Technically could break if past focus time? Is there a way to make this louder?
+            }
+        }
+
+        //Change weapon up.
+        if (m_pInput->GetButtonBToggle())
+        {
+            m_pAudio->play(eSound::AKrack);
+            m_pPlayer->m_nWeaponSelector++;
+
+            if (m_pPlayer->m_nWeaponSelector > 2)
+            {
+                m_pPlayer->m_nWeaponSelector = 0;
+            }
+        }
+
+        //Change weapon down.
+        if (m_pInput->GetButtonAToggle())
+        {
+            m_pAudio->play(eSound::AKrack);
+            m_pPlayer->m_nWeaponSelector--;
+
+            if (m_pPlayer->m_nWeaponSelector < 0)
+            {
+                m_pPlayer->m_nWeaponSelector = 2;
+            }
+        }
+
+        if (m_pInput->GetDPadRight()) //strafe right
+            m_pPlayer->StrafeLeft();
+
+        if (m_pInput->GetDPadLeft()) //strafe left
+            m_pPlayer->StrafeRight();
+
+        if (m_pInput->GetDPadDown()) //strafe back
+            m_pPlayer->StrafeBackward();
+
+        if (m_pInput->GetDPadUp()) //strafe back
+            m_pPlayer->StrafeForward();
+    } //if
+} //ControllerHandler
+
+/// Draw the current frame rate to a hard-coded position in the window,
+/// followed by the render statistics for the current render mode.
+/// The text will be drawn in a hard-coded position using the font
+/// specified in `gamesettings.xml`.
+/// \param hud Debug HUD state.
+
+void CGame::DrawFrameRateText(const SDebugHud& hud)
+{
+    const std::string s = std::to_string(hud.m_nFPS) + " fps"; //frame rate
+    const Vector2 pos(m_nWinWidth - 128.0f, 30.0f); //hard-coded position
+    m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
+
+    const SRenderStats& r = hud.m_stats; //shorthand
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "%s: draw %.2f ms, latency %.2f ms, %.0f fps",
+        r.m_bThreaded ? "threaded" : "serial", r.m_fRenderTime, r.m_fLatency, r.m_fFrameRate);
+    m_pRenderer->DrawScreenText(buffer, Vector2(m_nWinWidth - 680.0f, 30.0f)); //draw to screen
+
+    snprintf(buffer, sizeof(buffer), "level start: %.2f ms (%s), AI LOD %s", hud.m_fRestartTime,
+        hud.m_bRestored ? "snapshot" : "loaded", hud.m_bThinkLOD ? "on" : "off");
+    m_pRenderer->DrawScreenText(buffer, Vector2(m_nWinWidth - 680.0f, 60.0f)); //draw to screen
+
+    const SBudgetStats& b = hud.m_sBudget; //shorthand
+    snprintf(buffer, sizeof(buffer), "budget %.1f ms: %u run, %u deferred, %u overruns",
+        hud.m_fBudget, b.m_nRun, b.m_nDeferred, b.m_nOverruns);
+    m_pRenderer->DrawScreenText(buffer, Vector2(m_nWinWidth - 680.0f, 90.0f)); //draw to screen
+} //DrawFrameRateText
+
+/// Draw last frame's job timings to a hard-coded position in the window, one
+/// line per job with the thread it ran on, followed by the critical path.
+/// Jobs on the critical path are drawn in red. After that comes a line per
+/// subsystem with its update rate and how often it was skipped.
+/// \param hud Debug HUD state.
+
+void CGame::DrawJobTimesText(const SDebugHud& hud)
+{
+    Vector2 pos(m_nWinWidth - 480.0f, 120.0f); //hard-coded position, below frame rate text
+    char buffer[128];
+
+    for (const SJobTiming& t : hud.m_vecJobTimings) {
+        snprintf(buffer, sizeof(buffer), "%s [%u] %.2f-%.2f ms", t.m_strName, t.m_nThread,
+            t.m_fStart, t.m_fEnd);
+        m_pRenderer->DrawScreenText(buffer, pos, t.m_bCritical ? Colors::Red : Colors::White);
+        pos.y += 30.0f; //next line
+    } //for
+
+    const std::string s = CJobSystem::FormatCriticalPath(hud.m_vecJobTimings,
+        hud.m_fCriticalPath); //critical path
+    m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
+
+    for (UINT i = 0; i < (UINT)eSubsystem::Size; i++) { //update rates
+        const SSubsystem& r = hud.m_sSubsystem[i]; //shorthand
+        const UINT nIdle = r.m_nFrames > 0 ? 100*r.m_nIdleFrames/r.m_nFrames : 0; //percent
+
+        if ((eSubsystem)i == eSubsystem::AI) //runs on physics steps
+            snprintf(buffer, sizeof(buffer), "%s: %.0f%% of thinks skipped", r.m_strName,
+                100.0f*(1.0f - hud.m_fThinkFraction));
+        else if (r.m_fStep > 0)
+            snprintf(buffer, sizeof(buffer), "%s %.0f Hz: %u updates, %u%% frames idle",
+                r.m_strName, 1.0f/r.m_fStep, r.m_nTicks, nIdle);
+        else snprintf(buffer, sizeof(buffer), "%s: every frame", r.m_strName);
+
+        pos.y += 30.0f; //next line
+        m_pRenderer->DrawScreenText(buffer, pos);
+    } //for
+} //DrawJobTimesText
+
+/// Draw the god mode text to a hard-coded position in the window using the
+/// font specified in `gamesettings.xml`.
+
+void CGame::DrawGodModeText()
+{
+    const Vector2 pos(64.0f, 270.0f); //hard-coded position
+    m_pRenderer->DrawScreenText("God Mode", pos); //draw to screen
+} //DrawGodModeText
+
+void CGame::DrawFocusModeText()
+{
+    const Vector2 pos(64.0f, 210.0f); //hard-coded position
+    m_pRenderer->DrawScreenText("Focusing!!!", pos); //draw to screen
+} //DrawFocusModeText 
+
+void CGame::DrawPlayerComboText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 180.0f); //hard-coded position
+    std::string combo_text = "COMBO: " + std::to_string(hud.m_nCombo); //string for players combo
+    m_pRenderer->DrawScreenText(combo_text.c_str(), pos, Colors::Black); //draw player's combo to screen
+} //DrawPlayerComboText
+
+void CGame::DrawPlayerDamageText(const SHudState& hud)       //draw player's damage (this is mostly for testing and may be removed later)
+{
+    const Vector2 pos(64.0f, 150.0f); //hard-coded position
+    std::string damage_text = "DAMAGE: " + std::to_string(hud.m_nPlayerDamage); //string for players damage
+    m_pRenderer->DrawScreenText(damage_text.c_str(), pos, Colors::Black); //draw player's damage to screen
+} //DrawPlayerDamageText
+
+void CGame::DrawReloadingText()
+{
+    const Vector2 pos(64.0f, 240.0f); //hard-coded position
+    m_pRenderer->DrawScreenText("Reloading...", pos); //draw to screen
+} //DrawReloadingText 
+
+void CGame::DrawRevolverAmmoText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 300.0f); //hard-coded position
+    std::string gun_text = "Magnum: " + std::to_string(hud.m_nRevolverMag) + "/" + std::to_string(hud.m_nRevolverFullMag); //string for players gun ammo
+    m_pRenderer->DrawScreenText(gun_text.c_str(), pos, Colors::Black); //draw player's damage to screen
+}//DrawRevolverAmmo
+
+void CGame::DrawPistolAmmoText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 300.0f); //hard-coded position
+    std::string gun_text = "Pistol: " + std::to_string(hud.m_nPistolMag) + "/" + std::to_string(hud.m_nPistolFullMag); //string for players damage
+    m_pRenderer->DrawScreenText(gun_text.c_str(), pos, Colors::Black); //draw player's damage to screen
+}//DrawPistolAmmoText
+
+void CGame::DrawShotgunAmmoText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 300.0f); //hard-coded position
+    std::string gun_text = "Shotgun: " + std::to_string(hud.m_nShotgunMag) + "/" + std::to_string(hud.m_nShotgunFullMag); //string for players damage
+    m_pRenderer->DrawScreenText(gun_text.c_str(), pos, Colors::Black); //draw player's damage to screen
+}//DrawShotgunAmmoText
+
+void CGame::DrawBarDisplay(eSprite sprite, int p, int i, Vector2 pos)
+{
+    //only called if the player is alive
+    //std::string hp_text = "Heath: " + std::to_string(m_pPlayer->m_nHealth) + "/" + std::to_string(m_pPlayer->m_nMaxHealth); //string for players health
+    //m_pRenderer->DrawBoxFilled(64, m_nWinHeight - 50, 100, 100, Vector4(0.0, 0.0, 0.0, 255.0)); //This does not work and I do not know why
+    LSpriteDesc2D desc;
+    desc.m_nCurrentFrame = p;
+    desc.m_nSpriteIndex = (UINT)sprite; //sprite index forsprite index for barSprite
+    desc.m_vPos.x = pos.x;
+    desc.m_vPos.y = pos.y;
+    int width = m_pRenderer->GetWidth(eSprite::Bar);
+
+    for (int j = 0; j <= i; j++)
+    {
+        m_pRenderer->Draw(&desc);
+        //m_pObjectManager->create(sprite, pos);
+        desc.m_vPos.x += width + 1.0;
+    }
+} //DrawPlayerHealthDisplay
+
+void CGame::DrawPlayerHealthText(const SHudState& hud)
+{
+
+    const Vector2 pos(64.0f, 30.0f); //hard-coded position
+    if (hud.m_bPlayerAlive)
+    { //if the player is alive
+        std::string hp_text = "Heath: " + std::to_string(hud.m_nHealth) + "/" + std::to_string(hud.m_nMaxHealth); //string for players health
+        m_pRenderer->DrawScreenText(hp_text.c_str(), pos, Colors::Red); //draw player's Heath to screen
+    }
+
+} //DrawPlayerHealthText 
+
+void CGame::DrawPlayerFocusText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 60.0f); //hard-coded position
+    if (hud.m_bPlayerAlive)
+    { //if the player is alive
+        std::string fp_text = "Focus: " + std::to_string(hud.m_nFocus) + "/" + std::to_string(hud.m_nMaxFocus); //string for players Focus
+        m_pRenderer->DrawScreenText(fp_text.c_str(), pos, Colors::Blue); //draw player's Focus to screen
+    }
+
+} //DrawPlayerFocusText 
+
+void CGame::DrawPlayerStaminaText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 90.0f); //hard-coded position
+    if (hud.m_bPlayerAlive)
+    { //if the player is alive
+        std::string sp_text = "Stamina: " + std::to_string(hud.m_nStamina) + "/" + std::to_string(hud.m_nMaxStamina); //string for players Stamina
+        m_pRenderer->DrawScreenText(sp_text.c_str(), pos, Colors::Green); //draw player's Stamina to screen
+    }
+
+} //DrawPlayerStaminaText 
+
+void CGame::DrawDifficultyText(const SHudState& hud)
+{
+    const Vector2 pos(64.0f, 120.0f); //hard-coded position
+    if (hud.m_bPlayerAlive)
+    { //if the player is alive
+        std::string sp_text = "Difficulty Mod: " + std::to_string(hud.m_nDifficulty); //string for players Stamina
+        m_pRenderer->DrawScreenText(sp_text.c_str(), pos, Colors::Black); //draw player's Stamina to screen
+    }
+
+}
+
+
+/// Work out how far the particles are to be stepped when a snapshot is drawn.
+/// If they are updated every frame then that is the frame time and they are
+/// drawn where they are. Otherwise it is the whole number of particle steps
+/// due this frame, which may be none, with the remainder of the frame time
+/// carried over to later frames. They are then drawn the leftover fraction
+/// of a step of the way from before their last step to where they are now,
+/// so that they move at the right speed and smoothly at any frame rate.
+/// \param s World snapshot.
+
+void CGame::StepParticles(SWorldSnapshot& s)
+{
+    const float t = m_pInput->GetFrameTime(); //frame time
+    const UINT n = m_pScheduler->Advance(eSubsystem::Particles, t); //steps due
+    const float fStep = m_pScheduler->Get(eSubsystem::Particles).m_fStep; //time per step
+
+    if (fStep > 0) //fixed steps
+    {
+        s.m_fParticleStep = n*fStep;
+        s.m_fParticleAlpha = m_pScheduler->GetAlpha(eSubsystem::Particles);
+    } //if
+
+    else //every frame
+    {
+        s.m_fParticleStep = t;
+        s.m_fParticleAlpha = 1.0f;
+    } //else
+} //StepParticles
+
+/// Fill in the back buffer of the render thread with everything needed to
+/// draw this frame except for the sprites, which are copied by a job of
+/// their own: the camera position, the particle step, and the HUD values,
+/// including the latest debug HUD values if they are shown. Nothing is
+/// drawn and no text is formatted here. Must be called on the main thread.
+/// \param tInput Time at which input was read for this frame.
+
+void CGame::TakeSnapshot(std::chrono::steady_clock::time_point tInput)
+{
+    SWorldSnapshot& s = m_pRenderThread->GetBackBuffer(); //shorthand
+    SHudState& hud = s.m_hud; //shorthand
+
+    s.m_tInput = tInput;
+    s.m_vCameraPos = m_vCameraPos;
+    StepParticles(s); //particle step and interpolation fraction
+
+    hud.m_bPlayerAlive = m_pPlayer != nullptr;
+
+    if (m_pPlayer != nullptr)
+    {
+        hud.m_nHealth = m_pPlayer->m_nHealth;
+        hud.m_nMaxHealth = m_pPlayer->m_nMaxHealth;
+        hud.m_nFocus = m_pPlayer->m_nFocus;
+        hud.m_nMaxFocus = m_pPlayer->m_nMaxFocus;
+        hud.m_nStamina = m_pPlayer->m_nStamina;
+        hud.m_nMaxStamina = m_pPlayer->m_nMaxStamina;
+        hud.m_nCombo = m_pPlayer->m_nCombo;
+        hud.m_nPlayerDamage = m_pPlayer->m_nPlayerDamage;
+        hud.m_nWeaponSelector = m_pPlayer->m_nWeaponSelector;
+        hud.m_nRevolverMag = m_pPlayer->m_nRevolverMag;
+        hud.m_nRevolverFullMag = m_pPlayer->m_nRevolverFullMag;
+        hud.m_nPistolMag = m_pPlayer->m_nPistolMag;
+        hud.m_nPistolFullMag = m_pPlayer->m_nPistolFullMag;
+        hud.m_nShotgunMag = m_pPlayer->m_nShotgunMag;
+        hud.m_nShotgunFullMag = m_pPlayer->m_nShotgunFullMag;
+        hud.m_bIsFocusing = m_pPlayer->m_bIsFocusing;
+        hud.m_bIsReloading = m_pPlayer->m_bIsReloading;
+    } //if
+
+    hud.m_nDifficulty = m_pObjectManager->m_nDifficultyModifier;
+
+    hud.m_bDrawFrameRate = m_bDrawFrameRate;
+    hud.m_bDrawJobTimes = m_bDrawJobTimes;
+    hud.m_bDrawAABBs = m_bDrawAABBs;
+    hud.m_bGodMode = m_bGodMode;
+
+    if (m_bDrawFrameRate || m_bDrawJobTimes)
+    {
+        hud.m_debug = m_sDebugHud; //latest, whether or not it was updated this frame
+
+        if (!m_bDebugHudPending)
+        {
+            m_bDebugHudPending = true;
+            m_pFrameBudget->Post(eTaskPriority::Low, [this]() { UpdateDebugHud(); });
+        } //if
+    } //if
+} //TakeSnapshot
+
+/// Gather the frame rate and job timings for the debug HUD. This is only for
+/// debugging, so it is done when there is time in the frame. The results are
+/// kept and copied into every snapshot from the next one on, so if there
+/// isn't time the HUD shows the last ones gathered.
+
+void CGame::UpdateDebugHud()
+{
+    SDebugHud& hud = m_sDebugHud; //shorthand
+    m_bDebugHudPending = false;
+
+    if (m_bDrawFrameRate)
+    {
+        hud.m_nFPS = m_pTimer->GetFPS();
+        hud.m_stats = m_pRenderThread->GetStats();
+        hud.m_fRestartTime = m_fRestartTime;
+        hud.m_bRestored = m_bRestored;
+        hud.m_bThinkLOD = m_pObjectManager->GetThinkLOD();
+        hud.m_sBudget = m_pFrameBudget->GetStats();
+        hud.m_fBudget = m_pFrameBudget->GetBudget();
+    } //if
+
+    if (m_bDrawJobTimes)
+    {
+        hud.m_vecJobTimings = m_pJobSystem->GetTimings();
+        hud.m_fCriticalPath = m_pJobSystem->GetCriticalPath();
+
+        for (UINT i = 0; i < (UINT)eSubsystem::Size; i++)
+            hud.m_sSubsystem[i] = m_pScheduler->Get((eSubsystem)i);
+
+        hud.m_fThinkFraction = m_pObjectManager->GetThinkFraction();
+    } //if
+} //UpdateDebugHud
+
+/// Draw a world snapshot. This may run on the render thread while the
+/// simulation is working on the next frame, so it must only read the
+/// snapshot and things that don't change during play, such as the tile map.
+/// The particle system is only used here, so the particles that were created
+/// since the last snapshot are created now, then the particles are moved by
+/// the snapshot's particle step, if they are due an update at the particle
+/// rate, and drawn interpolated between their last two steps. The renderer
+/// is notified of the start and end of the frame so that it can let
+/// Direct3D do its pipelining jiggery-pokery.
+/// \param s World snapshot.
+
+void CGame::RenderFrame(const SWorldSnapshot& s)
+{
+    const SHudState& hud = s.m_hud; //shorthand
+
+    m_pRenderer->SetCameraPos(s.m_vCameraPos); //camera to player
+    m_pRenderer->BeginFrame();
+    //m_pRenderer->BeginFrameExt(); //required before rendering
+
+    m_pTileManager->Draw(eSprite::Tile); //draw tiled background
+
+    if (hud.m_bDrawAABBs)
+        m_pTileManager->DrawBoundingBoxes(eSprite::Line); //draw AABBs
+
+    for (const LSpriteDesc2D& desc : s.m_vecSprites) //draw objects
+        m_pRenderer->Draw(&desc);
+
+    for (const LParticleDesc2D& d : s.m_vecParticles) //new particles
+        m_pParticleSystem->create(d);
+
+    if (s.m_fParticleStep > 0)m_pParticleSystem->step(s.m_fParticleStep); //move particles, if due
+    m_pParticleSystem->Draw(s.m_fParticleAlpha); //draw particles
+
+    if (hud.m_bDrawFrameRate)DrawFrameRateText(hud.m_debug); //draw frame rate, if required
+    if (hud.m_bDrawJobTimes)DrawJobTimesText(hud.m_debug); //draw job timings, if required
+    if (hud.m_bGodMode)DrawGodModeText(); //draw god mode text, if required
+
+    if (hud.m_bPlayerAlive)
+    {
+        DrawBarDisplay(eSprite::Bar, 0, hud.m_nHealth-1, Vector2(20, 1055));//Display Healthbar //Also player is null at the start but fixes itself
+        DrawBarDisplay(eSprite::Bar, 1, hud.m_nStamina-1, Vector2(20, 52));//Display Staminabar
+        DrawBarDisplay(eSprite::Bar, 2, hud.m_nFocus-1, Vector2(20, 22));//Display Staminabar
+        switch (hud.m_nWeaponSelector)//Weapon ammo displayed based on equipped weapon
+        {
+            case 0: DrawBarDisplay(eSprite::Bar, 3, hud.m_nRevolverMag-1, Vector2(20, 1030)); break; //Draw Revolver ammo
+            case 1: DrawBarDisplay(eSprite::Bar, 4, hud.m_nPistolMag - 1, Vector2(20, 1030)); break; //Draw Pistol Ammo
+            case 2: DrawBarDisplay(eSprite::Bar, 5, hud.m_nShotgunMag - 1, Vector2(20, 1030)); break; //Draw Shotgun Ammo
+            case 3:  break;
+            case 4:  break;
+        }
+        if (hud.m_bIsFocusing == true)
+            DrawFocusModeText(); //draw focus mode text, if focusing and alive
+        if (hud.m_bIsReloading == true)
+            DrawReloadingText();
+        if (hud.m_nCombo != 0)
+            DrawPlayerComboText(hud);  //if the player's combo is greater than 0, display it
+        DrawPlayerDamageText(hud);  //draw player's damage (this is mostly for testing and may be removed later)
+        DrawDifficultyText(hud);
+        //Picking which weapon ammo to display based on which is currently equipped
+        /* Previous Text display
+        switch (hud.m_nWeaponSelector)
+        {
+            case 0: DrawRevolverAmmoText(hud); break;
+            case 1: DrawPistolAmmoText(hud); break;
+            case 2: DrawShotgunAmmoText(hud); break;
+            case 3:  break;
+            case 4:  break;
+        }
+        */
+    }
+
+    DrawPlayerHealthText(hud); //draw players current and max health
+    DrawPlayerFocusText(hud);  //draw players current and max focus
+    DrawPlayerStaminaText(hud); //draw players current and max stamina
+
+
+    //DrawPlayerHealthDisplay(); //draw players current and max health
+    
+
+    m_pRenderer->EndFrame();
+    //m_pRenderer->EndFrameExt(); //required after rendering
+} //RenderFrame
+
+/// Make the camera follow the player, but don't let it get too close to the
+/// edge unless the world is smaller than the window, in which case we just
+/// center everything. The camera position is passed to the renderer in the
+/// world snapshot.
+
+void CGame::FollowCamera()
+{
+    if (m_pPlayer == nullptr)return; //safety
+
+    Vector3 vCameraPos(m_pPlayer->GetDrawPos()); //player position
+
+    if (m_vWorldSize.x > m_nWinWidth) { //world wider than screen
+        vCameraPos.x = std::max(vCameraPos.x, m_nWinWidth / 2.0f); //stay away from the left edge
+        vCameraPos.x = std::min(vCameraPos.x, m_vWorldSize.x - m_nWinWidth / 2.0f);  //stay away from the right edge
+    } //if
+    else vCameraPos.x = m_vWorldSize.x / 2.0f; //center horizontally.
+
+    if (m_vWorldSize.y > m_nWinHeight) { //world higher than screen
+        vCameraPos.y = std::max(vCameraPos.y, m_nWinHeight / 2.0f);  //stay away from the bottom edge
+        vCameraPos.y = std::min(vCameraPos.y, m_vWorldSize.y - m_nWinHeight / 2.0f); //stay away from the top edge
+    } //if
+    else vCameraPos.y = m_vWorldSize.y / 2.0f; //center vertically
+
+    m_vCameraPos = vCameraPos; //camera to player
+} //FollowCamera
+
+/// Run a frame as a job graph. The simulation advances by as many fixed
+/// time steps as fit into the frame time plus whatever was left over from
+/// the last frame, as counted by the scheduler's physics subsystem. If it
+/// can't keep up, the scheduler gives up after `m_nMaxSimSteps` steps and
+/// throws away the backlog so that the game slows down instead of falling
+/// further and further behind. Whatever is left over is used to interpolate
+/// the sprites between the last two steps when drawing.
+///
+/// Each step is three jobs, one after the other: thinking and the serial
+/// moves, the parallel moves, then collision detection and response. These
+/// run on the main thread, because they play sounds and create objects, and
+/// farm out their loops to the other threads themselves. The camera needs
+/// the results of the simulation, so it runs once the last step is done, if
+/// it is due an update this frame. Unless headless, the sprites are then
+/// copied into the world snapshot on any thread while the main thread steps
+/// the particles and fills in the HUD once the camera is done.
+/// \param tInput Time at which input was read for this frame.
+
+void CGame::UpdateJobs(std::chrono::steady_clock::time_point tInput)
+{
+    const float t = m_pInput->GetFrameTime(); //frame time
+
+    m_pJobSystem->BeginFrame(); //start timing
+
+    std::vector<SJob*> vecRoots; //jobs that depend on nothing
+    std::vector<SJob*> vecLeaves; //jobs that nothing depends on
+    SJob* pSim = nullptr; //last simulation job
+
+    auto Then = [&](SJob* pBefore, SJob* pAfter) { //pAfter runs after pBefore, if any
+        if (pBefore)m_pJobSystem->Depend(pBefore, pAfter);
+        else vecRoots.push_back(pAfter);
+    };
+
+    const UINT n = t > 0? m_pScheduler->Advance(eSubsystem::Physics, t): 0; //steps due
+
+    for (UINT i = 0; i < n; i++) {
+        SJob* pThink = m_pJobSystem->Create("Think", [this]() { m_pObjectManager->BeginStep(); }, true);
+        SJob* pMotion = m_pJobSystem->Create("Motion", [this]() { m_pObjectManager->MoveStep(); }, true);
+        SJob* pCollide = m_pJobSystem->Create("Collide", [this]() {
+            m_pObjectManager->EndStep();
+            m_fSimTime += m_fSimStep;
+            m_nSimSteps++;
+        }, true);
+
+        Then(pSim, pThink);
+        Then(pThink, pMotion);
+        Then(pMotion, pCollide);
+        pSim = pCollide;
+    } //for
+
+    if (t > 0) //only read by the camera and the snapshot, which come after
+        m_fSimAlpha = m_pScheduler->GetAlpha(eSubsystem::Physics); //interpolation fraction
+
+    SJob* pCamera = pSim; //last job that moves the camera, if any
+
+    if (t > 0 && m_pScheduler->Advance(eSubsystem::Camera, t) > 0)
+    {
+        pCamera = m_pJobSystem->Create("Camera", [this]() { FollowCamera(); });
+        Then(pSim, pCamera);
+    } //if
+
+    if (!m_bHeadless) //copy what is to be drawn
+    {
+        SJob* pSprites = m_pJobSystem->Create("Sprites", [this]() {
+            m_pObjectManager->Snapshot(m_pRenderThread->GetBackBuffer().m_vecSprites);
+        });
+
+        SJob* pHud = m_pJobSystem->Create("Hud", [this, tInput]() { TakeSnapshot(tInput); }, true);
+
+        Then(pSim, pSprites);
+        Then(pCamera, pHud);
+        vecLeaves = { pSprites, pHud };
+    } //if
+
+    else if (pCamera)vecLeaves.push_back(pCamera);
+
+    for (SJob* pJob : vecRoots)
+        m_pJobSystem->Kick(pJob);
+
+    for (SJob* pJob : vecLeaves)
+        m_pJobSystem->Wait(pJob);
+
+    m_pJobSystem->EndFrame(); //record timings
+} //UpdateJobs
+
+/// This function will be called regularly to process and render a frame
+/// of animation, which involves the following. Handle keyboard input.
+/// Notify the audio player at the start of each frame so that it can prevent
+/// multiple copies of a sound from starting on the same frame.  
+/// Input and the frame time come from the keyboard, controller and timer, or
+/// from a replay file, and may be recorded to one at the end of the frame.
+/// Move the game objects at the fixed simulation rate. Take a snapshot of
+/// the world and publish it to be rendered, either right away or on the
+/// render thread while the next frame is being simulated. Input and the
+/// game state stay on the main thread, since the keyboard state belongs to it.
+/// When headless the timer isn't used and no snapshot is taken, but the
+/// empty snapshot is still published so that its particles are thrown away.
+
+void CGame::ProcessFrame()
+{
+    const auto tInput = std::chrono::steady_clock::now(); //for measuring latency
+
+    ReadInput(); //from devices or replay file
+    if (m_pPlayer)m_pPlayer->ClearStrafe(); //strafe only while keys are down
+    KeyboardHandler(); //handle keyboard input
+    ControllerHandler(); //handle controller input
+    m_pAudio->BeginFrame(); //notify audio player that frame has begun
+
+    if (!m_bHeadless)
+        m_pTimer->Tick([&]() { //the frame time is part of the input
+            if (!m_pReplay->IsPlaying())
+                m_pInput->AddFrameTime(m_pTimer->GetFrameTime());
+        });
+
+    UpdateJobs(tInput); //simulate, follow camera, and copy what is to be drawn
+    m_pFrameBudget->Run(tInput); //deferrable work, if there's time
+    m_pRenderThread->Publish(); //render a frame of animation
+
+    if (m_bRestartPending) //first frame since the level started
+    {
+        const auto t = std::chrono::steady_clock::now() - m_tRestart;
+        m_fRestartTime = std::chrono::duration<float, std::milli>(t).count();
+        m_bRestartPending = false;
+    } //if
+
+    ProcessGameState(); //check for end of game
+    MusicHandler(); //Handles Music and looping
+
+    if (m_pReplay->IsRecording() || m_pReplay->IsPlaying()) //record or check
+        m_pReplay->EndFrame(m_pInput->GetFrame(), m_pObjectManager->GetChecksum());
+} //ProcessFrame
+
+/// Reader function for the game state.
+/// \return The game state.
+
+const eGameState CGame::GetGameState() const
+{
+    return m_eGameState;
+} //GetGameState
+
+/// Reader function for the playing back flag.
+/// \return true if playing back a replay.
+
+const bool CGame::IsPlayingBack() const
+{
+    return m_pReplay != nullptr && m_pReplay->IsPlaying();
+} //IsPlayingBack
+
+void CGame::MusicHandler()
+{
+    if (!start)
+    {
+        m_pAudio->loop(eSound::FeroLoop); //play background music
+        start = true;
+    }
+}
+
+/// Take action appropriate to the current game state. If the game is currently
+/// playing, then if the player has been killed or all turrets have been
+/// killed, then enter the wait state. If the game has been in the wait
+/// state for longer than 3 seconds, then restart the game. Times are
+/// simulation times so that replays take the same path.
+
+void CGame::ProcessGameState()
+{
+    static float t = 0; //time at start of game
+    
+
+    switch (m_eGameState) {
+    case eGameState::Playing:
+        if (m_fSimTime - t > 60.0f && !m_bAnimalControlOfficerSpawned && m_nNextLevel != 9) //Checks if it's been past a minute, if the animal control officer has already spawned, and if the level is not the boss level.
+        {
+            m_pObjectManager->create(eSprite::AnimalControlOfficer, m_pPlayer->startingPosition);   //Summons the animal control officer after a certain amount of time.
+            m_bAnimalControlOfficerSpawned = true;
+        }
+        if (m_pPlayer == nullptr || m_pObjectManager->GetNumEnemies() == 0) {       //MIGHT REMOVE SECOND COMPARISON
+
+            m_eGameState = eGameState::Waiting; //now waiting
+            t = m_fSimTime; //start wait timer
+        } //if
+        break;
+
+    case eGameState::Waiting:
+        if (m_fSimTime - t > 0.5f)  //0.5 seconds has elapsed since level end
+        {
+            if ((m_pObjectManager->GetNumEnemies() == 0) && (m_pPlayer != nullptr)) //player won and didn't die                   //HERE IS WHERE THE LEVEL ENDS!!!
+            {
+                m_pAudio->play(eSound::HappyChord1);    //Victory Sound
+
+                //Save the player's updated stats from powerups
+                m_nMaxHealthS = m_pPlayer->m_nMaxHealth;
+                m_nMaxFocusS = m_pPlayer->m_nMaxFocus;
+                m_nMaxStaminaS = m_pPlayer->m_nMaxStamina;
+                m_fMovementSpeedS = m_pPlayer->m_fMovementSpeed;
+                m_fMovementSpeedModifierS = m_pPlayer->m_fMovementSpeedModifier;
+                m_nDamageUpgradesS = m_pPlayer->m_nDamageUpgrades;
+                m_nHealthS = m_pPlayer->m_nHealth;
+                m_nFocusS = m_pPlayer->m_nFocus;
+                m_nStaminaS = m_pPlayer->m_nStamina;
+
+                m_nWeaponSelectorS = m_pPlayer->m_nWeaponSelector;  //Keep the same weapon equiped
+
+                if (incrementFlag == false)
+                    m_nNextLevel = (m_nNextLevel + 1); //advance next level
+
+                if (m_nNextLevel == 10)  //if the level is passed the max level, reset to the level after the first level
+                {
+                    m_nNextLevel = 0;   //reset to first level
+                }
+                if (incrementFlag == false)
+                    m_pObjectManager->m_nDifficultyModifier++;    //difficulty is increased
+
+                incrementFlag = true;
+            }
+            else if (m_pPlayer == nullptr)  //player died, reset all their stats and the level back to level 1
+            {
+                m_pAudio->play(eSound::Octave1);    //Loss Sound
+   
+                //MAKE SURE TO UPDATE THESE IF THEY ARE CHANGED IN PLAYER.h
+                m_nMaxHealthS = 15;
+                m_nMaxFocusS = 10;
+                m_nMaxStaminaS = 5;
+                m_fMovementSpeedS = 150.0f;
+                m_fMovementSpeedModifierS = 0.0f;
+                m_nDamageUpgradesS = 0;
+                m_nHealthS = 15;
+                m_nFocusS = 10;
+                m_nStaminaS = 5;
+
+                m_nNextLevel = 0;   //reset to first level
+                m_pObjectManager->m_nDifficultyModifier = 0;   //reset difficulty
+
+            }
+            if (m_fSimTime - t > 3.0f) //wait for sound to play first
+            {
+                m_bAnimalControlOfficerSpawned = false;
+                incrementFlag = false;
+                BeginGame(); //restart game
+            }
+        } //if
+        break;
+    } //switch
 } //CheckForEndOfGame
\ No newline at end of file
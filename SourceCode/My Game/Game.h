@@ -1,83 +1,155 @@
-/// \file Game.h
-/// \brief Interface for the game class CGame.
-
-#ifndef __L4RC_GAME_GAME_H__
-#define __L4RC_GAME_GAME_H__
-
-#include "Component.h"
-#include "Common.h"
-#include "ObjectManager.h"
-#include "Settings.h"
-#include "Player.h"
-
-/// \brief The game class.
-///
-/// The game class is the object-oriented implementation of the game. This class
-/// must contain the following public member functions. `Initialize()` does
-/// initialization and will be run exactly once at the start of the game.
-/// `ProcessFrame()` will be called once per frame to create and render the
-/// next animation frame. `Release()` will be called at game exit but before
-/// any destructors are run.
-
-class CGame :
-    public LComponent,
-    public LSettings,
-    public CCommon {
-
-private:
-    bool incrementFlag = false; //flag used for preventing incrementing values from incrementing more than once when winning
-    bool m_bDrawFrameRate = false; ///< Draw the frame rate.
-    eGameState m_eGameState = eGameState::Playing; ///< Game state.
-    int m_nNextLevel = 0; ///< Current level number.
-
-    //Player Stat Values (placed here so they may be saved through level transitions)
-    UINT m_nMaxHealthS = 15; //  Maximum Health. 
-    UINT m_nHealthS = m_nMaxHealthS; //  Current Health.
-    UINT m_nMaxFocusS = 10; //  Maximum Focus.
-    UINT m_nFocusS = m_nMaxFocusS; //  Current Focus.
-    UINT m_nMaxStaminaS = 10; //  Maximum Stamina.
-    UINT m_nStaminaS = m_nMaxStaminaS; //  Current Stamina.
-    float m_fMovementSpeedS = 120.0f;    // Float used for the base value of the player's movement speed.
-    float m_fMovementSpeedModifierS = 0.0f;  // Float used for modifying player's movement speed.
-    UINT m_nDamageUpgradesS = 0; // Number of Damage powerups the player has picked up.
-    UINT m_nWeaponSelectorS = 0; // This is used to select which gun you are currently using (0 - revolver, 1 - pistol, 2 - shotgun, 3 - rifle, 4 - submachinegun)
-
-    void LoadImages(); ///< Load images.
-    void LoadSounds(); ///< Load sounds.
-    void BeginGame(); ///< Begin playing the game.
-    void KeyboardHandler(); ///< The keyboard handler.
-    void ControllerHandler(); ///< The controller handler.
-    void RenderFrame(); ///< Render an animation frame.
-    void DrawFrameRateText(); ///< Draw frame rate text to screen.
-    void DrawGodModeText(); ///< Draw god mode text if in god mode.
-    void DrawFocusModeText(); //Draw focus mode text if player is focusing.
-
-    void DrawDifficultyText();   //Draws difficulty
-    void DrawPlayerHealthText(); ///< Draw player's health text
-    void DrawPlayerFocusText(); // Draw player's focus text
-    void DrawReloadingText(); // Draw text so player knows that they are reloading!
-    void DrawPlayerStaminaText(); ///< Draw player's stamina text
-    void DrawPlayerComboText(); // Draw player's combo text
-    void DrawPlayerDamageText(); // Draw player's damage text (this is mostly for testing purposes and may be removed later)
-    void DrawRevolverAmmoText(); // Draw player's Revolver max and current ammo
-    void DrawPistolAmmoText();  // Draw player's Pistol max and current ammo
-    void DrawShotgunAmmoText(); // Draw player's Shotgun max and current ammo
-    //void DrawPlayerHealthDisplay(); ///< Draw player's health bar
-    void DrawBarDisplay(eSprite t, int p, int i, Vector2 pos);
-
-    void CreateObjects(); ///< Create game objects.
-    void FollowCamera(); ///< Make camera follow player character.
-    void ProcessGameState(); ///< Process game state.
-    void MusicHandler(); ///< Process Music and loop
-    bool start = false;
-
-public:
-    
-    ~CGame(); ///< Destructor.
-
-    void Initialize(); ///< Initialize the game.
-    void ProcessFrame(); ///< Process an animation frame.
-    void Release(); ///< Release the renderer.
-}; //CGame
-
-#endif //__L4RC_GAME_GAME_H__
+/// \file Game.h
+/// \brief Interface for the game class CGame.
+
+#ifndef __L4RC_GAME_GAME_H__
+#define __L4RC_GAME_GAME_H__
+
+#include "Component.h"
+#include "Common.h"
+#include "ObjectManager.h"
+#include "Settings.h"
+#include "Player.h"
+#include "RenderThread.h"
+#include "Input.h"
+#include "Replay.h"
+#include "TileManager.h"
+
+#include <chrono>
+
+/// \brief A level snapshot.
+///
+/// Everything needed to start a level again without loading it: the tile
+/// map, walls and spawn manifest, and the player's stats at the start of the
+/// level, which are the `m_n*S` fields of `CGame`.
+
+struct SLevelSnapshot{
+    bool m_bValid = false; ///< A snapshot has been taken.
+    int m_nLevel = 0; ///< Level number.
+    UINT m_nDifficulty = 0; ///< Difficulty modifier.
+    STileSnapshot m_sTiles; ///< Tile map, walls and spawn manifest.
+
+    UINT m_nMaxHealthS = 0; ///< Maximum health.
+    UINT m_nHealthS = 0; ///< Current health.
+    UINT m_nMaxFocusS = 0; ///< Maximum focus.
+    UINT m_nFocusS = 0; ///< Current focus.
+    UINT m_nMaxStaminaS = 0; ///< Maximum stamina.
+    UINT m_nStaminaS = 0; ///< Current stamina.
+    float m_fMovementSpeedS = 0; ///< Movement speed.
+    float m_fMovementSpeedModifierS = 0; ///< Movement speed modifier.
+    UINT m_nDamageUpgradesS = 0; ///< Number of damage upgrades.
+    UINT m_nWeaponSelectorS = 0; ///< Equipped weapon.
+}; //SLevelSnapshot
+
+/// \brief The game class.
+///
+/// The game class is the object-oriented implementation of the game. This class
+/// must contain the following public member functions. `Initialize()` does
+/// initialization and will be run exactly once at the start of the game.
+/// `ProcessFrame()` will be called once per frame to create and render the
+/// next animation frame. `Release()` will be called at game exit but before
+/// any destructors are run.
+
+class CGame :
+    public LComponent,
+    public LSettings,
+    public CCommon {
+
+private:
+    bool incrementFlag = false; //flag used for preventing incrementing values from incrementing more than once when winning
+    bool m_bDrawFrameRate = false; ///< Draw the frame rate.
+    bool m_bDrawJobTimes = false; ///< Draw the job timings.
+    bool m_bRenderThread = true; ///< Draw on a render thread.
+    bool m_bHeadless = false; ///< No window, renderer or input devices.
+    bool m_bDebugHudPending = false; ///< Debug HUD update is waiting for time in the frame.
+    SDebugHud m_sDebugHud; ///< Latest debug HUD state, copied into each snapshot.
+    UINT m_nSeed = 0; ///< Random number seed when headless.
+
+    CInput* m_pInput = nullptr; ///< This frame's input.
+    CReplay* m_pReplay = nullptr; ///< Input recorder and player.
+    eReplayMode m_eReplayMode = eReplayMode::Off; ///< Replay mode at start.
+    std::string m_strReplayFile = "replay.bin"; ///< Replay file name.
+    std::string m_strReplayReport = "replay.txt"; ///< Replay report file name.
+    bool m_bQuitAfterReplay = false; ///< Quit when playback ends.
+    eGameState m_eGameState = eGameState::Playing; ///< Game state.
+    int m_nNextLevel = 0; ///< Current level number.
+
+    SLevelSnapshot m_sLevel; ///< Snapshot of the current level at its start.
+    bool m_bRestored = false; ///< Current level was restored from the snapshot.
+    bool m_bRestartPending = false; ///< Restart is not yet timed.
+    std::chrono::steady_clock::time_point m_tRestart; ///< When the restart began.
+    float m_fRestartTime = 0; ///< Time from restart to end of first frame in ms.
+
+    UINT m_nMaxSimSteps = 8; ///< Maximum simulation steps per frame.
+
+    //Player Stat Values (placed here so they may be saved through level transitions)
+    UINT m_nMaxHealthS = 15; //  Maximum Health. 
+    UINT m_nHealthS = m_nMaxHealthS; //  Current Health.
+    UINT m_nMaxFocusS = 10; //  Maximum Focus.
+    UINT m_nFocusS = m_nMaxFocusS; //  Current Focus.
+    UINT m_nMaxStaminaS = 10; //  Maximum Stamina.
+    UINT m_nStaminaS = m_nMaxStaminaS; //  Current Stamina.
+    float m_fMovementSpeedS = 120.0f;    // Float used for the base value of the player's movement speed.
+    float m_fMovementSpeedModifierS = 0.0f;  // Float used for modifying player's movement speed.
+    UINT m_nDamageUpgradesS = 0; // Number of Damage powerups the player has picked up.
+    UINT m_nWeaponSelectorS = 0; // This is used to select which gun you are currently using (0 - revolver, 1 - pistol, 2 - shotgun, 3 - rifle, 4 - submachinegun)
+
+    void LoadImages(); ///< Load images.
+    void LoadSounds(); ///< Load sounds.
+    void LoadSimSettings(); ///< Load simulation settings.
+    void LoadRenderSettings(); ///< Load render settings.
+    void LoadReplaySettings(); ///< Load replay settings.
+    void LoadAISettings(); ///< Load AI level of detail settings.
+    void LoadBudgetSettings(); ///< Load frame budget settings.
+    void LoadRateSettings(); ///< Load subsystem update rates.
+    void StartReplay(); ///< Start recording or playing back.
+    void EndPlayback(); ///< Report on a playback and stop it.
+    void ReadInput(); ///< Read this frame's input.
+    void LoadLevel(); ///< Load the current level's map.
+    void SaveLevel(); ///< Take a snapshot of the current level.
+    void RestoreLevel(bool); ///< Restore the current level from its snapshot.
+    void BeginGame(bool=false); ///< Begin playing the game.
+    void KeyboardHandler(); ///< The keyboard handler.
+    void ControllerHandler(); ///< The controller handler.
+    void TakeSnapshot(std::chrono::steady_clock::time_point); ///< Fill in a world snapshot.
+    void StepParticles(SWorldSnapshot&); ///< Fill in a world snapshot's particle step.
+    void UpdateDebugHud(); ///< Gather the debug HUD state.
+    void RenderFrame(const SWorldSnapshot&); ///< Render an animation frame.
+    void DrawFrameRateText(const SDebugHud&); ///< Draw frame rate text to screen.
+    void DrawJobTimesText(const SDebugHud&); ///< Draw job timings to screen.
+    void DrawGodModeText(); ///< Draw god mode text if in god mode.
+    void DrawFocusModeText(); //Draw focus mode text if player is focusing.
+
+    void DrawDifficultyText(const SHudState&);   //Draws difficulty
+    void DrawPlayerHealthText(const SHudState&); ///< Draw player's health text
+    void DrawPlayerFocusText(const SHudState&); // Draw player's focus text
+    void DrawReloadingText(); // Draw text so player knows that they are reloading!
+    void DrawPlayerStaminaText(const SHudState&); ///< Draw player's stamina text
+    void DrawPlayerComboText(const SHudState&); // Draw player's combo text
+    void DrawPlayerDamageText(const SHudState&); // Draw player's damage text (this is mostly for testing purposes and may be removed later)
+    void DrawRevolverAmmoText(const SHudState&); // Draw player's Revolver max and current ammo
+    void DrawPistolAmmoText(const SHudState&);  // Draw player's Pistol max and current ammo
+    void DrawShotgunAmmoText(const SHudState&); // Draw player's Shotgun max and current ammo
+    //void DrawPlayerHealthDisplay(); ///< Draw player's health bar
+    void DrawBarDisplay(eSprite t, int p, int i, Vector2 pos);
+
+    void CreateObjects(); ///< Create game objects.
+    void FollowCamera(); ///< Make camera follow player character.
+    void UpdateJobs(std::chrono::steady_clock::time_point); ///< Run a frame's phases as jobs.
+    void ProcessGameState(); ///< Process game state.
+    void MusicHandler(); ///< Process Music and loop
+    bool start = false;
+
+public:
+    
+    ~CGame(); ///< Destructor.
+
+    void Initialize(); ///< Initialize the game.
+    void InitializeHeadless(const std::string&, UINT); ///< Initialize without a window.
+    void ProcessFrame(); ///< Process an animation frame.
+    void Release(); ///< Release the renderer.
+
+    const eGameState GetGameState() const; ///< Get the game state.
+    const bool IsPlayingBack() const; ///< Is playing back a replay.
+}; //CGame
+
+#endif //__L4RC_GAME_GAME_H__
@@ -0,0 +1,328 @@
+/// \file Headless.cpp
+/// \brief Code for the headless runner CHeadless, and the entry point of the
+/// headless build.
+
+#include "Headless.h"
+#include "Game.h"
+#include "ComponentIncludes.h"
+#include "JobSystem.h"
+#include "ObjectManager.h"
+#include "FrameBudget.h"
+#include "RateScheduler.h"
+#include "TileManager.h"
+#include "PathFinder.h"
+#include "PathHierarchy.h"
+#include "Rng.h"
+
+#include <chrono>
+
+/// Add one frame's times to the totals.
+/// \param t Wall-clock time in milliseconds.
+/// \param tThread Thread time in milliseconds.
+
+void SPhaseTiming::Add(float t, float tThread){
+  m_nFrames++;
+  m_fTotal += t;
+  m_fThreadTotal += tThread;
+  m_fMax = std::max(m_fMax, t);
+} //Add
+
+/// Parse the command line. The options are `-frames n` for the maximum
+/// number of frames, `-replay file` to play back a replay file, `-seed n`
+/// for the random number seed, `-level` to stop when the first level
+/// ends, `-noseparation` to turn off ant crowd steering so that the ant
+/// contact counts can be compared with it on, and `-paths n` to time n path
+/// finding queries instead of running the simulation, on the first level's
+/// map or on the map given by `-map file`.
+/// \param argc Number of command line arguments.
+/// \param argv Command line arguments.
+/// \return true if the command line made sense.
+
+bool CHeadless::ParseArgs(int argc, char* argv[]){
+  for(int i=1; i<argc; i++){
+    const std::string arg = argv[i]; //shorthand
+    const bool bHasValue = i + 1 < argc; //there's another argument after it
+
+    if(arg == "-frames" && bHasValue)
+      m_nMaxFrames = (UINT)strtoul(argv[++i], nullptr, 10);
+
+    else if(arg == "-replay" && bHasValue)
+      m_strReplay = argv[++i];
+
+    else if(arg == "-seed" && bHasValue)
+      m_nSeed = (UINT)strtoul(argv[++i], nullptr, 10);
+
+    else if(arg == "-level")
+      m_bUntilLevelEnd = true;
+
+    else if(arg == "-noseparation")
+      m_bSeparation = false;
+
+    else if(arg == "-paths" && bHasValue)
+      m_nPathQueries = (UINT)strtoul(argv[++i], nullptr, 10);
+
+    else if(arg == "-map" && bHasValue)
+      m_strMap = argv[++i];
+
+    else return false; //unknown option
+  } //for
+
+  return true;
+} //ParseArgs
+
+/// Add the timings of the frame that just ended. The job system has the
+/// start and end times of each of the frame's jobs. A phase such as the
+/// object moves may be split over several jobs with the same name, so its
+/// wall-clock time is from the start of the first to the end of the last.
+/// \param t Wall-clock time for the whole frame in milliseconds.
+
+void CHeadless::AddTimings(float t){
+  m_sFrame.Add(t, t);
+
+  const std::vector<SJobTiming>& vecTimings = m_pJobSystem->GetTimings();
+  std::vector<bool> bDone(vecTimings.size(), false); //job already counted
+
+  for(size_t i=0; i<vecTimings.size(); i++){ //for each job not yet counted
+    if(bDone[i])continue;
+
+    const char* name = vecTimings[i].m_strName; //phase name
+    float t0 = vecTimings[i].m_fStart; //phase start
+    float t1 = vecTimings[i].m_fEnd; //phase end
+    float tThread = 0; //thread time
+
+    for(size_t j=i; j<vecTimings.size(); j++) //for jobs in this phase
+      if(strcmp(vecTimings[j].m_strName, name) == 0){
+        t0 = std::min(t0, vecTimings[j].m_fStart);
+        t1 = std::max(t1, vecTimings[j].m_fEnd);
+        tThread += vecTimings[j].m_fEnd - vecTimings[j].m_fStart;
+        bDone[j] = true;
+      } //if
+
+    auto p = std::find_if(m_vecPhases.begin(), m_vecPhases.end(),
+      [&](const SPhaseTiming& s){return strcmp(s.m_strName, name) == 0;});
+
+    if(p == m_vecPhases.end()){ //first time for this phase
+      m_vecPhases.push_back(SPhaseTiming());
+      p = m_vecPhases.end() - 1;
+      p->m_strName = name;
+    } //if
+
+    p->Add(t1 - t0, tThread);
+  } //for
+} //AddTimings
+
+/// Print the number of frames, the frame rate, the simulation time, the
+/// world state checksum, the number of deferrable tasks run and of frames
+/// that went over the frame budget, the number of updates of each subsystem
+/// that runs at its own rate, and the mean and longest times for the whole frame
+/// and for each phase. Phases that run inside other phases, such as the
+/// object moves inside the simulation, are listed separately.
+/// \param secs Wall-clock time for the whole run in seconds.
+
+void CHeadless::PrintTimings(double secs) const{
+  const UINT n = m_sFrame.m_nFrames; //shorthand
+
+  printf("%u frames in %.3f s, %.1f frames/s, %.2f s simulated, checksum %08x\n",
+    n, secs, secs > 0? n/secs: 0.0, m_fSimTime, m_pObjectManager->GetChecksum());
+
+  if(n == 0)return; //no frames, so no timings
+
+  const SBudgetStats& b = m_pFrameBudget->GetStats(); //shorthand
+  printf("%u deferrable tasks, %u overruns of the %.1f ms frame budget\n",
+    b.m_nTotalRun, b.m_nOverruns, m_pFrameBudget->GetBudget());
+
+  printf("%-12s %8s %10s %10s %10s\n", "phase", "frames", "mean ms", "max ms", "thread ms");
+
+  auto Print = [&](const SPhaseTiming& s){
+    printf("%-12s %8u %10.4f %10.4f %10.4f\n", s.m_strName, s.m_nFrames,
+      s.m_fTotal/n, s.m_fMax, s.m_fThreadTotal/n);
+  }; //Print
+
+  Print(m_sFrame);
+  for(const SPhaseTiming& s: m_vecPhases)Print(s);
+
+  for(UINT i=0; i<(UINT)eSubsystem::Size; i++){ //subsystems updated once a frame or less
+    const SSubsystem& r = m_pScheduler->Get((eSubsystem)i); //shorthand
+    if(r.m_nFrames == 0)continue; //not updated by frames
+
+    printf("%-12s %8u updates in %u frames\n", r.m_strName, r.m_nTotalTicks, r.m_nFrames);
+  } //for
+
+  printf("%-12s %7.1f%% of thinks skipped\n", m_pScheduler->Get(eSubsystem::AI).m_strName,
+    100.0f*(1.0f - m_pObjectManager->GetThinkFraction()));
+
+  printf("%.2f contacts per step, %.2f between ants, crowd steering %s\n",
+    m_pObjectManager->GetContactsPerStep(), m_pObjectManager->GetAntContactsPerStep(),
+    m_pObjectManager->GetSeparation()? "on": "off");
+} //PrintTimings
+
+/// Time path finding queries between random pairs of non-wall tiles, picked
+/// with a generator seeded from the random number seed so that every run
+/// asks for the same paths. The same queries are asked of the JPS path
+/// finder and of the hierarchical path finder, and the mean and longest
+/// query times and the mean number of nodes expanded are printed for each.
+/// Then a tile is turned into a wall and back into what it was, and the time
+/// taken to rebuild the hierarchy after each change is printed.
+
+void CHeadless::BenchmarkPaths(){
+  if(!m_strMap.empty())
+    m_pTileManager->LoadMap((char*)m_strMap.c_str());
+
+  const auto tBuild0 = std::chrono::steady_clock::now();
+  m_pPathHierarchy->Update();
+  const auto tBuild1 = std::chrono::steady_clock::now();
+
+  const size_t w = m_pTileManager->GetWidth(); //map width
+  const size_t h = m_pTileManager->GetHeight(); //map height
+  std::vector<size_t> vecOpen; //indices of non-wall tiles
+
+  for(size_t i=0; i<h; i++)
+    for(size_t j=0; j<w; j++)
+      if(!m_pTileManager->IsWall(i, j))
+        vecOpen.push_back(i*w + j);
+
+  if(vecOpen.empty()){
+    printf("no open tiles on the map\n");
+    return;
+  } //if
+
+  const SHierarchyStats& hs = m_pPathHierarchy->GetStats(); //shorthand
+  printf("%zux%zu map, %u clusters, %u abstract nodes, %u edges, built in %.3f ms\n",
+    w, h, hs.m_nClusters, hs.m_nNodes, hs.m_nEdges,
+    std::chrono::duration<float, std::milli>(tBuild1 - tBuild0).count());
+
+  const UINT n = m_nPathQueries; //shorthand
+  std::vector<Vector2> path; //reused for every query
+
+  for(int pass=0; pass<2; pass++){ //JPS, then HPA*
+    CRng rng(m_nSeed); //query generator, same queries each pass
+    UINT nFound = 0; //number of paths found
+    UINT nExpanded = 0; //nodes expanded
+    double tTotal = 0; //total query time in microseconds
+    float tMax = 0; //longest query time in microseconds
+
+    for(UINT k=0; k<n; k++){
+      const size_t s = vecOpen[rng.Below((uint32_t)vecOpen.size())]; //start
+      const size_t g = vecOpen[rng.Below((uint32_t)vecOpen.size())]; //goal
+      const Vector2 from = m_pTileManager->GetTileCenter(s/w, s%w); //start point
+      const Vector2 to = m_pTileManager->GetTileCenter(g/w, g%w); //goal point
+
+      const auto t0 = std::chrono::steady_clock::now();
+
+      const bool bFound = pass == 0?
+        m_pPathFinder->FindPath(from, to, path):
+        m_pPathHierarchy->FindPath(from, to, path);
+
+      const auto t1 = std::chrono::steady_clock::now();
+
+      if(bFound)nFound++;
+      nExpanded += pass == 0?
+        m_pPathFinder->GetStats().m_nExpanded:
+        m_pPathHierarchy->GetStats().m_nExpanded;
+
+      const float t = std::chrono::duration<float, std::micro>(t1 - t0).count(); //query time
+      tTotal += t;
+      tMax = std::max(tMax, t);
+    } //for
+
+    printf("%-5s %u queries, %u found, mean %.2f us, max %.2f us, %.1f nodes expanded\n",
+      pass == 0? "JPS": "HPA*", n, nFound, tTotal/n, tMax, (double)nExpanded/n);
+  } //for
+
+  const size_t t = vecOpen[vecOpen.size()/2]; //tile to change
+  const char chOpen = m_pTileManager->GetChar(t/w, t%w); //what it was
+  const UINT nRebuilt = hs.m_nRebuilt; //clusters rebuilt before
+
+  for(char c: {'W', chOpen}){ //close it, then open it again
+    m_pTileManager->SetTile(t/w, t%w, c);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    m_pPathHierarchy->Update();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    printf("tile %zu,%zu set to %c, hierarchy updated in %.3f ms\n", t/w, t%w, c,
+      std::chrono::duration<float, std::milli>(t1 - t0).count());
+  } //for
+
+  printf("%u clusters rebuilt\n", hs.m_nRebuilt - nRebuilt);
+} //BenchmarkPaths
+
+/// Run the simulation. Load the settings, create the audio player, which
+/// plays nothing if there is no audio device, then initialize the game without a renderer and run it as fast as
+/// possible. Times are per frame, averaged over every frame, including frames
+/// in which a phase didn't run. The frame on which a replay runs out is not
+/// counted.
+/// \param game The game.
+/// \param argc Number of command line arguments.
+/// \param argv Command line arguments.
+/// \return 0 if the run finished, otherwise 1.
+
+int CHeadless::Run(CGame& game, int argc, char* argv[]){
+  if(!ParseArgs(argc, argv)){
+    printf("usage: %s [-frames n] [-replay file] [-seed n] [-level] [-noseparation] [-paths n [-map file]]\n", argv[0]);
+    return 1;
+  } //if
+
+  Load(); //gamesettings.xml
+
+  m_pAudio = new LAudio;
+
+  game.InitializeHeadless(m_strReplay, m_nSeed);
+  if(!m_bSeparation)m_pObjectManager->SetSeparation(false); //overrides settings and replay
+  m_sFrame.m_strName = "Frame";
+
+  const bool bReplay = !m_strReplay.empty(); //playing back
+
+  if(m_nPathQueries > 0)
+    BenchmarkPaths(); //instead of the simulation
+
+  else if(bReplay && !game.IsPlayingBack())
+    printf("cannot play back %s\n", m_strReplay.c_str());
+
+  else{
+    const auto tStart = std::chrono::steady_clock::now();
+
+    for(UINT i=0; i<m_nMaxFrames; i++){
+      const auto t0 = std::chrono::steady_clock::now();
+      game.ProcessFrame();
+      const auto t1 = std::chrono::steady_clock::now();
+
+      if(bReplay && !game.IsPlayingBack())
+        break; //replay ran out at the start of this frame
+
+      AddTimings(std::chrono::duration<float, std::milli>(t1 - t0).count());
+
+      if(m_bUntilLevelEnd && game.GetGameState() == eGameState::Waiting)
+        break; //player won or died
+    } //for
+
+    const auto tEnd = std::chrono::steady_clock::now();
+    PrintTimings(std::chrono::duration<double>(tEnd - tStart).count());
+  } //else
+
+  game.Release();
+
+  delete m_pAudio;
+  m_pAudio = nullptr; //for safety
+
+  return bReplay && m_sFrame.m_nFrames == 0? 1: 0;
+} //Run
+
+#ifdef HEADLESS
+
+static CHeadless g_cHeadless; ///< The headless runner.
+static CGame g_cGame; ///< The game class.
+
+/// \brief The entry point for the headless build.
+///
+/// The entry point for the headless build, which is a console application
+/// with no window. Build the `Headless` configuration to get it.
+/// \param argc Number of command line arguments.
+/// \param argv Command line arguments.
+/// \return 0 if the run finished, otherwise 1.
+
+int main(int argc, char* argv[]){
+  return g_cHeadless.Run(g_cGame, argc, argv);
+} //main
+
+#endif //HEADLESS
@@ -0,0 +1,70 @@
+/// \file Headless.h
+/// \brief Interface for the headless runner CHeadless.
+
+#ifndef __L4RC_GAME_HEADLESS_H__
+#define __L4RC_GAME_HEADLESS_H__
+
+#include "Component.h"
+#include "Settings.h"
+#include "Common.h"
+
+#include <string>
+#include <vector>
+
+class CGame;
+
+/// \brief A phase timing.
+///
+/// How long one phase of a frame took, totalled over a headless run. The
+/// wall-clock time of a phase in a frame is from when its first job started
+/// to when its last job ended. The thread time adds up the time taken by all
+/// of its jobs, so it is larger than the wall-clock time when the phase is
+/// split over several threads.
+
+struct SPhaseTiming{
+  const char* m_strName = ""; ///< Phase name.
+  UINT m_nFrames = 0; ///< Number of frames that the phase ran in.
+  double m_fTotal = 0; ///< Total wall-clock time in milliseconds.
+  double m_fThreadTotal = 0; ///< Total thread time in milliseconds.
+  float m_fMax = 0; ///< Longest wall-clock time in one frame in milliseconds.
+
+  void Add(float, float); ///< Add one frame's times.
+}; //SPhaseTiming
+
+/// \brief The headless runner.
+///
+/// Runs the game's simulation without a window, a renderer, or input devices,
+/// as fast as it will go, for a given number of frames or until a replay or
+/// the first level ends. Each frame is either one simulation step with no
+/// input, or a frame from a replay file. The timings of the phases of the
+/// frame are taken from the job system and printed at the end, together with
+/// a checksum of the world state, which is the same on every run with the
+/// same seed or replay. It can instead time the path finder on a map.
+
+class CHeadless:
+  public LComponent,
+  public LSettings,
+  public CCommon
+{
+  private:
+    UINT m_nMaxFrames = 3600; ///< Maximum number of frames to run.
+    std::string m_strReplay; ///< Replay file to play back, if any.
+    UINT m_nSeed = 0; ///< Random number seed if not playing back.
+    bool m_bUntilLevelEnd = false; ///< Stop when the first level ends.
+    bool m_bSeparation = true; ///< Leave ant crowd steering as set.
+    UINT m_nPathQueries = 0; ///< Number of path finding queries to benchmark.
+    std::string m_strMap; ///< Map file to benchmark path finding on, if any.
+
+    SPhaseTiming m_sFrame; ///< Whole frame timing.
+    std::vector<SPhaseTiming> m_vecPhases; ///< Phase timings in order of first appearance.
+
+    bool ParseArgs(int, char*[]); ///< Parse the command line.
+    void AddTimings(float); ///< Add this frame's timings.
+    void PrintTimings(double) const; ///< Print the timings.
+    void BenchmarkPaths(); ///< Time path finding queries.
+
+  public:
+    int Run(CGame&, int, char*[]); ///< Run the simulation.
+}; //CHeadless
+
+#endif //__L4RC_GAME_HEADLESS_H__
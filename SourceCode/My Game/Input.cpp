@@ -0,0 +1,220 @@
+/// \file Input.cpp
+/// \brief Code for the input state CInput.
+
+#include "Input.h"
+#include "ComponentIncludes.h"
+
+/// Keys that the game polls. The position of a key in this list is the
+/// position of its bit in the key masks of an input frame, so keys must only
+/// be added at the end or old recordings will play back wrongly.
+
+const int CInput::m_nKeys[] = {
+  VK_F1, VK_F2, VK_F3, VK_F4, VK_F5, VK_BACK,
+  VK_UP, VK_LSHIFT, VK_RIGHT, VK_LEFT, VK_SPACE,
+  'A', 'D', 'W', 'S', 'F', 'R', 'G',
+  '1', '2', '3', '4', '5', VK_F6,
+}; //m_nKeys
+
+const UINT CInput::m_nNumKeys = sizeof(m_nKeys)/sizeof(int);
+
+/// Get the bit for a key in the key masks of an input frame.
+/// \param key Virtual key code.
+/// \return The key's bit, or zero if the game doesn't poll that key.
+
+const uint32_t CInput::KeyBit(int key) const{
+  for(UINT i=0; i<m_nNumKeys; i++)
+    if(m_nKeys[i] == key)
+      return 1U << i;
+
+  return 0;
+} //KeyBit
+
+/// Test a controller button.
+/// \param b Button.
+/// \return true if the button's bit is set in this frame's input.
+
+const bool CInput::Button(eButton b) const{
+  return (m_sFrame.m_nButtons & (uint16_t)b) != 0;
+} //Button
+
+/// Start a new frame by reading the state of the keyboard and, if it is
+/// connected, the controller. The frame time is zeroed, to be added to by
+/// the timer.
+
+void CInput::Poll(){
+  m_sFrame = SInputFrame(); //start from nothing
+
+  m_pKeyboard->GetState(); //get current keyboard state
+
+  for(UINT i=0; i<m_nNumKeys; i++){ //for each key polled
+    const uint32_t bit = 1U << i; //its bit
+
+    if(m_pKeyboard->Down(m_nKeys[i]))m_sFrame.m_nKeyDown |= bit;
+    if(m_pKeyboard->TriggerDown(m_nKeys[i]))m_sFrame.m_nKeyTriggerDown |= bit;
+    if(m_pKeyboard->TriggerUp(m_nKeys[i]))m_sFrame.m_nKeyTriggerUp |= bit;
+  } //for
+
+  m_sFrame.m_bConnected = m_pController->IsConnected();
+  if(!m_sFrame.m_bConnected)return; //no controller, so we're done
+
+  m_pController->GetState(); //get state of controller's controls
+
+  m_sFrame.m_fLTrigger = m_pController->GetLTrigger();
+  m_sFrame.m_fRTrigger = m_pController->GetRTrigger();
+  m_sFrame.m_vRThumb = m_pController->GetRThumb();
+
+  uint16_t& b = m_sFrame.m_nButtons; //shorthand
+
+  if(m_pController->GetButtonRSToggle())b |= (uint16_t)eButton::RSToggle;
+  if(m_pController->GetButtonXToggle())b |= (uint16_t)eButton::XToggle;
+  if(m_pController->GetButtonYToggle())b |= (uint16_t)eButton::YToggle;
+  if(m_pController->GetButtonAToggle())b |= (uint16_t)eButton::AToggle;
+  if(m_pController->GetButtonBToggle())b |= (uint16_t)eButton::BToggle;
+  if(m_pController->GetDPadRight())b |= (uint16_t)eButton::DPadRight;
+  if(m_pController->GetDPadLeft())b |= (uint16_t)eButton::DPadLeft;
+  if(m_pController->GetDPadUp())b |= (uint16_t)eButton::DPadUp;
+  if(m_pController->GetDPadDown())b |= (uint16_t)eButton::DPadDown;
+} //Poll
+
+/// Set this frame's input, for example from a recording.
+/// \param f Input frame.
+
+void CInput::SetFrame(const SInputFrame& f){
+  m_sFrame = f;
+} //SetFrame
+
+/// Reader function for this frame's input.
+/// \return This frame's input.
+
+const SInputFrame& CInput::GetFrame() const{
+  return m_sFrame;
+} //GetFrame
+
+/// Add to this frame's frame time.
+/// \param t Time in seconds.
+
+void CInput::AddFrameTime(float t){
+  m_sFrame.m_fFrameTime += t;
+} //AddFrameTime
+
+/// Reader function for this frame's frame time.
+/// \return Frame time in seconds.
+
+const float CInput::GetFrameTime() const{
+  return m_sFrame.m_fFrameTime;
+} //GetFrameTime
+
+/// Check whether a key went down this frame.
+/// \param key Virtual key code.
+/// \return true if the key went down this frame.
+
+const bool CInput::TriggerDown(int key) const{
+  return (m_sFrame.m_nKeyTriggerDown & KeyBit(key)) != 0;
+} //TriggerDown
+
+/// Check whether a key went up this frame.
+/// \param key Virtual key code.
+/// \return true if the key went up this frame.
+
+const bool CInput::TriggerUp(int key) const{
+  return (m_sFrame.m_nKeyTriggerUp & KeyBit(key)) != 0;
+} //TriggerUp
+
+/// Check whether a key is down.
+/// \param key Virtual key code.
+/// \return true if the key is down.
+
+const bool CInput::Down(int key) const{
+  return (m_sFrame.m_nKeyDown & KeyBit(key)) != 0;
+} //Down
+
+/// Reader function for the controller connected flag.
+/// \return true if the controller is connected.
+
+const bool CInput::IsConnected() const{
+  return m_sFrame.m_bConnected;
+} //IsConnected
+
+/// Reader function for the controller's left trigger.
+/// \return Left trigger position.
+
+const float CInput::GetLTrigger() const{
+  return m_sFrame.m_fLTrigger;
+} //GetLTrigger
+
+/// Reader function for the controller's right trigger.
+/// \return Right trigger position.
+
+const float CInput::GetRTrigger() const{
+  return m_sFrame.m_fRTrigger;
+} //GetRTrigger
+
+/// Reader function for the controller's right thumbstick.
+/// \return Right thumbstick position.
+
+const Vector2& CInput::GetRThumb() const{
+  return m_sFrame.m_vRThumb;
+} //GetRThumb
+
+/// Reader function for the right shoulder button toggle.
+/// \return true if the button was toggled.
+
+const bool CInput::GetButtonRSToggle() const{
+  return Button(eButton::RSToggle);
+} //GetButtonRSToggle
+
+/// Reader function for the X button toggle.
+/// \return true if the button was toggled.
+
+const bool CInput::GetButtonXToggle() const{
+  return Button(eButton::XToggle);
+} //GetButtonXToggle
+
+/// Reader function for the Y button toggle.
+/// \return true if the button was toggled.
+
+const bool CInput::GetButtonYToggle() const{
+  return Button(eButton::YToggle);
+} //GetButtonYToggle
+
+/// Reader function for the A button toggle.
+/// \return true if the button was toggled.
+
+const bool CInput::GetButtonAToggle() const{
+  return Button(eButton::AToggle);
+} //GetButtonAToggle
+
+/// Reader function for the B button toggle.
+/// \return true if the button was toggled.
+
+const bool CInput::GetButtonBToggle() const{
+  return Button(eButton::BToggle);
+} //GetButtonBToggle
+
+/// Reader function for the right button of the D-pad.
+/// \return true if it is down.
+
+const bool CInput::GetDPadRight() const{
+  return Button(eButton::DPadRight);
+} //GetDPadRight
+
+/// Reader function for the left button of the D-pad.
+/// \return true if it is down.
+
+const bool CInput::GetDPadLeft() const{
+  return Button(eButton::DPadLeft);
+} //GetDPadLeft
+
+/// Reader function for the up button of the D-pad.
+/// \return true if it is down.
+
+const bool CInput::GetDPadUp() const{
+  return Button(eButton::DPadUp);
+} //GetDPadUp
+
+/// Reader function for the down button of the D-pad.
+/// \return true if it is down.
+
+const bool CInput::GetDPadDown() const{
+  return Button(eButton::DPadDown);
+} //GetDPadDown
@@ -0,0 +1,85 @@
+/// \file Input.h
+/// \brief Interface for the input state CInput.
+
+#ifndef __L4RC_GAME_INPUT_H__
+#define __L4RC_GAME_INPUT_H__
+
+#include "Component.h"
+
+#include <cstdint>
+
+/// \brief An input frame.
+///
+/// Everything that the game reads from the keyboard and the controller in
+/// one frame, together with the frame time. Each key that the game polls has
+/// one bit in each of the key masks, in the order that the keys are listed
+/// in `CInput`. This is what is recorded and played back by `CReplay`.
+
+struct SInputFrame{
+  float m_fFrameTime = 0; ///< Frame time in seconds.
+
+  uint32_t m_nKeyDown = 0; ///< Keys that are down.
+  uint32_t m_nKeyTriggerDown = 0; ///< Keys that went down this frame.
+  uint32_t m_nKeyTriggerUp = 0; ///< Keys that went up this frame.
+
+  bool m_bConnected = false; ///< Controller is connected.
+  uint16_t m_nButtons = 0; ///< Controller buttons, see `eButton` in `CInput`.
+  float m_fLTrigger = 0; ///< Controller left trigger.
+  float m_fRTrigger = 0; ///< Controller right trigger.
+  Vector2 m_vRThumb; ///< Controller right thumbstick.
+}; //SInputFrame
+
+/// \brief The input state.
+///
+/// The game reads input from here instead of straight from the keyboard and
+/// the controller, so that the input can come either from the devices or
+/// from a recording. The reader functions have the same names as the
+/// keyboard and controller functions that they stand in for. Only the keys
+/// listed in `m_nKeys` can be read.
+
+class CInput: public LComponent{
+  private:
+    /// \brief Controller buttons, one bit each in an input frame.
+
+    enum class eButton: uint16_t{
+      RSToggle = 1 << 0, XToggle = 1 << 1, YToggle = 1 << 2,
+      AToggle = 1 << 3, BToggle = 1 << 4,
+      DPadRight = 1 << 5, DPadLeft = 1 << 6, DPadUp = 1 << 7, DPadDown = 1 << 8,
+    }; //eButton
+
+    static const int m_nKeys[]; ///< Keys that the game polls.
+    static const UINT m_nNumKeys; ///< Number of keys that the game polls.
+
+    SInputFrame m_sFrame; ///< This frame's input.
+
+    const uint32_t KeyBit(int) const; ///< Get the bit for a key.
+    const bool Button(eButton) const; ///< Test a controller button.
+
+  public:
+    void Poll(); ///< Read the keyboard and controller.
+    void SetFrame(const SInputFrame&); ///< Set this frame's input.
+    const SInputFrame& GetFrame() const; ///< Get this frame's input.
+
+    void AddFrameTime(float); ///< Add to this frame's frame time.
+    const float GetFrameTime() const; ///< Get this frame's frame time.
+
+    const bool TriggerDown(int) const; ///< Key went down this frame.
+    const bool TriggerUp(int) const; ///< Key went up this frame.
+    const bool Down(int) const; ///< Key is down.
+
+    const bool IsConnected() const; ///< Controller is connected.
+    const float GetLTrigger() const; ///< Controller left trigger.
+    const float GetRTrigger() const; ///< Controller right trigger.
+    const Vector2& GetRThumb() const; ///< Controller right thumbstick.
+    const bool GetButtonRSToggle() const; ///< Right shoulder button toggled.
+    const bool GetButtonXToggle() const; ///< X button toggled.
+    const bool GetButtonYToggle() const; ///< Y button toggled.
+    const bool GetButtonAToggle() const; ///< A button toggled.
+    const bool GetButtonBToggle() const; ///< B button toggled.
+    const bool GetDPadRight() const; ///< D-pad right is down.
+    const bool GetDPadLeft() const; ///< D-pad left is down.
+    const bool GetDPadUp() const; ///< D-pad up is down.
+    const bool GetDPadDown() const; ///< D-pad down is down.
+}; //CInput
+
+#endif //__L4RC_GAME_INPUT_H__
@@ -0,0 +1,355 @@
+/// \file JobSystem.cpp
+/// \brief Code for the job system CJobSystem.
+
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+
+thread_local UINT CJobSystem::m_nThisThread = 0;
+
+/// Make a queue for each thread and start the worker threads. The main
+/// thread is thread 0 and runs jobs while it waits.
+/// \param n Number of threads including the main thread, or 0 for one per
+/// hardware thread (defaults to 0).
+
+CJobSystem::CJobSystem(UINT n){
+  if(n == 0)n = std::thread::hardware_concurrency();
+  n = std::max(1u, n); //need at least the main thread
+
+  for(UINT i=0; i<n; i++)
+    m_vecQueues.push_back(std::make_unique<SQueue>());
+
+  for(UINT i=1; i<n; i++)
+    m_vecThreads.emplace_back(&CJobSystem::WorkerThread, this, i);
+
+  m_tFrameStart = std::chrono::steady_clock::now();
+} //constructor
+
+/// Tell the worker threads to quit and wait for them to do so.
+
+CJobSystem::~CJobSystem(){
+  { std::lock_guard<std::mutex> lock(m_mutexSleep);
+    m_bQuit = true;
+  } //lock
+
+  m_cvWake.notify_all();
+
+  for(std::thread& t: m_vecThreads)
+    t.join();
+} //destructor
+
+/// A worker thread runs jobs until there are none, then sleeps until there
+/// are some more.
+/// \param i Thread index.
+
+void CJobSystem::WorkerThread(UINT i){
+  m_nThisThread = i;
+
+  while(!m_bQuit){
+    SJob* pJob = Pop();
+
+    if(pJob)Execute(pJob);
+
+    else{ //nothing to do, so sleep
+      std::unique_lock<std::mutex> lock(m_mutexSleep);
+      m_cvWake.wait(lock, [&](){return m_bQuit || m_nReady > 0;});
+    } //else
+  } //while
+} //WorkerThread
+
+/// Put a ready job at the back of this thread's queue, or in the main thread
+/// queue if it must run on the main thread, and wake up a sleeping worker.
+/// \param pJob Pointer to a job.
+
+void CJobSystem::Push(SJob* pJob){
+  if(pJob->m_bMainThread){ //main thread only
+    std::lock_guard<std::mutex> lock(m_qMainThread.m_mutex);
+    m_qMainThread.m_deque.push_back(pJob);
+    return; //workers can't help with this one
+  } //if
+
+  SQueue* q = m_vecQueues[m_nThisThread].get(); //this thread's queue
+
+  { std::lock_guard<std::mutex> lock(q->m_mutex);
+    q->m_deque.push_back(pJob);
+  } //lock
+
+  { std::lock_guard<std::mutex> lock(m_mutexSleep); //so the wakeup isn't lost
+    m_nReady++;
+  } //lock
+
+  m_cvWake.notify_one();
+} //Push
+
+/// Get a ready job for this thread. The main thread looks in the main thread
+/// queue first. Then a thread looks at the back of its own queue, which has
+/// the job it pushed most recently. If that's empty it steals from the front
+/// of the other threads' queues, which have their oldest jobs.
+/// \return Pointer to a job, or `nullptr` if there are none.
+
+SJob* CJobSystem::Pop(){
+  if(m_nThisThread == 0){ //main thread
+    std::lock_guard<std::mutex> lock(m_qMainThread.m_mutex);
+
+    if(!m_qMainThread.m_deque.empty()){
+      SJob* pJob = m_qMainThread.m_deque.front();
+      m_qMainThread.m_deque.pop_front();
+      return pJob;
+    } //if
+  } //if
+
+  const size_t n = m_vecQueues.size(); //number of queues
+
+  for(size_t k=0; k<n; k++){ //own queue first, then the others
+    SQueue* q = m_vecQueues[(m_nThisThread + k)%n].get();
+    std::lock_guard<std::mutex> lock(q->m_mutex);
+
+    if(!q->m_deque.empty()){
+      SJob* pJob = nullptr;
+
+      if(k == 0){ //own queue, take newest
+        pJob = q->m_deque.back();
+        q->m_deque.pop_back();
+      } //if
+
+      else{ //steal oldest
+        pJob = q->m_deque.front();
+        q->m_deque.pop_front();
+      } //else
+
+      m_nReady--;
+      return pJob;
+    } //if
+  } //for
+
+  return nullptr;
+} //Pop
+
+/// Run a job, time it, and push any dependents that were only waiting for
+/// this job. The last dependency of a job to finish is remembered so that
+/// the critical path can be traced back from the end of the frame. A
+/// dependent can finish, and whoever was waiting for it can move on, before
+/// this job is marked done, so the number of calls still in here is counted
+/// for `EndFrame()` to wait on before it frees the jobs.
+/// \param pJob Pointer to a job.
+
+void CJobSystem::Execute(SJob* pJob){
+  m_nExecuting++;
+
+  pJob->m_nThread = m_nThisThread;
+  pJob->m_fStart = Now();
+  pJob->m_fnTask();
+  pJob->m_fEnd = Now();
+
+  for(SJob* pNext: pJob->m_vecNext)
+    if(--pNext->m_nWaitingOn == 0){ //this was the last dependency
+      pNext->m_pCritical = pJob;
+      Push(pNext);
+    } //if
+
+  pJob->m_bDone = true;
+  m_nExecuting--; //must be the last thing to happen here
+} //Execute
+
+/// Get the time since the start of the frame.
+/// \return Time in milliseconds.
+
+const float CJobSystem::Now() const{
+  const auto t = std::chrono::steady_clock::now() - m_tFrameStart;
+  return std::chrono::duration<float, std::milli>(t).count();
+} //Now
+
+/// Create a job for this frame. It won't run until it has been kicked or
+/// all of the jobs it depends on are done.
+/// \param name Job name.
+/// \param f What the job does.
+/// \param bMainThread Must run on the main thread (defaults to false).
+/// \return Pointer to the job.
+
+SJob* CJobSystem::Create(const char* name, const std::function<void()>& f,
+  bool bMainThread)
+{
+  std::lock_guard<std::mutex> lock(m_mutexJobs);
+  m_dequeJobs.emplace_back(); //deque, so pointers stay valid
+
+  SJob* pJob = &m_dequeJobs.back();
+  pJob->m_strName = name;
+  pJob->m_fnTask = f;
+  pJob->m_bMainThread = bMainThread;
+
+  return pJob;
+} //Create
+
+/// Make one job wait for another. This must be done before either is kicked.
+/// \param pBefore Pointer to the job that must finish first.
+/// \param pAfter Pointer to the job that must wait for it.
+
+void CJobSystem::Depend(SJob* pBefore, SJob* pAfter){
+  pBefore->m_vecNext.push_back(pAfter);
+  pAfter->m_nWaitingOn++;
+} //Depend
+
+/// Start a job that doesn't depend on any other jobs. The jobs that depend on
+/// it will start by themselves when it is done.
+/// \param pJob Pointer to a job.
+
+void CJobSystem::Kick(SJob* pJob){
+  if(pJob->m_nWaitingOn == 0)
+    Push(pJob);
+} //Kick
+
+/// Run other jobs until a job is done, so that waiting threads do some of
+/// the work instead of just blocking.
+/// \param pJob Pointer to the job to wait for.
+
+void CJobSystem::Wait(SJob* pJob){
+  while(!pJob->m_bDone){
+    SJob* pOther = Pop();
+
+    if(pOther)Execute(pOther);
+    else std::this_thread::yield();
+  } //while
+} //Wait
+
+/// Get the number of chunks that `ParallelFor()` will split a loop into,
+/// which is one per thread but no more than will give each chunk at least
+/// `grain` items.
+/// \param n Number of items.
+/// \param grain Minimum number of items per chunk.
+/// \return Number of chunks.
+
+const size_t CJobSystem::GetNumChunks(size_t n, size_t grain) const{
+  return std::max<size_t>(1,
+    std::min(GetNumThreads(), n/std::max<size_t>(1, grain)));
+} //GetNumChunks
+
+/// Split a loop over `n` items into contiguous chunks, run the chunks as
+/// jobs, and wait for them all. There are `m = GetNumChunks(n, grain)`
+/// chunks, and chunk `k` covers items `k*n/m` up to but not including
+/// `(k + 1)*n/m`. The chunk number is passed to the function so that the
+/// caller can keep per-chunk results and combine them in chunk order.
+/// \param name Job name.
+/// \param n Number of items.
+/// \param grain Minimum number of items per chunk.
+/// \param f Function that takes a chunk number and a half-open item range.
+
+void CJobSystem::ParallelFor(const char* name, size_t n, size_t grain,
+  const std::function<void(size_t, size_t, size_t)>& f)
+{
+  const size_t m = GetNumChunks(n, grain); //number of chunks
+
+  if(m == 1){ //not worth splitting
+    f(0, 0, n);
+    return;
+  } //if
+
+  std::vector<SJob*> vecJobs(m);
+
+  for(size_t k=0; k<m; k++){
+    const size_t i0 = k*n/m; //start of chunk
+    const size_t i1 = (k + 1)*n/m; //one past end of chunk
+    vecJobs[k] = Create(name, [=, &f](){f(k, i0, i1);});
+  } //for
+
+  for(SJob* pJob: vecJobs)Kick(pJob);
+  for(SJob* pJob: vecJobs)Wait(pJob);
+} //ParallelFor
+
+/// Start timing a frame. Job times are measured from here.
+
+void CJobSystem::BeginFrame(){
+  m_tFrameStart = std::chrono::steady_clock::now();
+} //BeginFrame
+
+/// Copy the timings of this frame's jobs and mark the ones on the critical
+/// path, which is found by starting at the job that finished last and
+/// following each job back to the dependency that finished last. Then free
+/// the jobs. All of the frame's jobs must be done, but the threads that ran
+/// them may still be finishing up, so wait for them first.
+
+void CJobSystem::EndFrame(){
+  while(m_nExecuting > 0) //a thread is still releasing a job's dependents
+    std::this_thread::yield();
+
+  std::lock_guard<std::mutex> lock(m_mutexJobs);
+
+  m_vecTimings.clear();
+  m_fCriticalPath = 0;
+
+  SJob* pLast = nullptr; //job that finished last
+
+  for(SJob& job: m_dequeJobs)
+    if(pLast == nullptr || job.m_fEnd > pLast->m_fEnd)
+      pLast = &job;
+
+  for(SJob* p=pLast; p; p=p->m_pCritical){
+    m_fCriticalPath += p->m_fEnd - p->m_fStart;
+    p->m_bCritical = true;
+  } //for
+
+  for(SJob& job: m_dequeJobs){
+    SJobTiming t;
+    t.m_strName = job.m_strName;
+    t.m_fStart = job.m_fStart;
+    t.m_fEnd = job.m_fEnd;
+    t.m_nThread = job.m_nThread;
+    t.m_bCritical = job.m_bCritical;
+    m_vecTimings.push_back(t);
+  } //for
+
+  m_dequeJobs.clear();
+} //EndFrame
+
+/// Reader function for the number of threads.
+/// \return Number of threads, including the main thread.
+
+const size_t CJobSystem::GetNumThreads() const{
+  return m_vecQueues.size();
+} //GetNumThreads
+
+/// Reader function for last frame's job timings.
+/// \return Timings of last frame's jobs in the order they were created.
+
+const std::vector<SJobTiming>& CJobSystem::GetTimings() const{
+  return m_vecTimings;
+} //GetTimings
+
+/// Reader function for the length of last frame's critical path, which is
+/// the sum of the run times of the jobs on it.
+/// \return Critical path length in milliseconds.
+
+const float CJobSystem::GetCriticalPath() const{
+  return m_fCriticalPath;
+} //GetCriticalPath
+
+/// Describe last frame's critical path, one job at a time in the order that
+/// they ran, with the run time of each.
+/// \return Critical path as text.
+
+std::string CJobSystem::GetCriticalPathText() const{
+  return FormatCriticalPath(m_vecTimings, m_fCriticalPath);
+} //GetCriticalPathText
+
+/// Describe a critical path from a copy of the job timings, so that it can
+/// be done on a thread other than the one that ran the jobs.
+/// \param vecTimings Job timings.
+/// \param fLength Critical path length in milliseconds.
+/// \return Critical path as text.
+
+std::string CJobSystem::FormatCriticalPath(const std::vector<SJobTiming>& vecTimings,
+  float fLength)
+{
+  std::string s;
+  char buffer[64];
+
+  for(const SJobTiming& t: vecTimings)
+    if(t.m_bCritical){
+      snprintf(buffer, sizeof(buffer), "%s%s %.2f", s.empty()? "": " > ", t.m_strName,
+        t.m_fEnd - t.m_fStart);
+      s += buffer;
+    } //if
+
+  snprintf(buffer, sizeof(buffer), " = %.2f ms", fLength);
+  return s + buffer;
+} //FormatCriticalPath
@@ -0,0 +1,126 @@
+/// \file JobSystem.h
+/// \brief Interface for the job system CJobSystem.
+
+#ifndef __L4RC_GAME_JOBSYSTEM_H__
+#define __L4RC_GAME_JOBSYSTEM_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Defines.h"
+
+/// \brief A job.
+///
+/// A function call to be run on some thread, together with the jobs that
+/// can't start until it is done. A job becomes ready when all of the jobs
+/// that it depends on are done.
+
+struct SJob{
+  const char* m_strName = ""; ///< Name, for the timings.
+  std::function<void()> m_fnTask; ///< What to do.
+  bool m_bMainThread = false; ///< Must run on the main thread.
+
+  std::atomic<int> m_nWaitingOn{0}; ///< Number of dependencies not yet done.
+  std::atomic<bool> m_bDone{false}; ///< Finished running.
+  std::vector<SJob*> m_vecNext; ///< Jobs that depend on this one.
+  SJob* m_pCritical = nullptr; ///< The dependency that finished last.
+  bool m_bCritical = false; ///< Is on the critical path.
+
+  float m_fStart = 0; ///< Start time in milliseconds since start of frame.
+  float m_fEnd = 0; ///< End time in milliseconds since start of frame.
+  UINT m_nThread = 0; ///< Thread that ran it.
+}; //SJob
+
+/// \brief A job timing.
+///
+/// How long a job took last frame, and which thread it ran on.
+
+struct SJobTiming{
+  const char* m_strName = ""; ///< Job name.
+  float m_fStart = 0; ///< Start time in milliseconds since start of frame.
+  float m_fEnd = 0; ///< End time in milliseconds since start of frame.
+  UINT m_nThread = 0; ///< Thread that ran it.
+  bool m_bCritical = false; ///< Is on the critical path.
+}; //SJobTiming
+
+/// \brief The job system.
+///
+/// A work-stealing job scheduler. Each thread, including the main thread,
+/// has its own double-ended queue of ready jobs. A thread pushes and pops
+/// jobs at the back of its own queue and, when that runs dry, steals from the
+/// front of somebody else's. Jobs that must run on the main thread go in a
+/// queue of their own that only the main thread looks at. A thread that
+/// waits for a job keeps running other jobs until it is done.
+///
+/// Jobs live for one frame. Build the frame's job graph with `Create()` and
+/// `Depend()`, start it with `Kick()`, wait for it with `Wait()`, then call
+/// `EndFrame()` to record the timings and free the jobs.
+
+class CJobSystem{
+  private:
+    /// \brief A queue of ready jobs.
+
+    struct SQueue{
+      std::mutex m_mutex; ///< Lock.
+      std::deque<SJob*> m_deque; ///< Ready jobs.
+    }; //SQueue
+
+    static thread_local UINT m_nThisThread; ///< Index of this thread.
+
+    std::vector<std::thread> m_vecThreads; ///< Worker threads.
+    std::vector<std::unique_ptr<SQueue>> m_vecQueues; ///< One queue per thread.
+    SQueue m_qMainThread; ///< Jobs that must run on the main thread.
+
+    std::mutex m_mutexJobs; ///< Lock for the job pool.
+    std::deque<SJob> m_dequeJobs; ///< This frame's jobs.
+
+    std::mutex m_mutexSleep; ///< Lock for sleeping workers.
+    std::condition_variable m_cvWake; ///< Wakes sleeping workers.
+    std::atomic<int> m_nReady{0}; ///< Number of jobs in the queues.
+    std::atomic<int> m_nExecuting{0}; ///< Number of calls to `Execute()` not yet returned.
+    std::atomic<bool> m_bQuit{false}; ///< Workers should exit.
+
+    std::chrono::steady_clock::time_point m_tFrameStart; ///< Start of frame.
+    std::vector<SJobTiming> m_vecTimings; ///< Last frame's job timings.
+    float m_fCriticalPath = 0; ///< Last frame's critical path length in ms.
+
+    void WorkerThread(UINT); ///< Worker thread loop.
+    void Push(SJob*); ///< Add a ready job to a queue.
+    SJob* Pop(); ///< Get a ready job for this thread.
+    void Execute(SJob*); ///< Run a job and release its dependents.
+    const float Now() const; ///< Milliseconds since start of frame.
+
+  public:
+    CJobSystem(UINT=0); ///< Constructor.
+    ~CJobSystem(); ///< Destructor.
+
+    SJob* Create(const char*, const std::function<void()>&, bool=false); ///< Create a job.
+    void Depend(SJob*, SJob*); ///< Make one job wait for another.
+    void Kick(SJob*); ///< Start a job that has no dependencies.
+    void Wait(SJob*); ///< Run jobs until a job is done.
+
+    const size_t GetNumChunks(size_t, size_t) const; ///< Number of chunks for parallel for.
+    void ParallelFor(const char*, size_t, size_t,
+      const std::function<void(size_t, size_t, size_t)>&); ///< Parallel for loop.
+
+    void BeginFrame(); ///< Start timing a frame.
+    void EndFrame(); ///< Record timings and free the frame's jobs.
+
+    const size_t GetNumThreads() const; ///< Number of threads, including main.
+    const std::vector<SJobTiming>& GetTimings() const; ///< Last frame's timings.
+    const float GetCriticalPath() const; ///< Last frame's critical path.
+    std::string GetCriticalPathText() const; ///< Critical path as text.
+
+    static std::string FormatCriticalPath(const std::vector<SJobTiming>&,
+      float); ///< Critical path as text.
+}; //CJobSystem
+
+#endif //__L4RC_GAME_JOBSYSTEM_H__
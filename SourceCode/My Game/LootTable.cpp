@@ -0,0 +1,121 @@
+/// \file LootTable.cpp
+/// \brief Code for the loot tables CLootTable.
+
+#include "LootTable.h"
+#include "Settings.h"
+
+#include <algorithm>
+#include <cstring>
+
+SLootTable CLootTable::m_sTable[(UINT)eLoot::Size];
+
+/// Set a loot table and build its alias table.
+/// \param e Enemy type.
+/// \param vecItems Items and their weights, `eSprite::Size` for nothing.
+/// \param fGhost Probability of spawning a ghost.
+
+void CLootTable::Set(eLoot e, const std::vector<std::pair<eSprite, float>>& vecItems,
+  float fGhost)
+{
+  SLootTable& t = m_sTable[(UINT)e]; //shorthand
+  std::vector<float> w; //weights
+
+  t.m_vecItems.clear();
+
+  for(const auto& p: vecItems){
+    t.m_vecItems.push_back(p.first);
+    w.push_back(p.second);
+  } //for
+
+  t.m_cAlias.Build(w);
+  t.m_fGhostChance = fGhost;
+} //Set
+
+/// Set the default loot tables, then replace any that are given in the
+/// `loot` tag of `gamesettings.xml`. Each `table` tag names an enemy type
+/// and gives the chance of a ghost, and has a `drop` tag for each item with
+/// the item's sprite name, or `none` for nothing, and its weight. Only the
+/// power-ups can be dropped, so any other sprite name is ignored.
+/// \param pSettings Pointer to the settings tag.
+/// \param vecSprites Sprite types and their names in `gamesettings.xml`.
+
+void CLootTable::Load(tinyxml2::XMLElement* pSettings,
+  const std::vector<std::pair<eSprite, const char*>>& vecSprites)
+{
+  Set(eLoot::Ant, {
+    {eSprite::Health, 2}, {eSprite::HealthUp, 2}, {eSprite::StaminaUp, 1},
+    {eSprite::FocusUp, 1}, {eSprite::MovementSpeedUp, 2}, {eSprite::Size, 12}
+  }, 0.5f); //ant defaults
+
+  for(eLoot e: {eLoot::Turret, eLoot::MGTurret})
+    Set(e, {
+      {eSprite::Health, 3}, {eSprite::HealthUp, 3}, {eSprite::StaminaUp, 2},
+      {eSprite::FocusUp, 3}, {eSprite::MovementSpeedUp, 3}, {eSprite::DamageUp, 1},
+      {eSprite::Size, 5}
+    }, 0.5f); //turret defaults
+
+  if(pSettings == nullptr)return; //no settings, use defaults
+
+  tinyxml2::XMLElement* pLoot = pSettings->FirstChildElement("loot");
+  if(pLoot == nullptr)return; //no loot tag, use defaults
+
+  const char* names[] = {"ant", "turret", "mgturret"}; //table names
+
+  const eSprite droppable[] = { //power-ups that an enemy can drop
+    eSprite::Health, eSprite::HealthUp, eSprite::StaminaUp,
+    eSprite::FocusUp, eSprite::MovementSpeedUp, eSprite::DamageUp
+  }; //droppable
+
+  for(UINT i=0; i<(UINT)eLoot::Size; i++){ //for each enemy type
+    tinyxml2::XMLElement* pTable = pLoot->FirstChildElement("table");
+
+    while(pTable && pTable->Attribute("name", names[i]) == nullptr)
+      pTable = pTable->NextSiblingElement("table"); //find its tag
+
+    if(pTable == nullptr)continue; //not listed, keep the default
+
+    std::vector<std::pair<eSprite, float>> vecItems; //items and weights
+
+    for(tinyxml2::XMLElement* pDrop = pTable->FirstChildElement("drop");
+      pDrop; pDrop = pDrop->NextSiblingElement("drop"))
+    {
+      const char* item = pDrop->Attribute("item");
+      if(item == nullptr)continue; //no item
+
+      eSprite t = eSprite::Size; //none
+
+      if(strcmp(item, "none") != 0){ //look up the sprite name
+        auto it = std::find_if(vecSprites.begin(), vecSprites.end(),
+          [&](const std::pair<eSprite, const char*>& p){return strcmp(p.second, item) == 0;});
+
+        if(it == vecSprites.end() || //unknown sprite
+          std::find(std::begin(droppable), std::end(droppable), it->first) == std::end(droppable))
+          continue; //or not a power-up
+
+        t = it->first;
+      } //if
+
+      vecItems.push_back({t, pDrop->FloatAttribute("weight", 1.0f)});
+    } //for
+
+    Set((eLoot)i, vecItems, pTable->FloatAttribute("ghost", 0.0f));
+  } //for
+} //Load
+
+/// Pick what an enemy drops when it dies. The item comes from the enemy
+/// type's alias table, and then a ghost is rolled for separately. A table
+/// with no items, or whose weights are all zero, drops nothing.
+/// \param e Enemy type.
+/// \param rng Random number generator.
+/// \return The drop.
+
+SDrop CLootTable::Roll(eLoot e, CCounterRng& rng){
+  const SLootTable& t = m_sTable[(UINT)e]; //shorthand
+  SDrop d;
+
+  if(!t.m_cAlias.empty())
+    d.m_eItem = t.m_vecItems[t.m_cAlias.Sample(rng)];
+
+  d.m_bGhost = rng.Float() < t.m_fGhostChance;
+  return d;
+} //Roll
@@ -0,0 +1,64 @@
+/// \file LootTable.h
+/// \brief Interface for the loot tables CLootTable.
+
+#ifndef __L4RC_GAME_LOOTTABLE_H__
+#define __L4RC_GAME_LOOTTABLE_H__
+
+#include "GameDefines.h"
+#include "AliasTable.h"
+#include "Rng.h"
+
+#include <utility>
+#include <vector>
+
+namespace tinyxml2{class XMLElement;}
+
+/// \brief Loot table enumerated type.
+///
+/// The enemy types that drop loot, one table each. `Size` is the number of
+/// tables.
+
+enum class eLoot{
+  Ant, Turret, MGTurret, Size
+}; //eLoot
+
+/// \brief A drop.
+///
+/// What an enemy leaves behind when it dies.
+
+struct SDrop{
+  eSprite m_eItem = eSprite::Size; ///< Power-up, or `eSprite::Size` for none.
+  bool m_bGhost = false; ///< Spawn a ghost, if there aren't too many already.
+}; //SDrop
+
+/// \brief A loot table.
+///
+/// The items that an enemy type may drop, with their weights.
+
+struct SLootTable{
+  std::vector<eSprite> m_vecItems; ///< Items, `eSprite::Size` for nothing.
+  CAliasTable m_cAlias; ///< Alias table over the item weights.
+  float m_fGhostChance = 0; ///< Probability of spawning a ghost.
+}; //SLootTable
+
+/// \brief The loot tables.
+///
+/// One loot table per enemy type, read from the `loot` tag in
+/// `gamesettings.xml` once at startup and compiled into alias tables, so
+/// that a drop costs the same however many items a table has, and changing
+/// the odds doesn't need a rebuild. Tables that are missing from the
+/// settings keep built-in defaults.
+
+class CLootTable{
+  private:
+    static SLootTable m_sTable[(UINT)eLoot::Size]; ///< Loot tables indexed by enemy type.
+
+    static void Set(eLoot, const std::vector<std::pair<eSprite, float>>&, float); ///< Set a table.
+
+  public:
+    static void Load(tinyxml2::XMLElement*,
+      const std::vector<std::pair<eSprite, const char*>>&); ///< Load tables from settings.
+    static SDrop Roll(eLoot, CCounterRng&); ///< Pick a drop.
+}; //CLootTable
+
+#endif //__L4RC_GAME_LOOTTABLE_H__
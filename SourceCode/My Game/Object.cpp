@@ -1,177 +1,369 @@
-/// \file Object.cpp
-/// \brief Code for the game object class CObject.
-
-#include "Object.h"
-#include "ComponentIncludes.h"
-#include "GameDefines.h"
-#include "Particle.h"
-#include "ParticleEngine.h"
-#include "Helpers.h"
-
-/// Create and initialize an object given its sprite type and initial position.
-/// \param t Type of sprite.
-/// \param p Initial position of object.
-
-CObject::CObject(eSprite t, const Vector2& p):
-  LBaseObject(t, p)
-{ 
-  if (t != eSprite::Door)m_fRoll = XM_PIDIV2; //facing upwards everything except for doors
-  m_bIsTarget = false; //not a target
-
-  const float w = m_pRenderer->GetWidth(t); //sprite width
-  const float h = m_pRenderer->GetHeight(t); //sprite height
-  m_fRadius = std::max(w, h)/2; //bounding circle radius
-
-  m_pGunFireEvent = new LEventTimer(1.0f); //timer for firing gun
-} //constructor
-
-/// Destructor.
-
-CObject::~CObject(){
-  delete m_pGunFireEvent;
-} //destructor
-
-/// Move object an amount that depends on its velocity and the frame time.
-
-void CObject::move(){
-  if(!m_bDead && !m_bStatic)
-    m_vPos += m_vVelocity*m_pTimer->GetFrameTime();
-} //move
-
-/// Ask the renderer to draw the sprite described in the sprite descriptor.
-/// Note that `CObject` is derived from `LBaseObject` which is inherited from
-/// `LSpriteDesc2D`. Therefore `LSpriteRenderer::Draw(const LSpriteDesc2D*)`
-/// will accept `this` as a parameter, automatically down-casting it from
-/// `CObject*` to `LSpriteDesc2D*`, effectively drawing the object from its
-/// sprite descriptor.
-
-void CObject::draw(){ 
-  m_pRenderer->Draw(this);
-} //draw
-
-/// Response to collision. Move back the overlap distance along the collision
-/// normal. 
-/// \param norm Collision normal.
-/// \param d Overlap distance.
-/// \param pObj Pointer to object being collided with (defaults to `nullptr`,
-/// which means collision with a wall).
-
-void CObject::CollisionResponse(const Vector2& norm, float d, CObject* pObj){
-  if(m_bDead)return; //dead, bail out
-
-  const Vector2 vOverlap = d*norm; //overlap in direction of this
-  const bool bStatic = !pObj || pObj->m_bStatic; //whether other object is static
-
-  if(!m_bStatic && !bStatic) //both objects are dynamic
-        m_vPos += vOverlap/2; //back off this object by half
-
-  else if(!m_bStatic && bStatic) //only this object is dynamic
-        m_vPos += vOverlap; //back off this object
-} //CollisionResponse
-
-/// Create a particle effect to mark the death of the object.
-/// This function is a stub intended to be overridden by various object classes
-/// derived from this class.
-
-void CObject::DeathFX(){
- //stub
-} //DeathFX
-
-/// Compute the view vector from the object orientation.
-/// \return The view vector.
-
-const Vector2 CObject::GetViewVector() const
-{
-    return AngleToVector(m_fRoll);
-} //ViewVector
-
-// Reader function for PowerUp flags.
-// is a powerup
-const bool CObject::isPowerUp() const
-{
-    return m_bIsPowerUp;
-}
-
-// For health pickup
-const bool CObject::isHealth() const 
-{
-    return m_bIsHealth;
-}
-
-//increase max Health pickup
-const bool CObject::isHealthUp() const
-{
-    return m_bIsHealthUp;
-}
-
-//increase max Stamina pickup
-const bool CObject::isStaminaUp() const
-{
-    return m_bIsStaminaUp;
-}
-
-//increase max Focus pickup
-const bool CObject::isFocusUp() const
-{
-    return m_bIsFocusUp;
-}
-
-//increase Movement Speed pickup
-const bool CObject::isMovementSpeedUp() const
-{
-    return m_bIsMovementSpeedUp;
-}
-
-//increase Damage pickup
-const bool CObject::isDamageUp() const
-{
-    return m_bIsDamageUp;
-}
-
-/// Reader function for bullet flags.
-/// \return true if a bullet.
-const bool CObject::isBullet() const
-{
-    return m_bIsBullet;
-} //isBullet
-
-const bool CObject::isPlayerBullet() const 
-{
-    return m_bIsPlayerBullet;
-} //isPlayerBullet
-
-const bool CObject::isEnemyBullet() const
-{
-    return m_bIsEnemyBullet;
-} //isEnemyBullet
-
-// Reader function for creature flags.
-const bool CObject::isPlayer() const 
-{
-    return m_bIsPlayer;
-} //isPlayer
-
-const bool CObject::isAnt() const 
-{
-    return m_bIsAnt;
-} //isAnt
-
-const bool CObject::isTurret() const
-{
-    return m_bIsTurret;
-} //isTurret
-
-const bool CObject::isAnimalControlOfficer() const 
-{
-    return m_bIsAnimalControlOfficer;
-} //isAnimalControlOfficer
-
-const bool CObject::isBossTurret() const 
-{
-    return m_bIsBossTurret;
-} //isAnimalControlOfficer
-
-const bool CObject::isGhost() const 
-{
-    return m_bIsGhost;
+/// \file Object.cpp
+/// \brief Code for the game object class CObject.
+
+#include "Object.h"
+#include "ComponentIncludes.h"
+#include "GameDefines.h"
+#include "Particle.h"
+#include "ParticleEngine.h"
+#include "Helpers.h"
+#include "Archetype.h"
+#include "ObjectManager.h"
+#include "RenderThread.h"
+#include "Rng.h"
+
+/// Create and initialize an object given its sprite type and initial
+/// position. The object is added to the object manager first, so that it has
+/// a body for the rest of this constructor and the derived class's to set up.
+/// \param t Type of sprite.
+/// \param p Initial position of object.
+
+CObject::CObject(eSprite t, const Vector2& p):
+  LBaseObject(t, p)
+{ 
+  m_pObjectManager->Add(this); //body starts at p
+
+  if (t != eSprite::Door)Roll() = XM_PIDIV2; //facing upwards everything except for doors
+
+  const SArchetype& a = CArchetypeTable::Get(t); //precomputed properties
+  Radius() = a.m_fRadius; //bounding circle radius
+  m_fXScale = m_fYScale = a.m_fScale; //scale
+  m_bStatic = a.m_bStatic; //static or dynamic
+  Velocity() = a.m_vVelocity; //initial velocity
+  m_eLayer = a.m_eLayer; //draw layer
+
+  m_vPrevPos = Pos(); //nothing to interpolate from yet
+  m_fPrevRoll = Roll();
+
+  m_cRng = m_pRng->Split(eRngStream::Objects); //objects are created in the same order every time
+
+  m_pGunFireEvent = new CSimTimer(1.0f); //timer for firing gun
+} //constructor
+
+/// Destructor.
+
+CObject::~CObject(){
+  delete m_pGunFireEvent;
+  if(m_pFrameBudget)m_pFrameBudget->Cancel(this); //throw away tasks that use this
+} //destructor
+
+/// Move object an amount that depends on its velocity and the simulation
+/// time step.
+
+void CObject::move(){
+  if(!m_bDead && !m_bStatic)
+    Pos() += Velocity()*m_fSimStep;
+} //move
+
+/// Get a reference to this object's position in the object manager's body
+/// array. The body accessors all look the object up afresh, since creating
+/// an object may move the arrays, so a reference that they return must not
+/// be held across anything that might create one.
+/// \return Reference to the position.
+
+Vector2& CObject::Pos(){
+  return m_pObjectManager->m_cBodies.m_vecPos[m_nIndex];
+} //Pos
+
+/// Get a reference to this object's velocity in the body array.
+/// \return Reference to the velocity.
+
+Vector2& CObject::Velocity(){
+  return m_pObjectManager->m_cBodies.m_vecVelocity[m_nIndex];
+} //Velocity
+
+/// Get a reference to this object's orientation in the body array.
+/// \return Reference to the orientation.
+
+float& CObject::Roll(){
+  return m_pObjectManager->m_cBodies.m_vecRoll[m_nIndex];
+} //Roll
+
+/// Get a reference to this object's rotational speed in the body array.
+/// \return Reference to the rotational speed.
+
+float& CObject::RotSpeed(){
+  return m_pObjectManager->m_cBodies.m_vecRotSpeed[m_nIndex];
+} //RotSpeed
+
+/// Get a reference to this object's speed in the body array.
+/// \return Reference to the speed.
+
+float& CObject::Speed(){
+  return m_pObjectManager->m_cBodies.m_vecSpeed[m_nIndex];
+} //Speed
+
+/// Get a reference to this object's bounding circle radius in the body array.
+/// \return Reference to the radius.
+
+float& CObject::Radius(){
+  return m_pObjectManager->m_cBodies.m_vecRadius[m_nIndex];
+} //Radius
+
+/// Reader function for position.
+/// \return Position.
+
+const Vector2& CObject::GetPos() const{
+  return m_pObjectManager->m_cBodies.m_vecPos[m_nIndex];
+} //GetPos
+
+/// Reader function for orientation.
+/// \return Orientation.
+
+const float CObject::GetRoll() const{
+  return m_pObjectManager->m_cBodies.m_vecRoll[m_nIndex];
+} //GetRoll
+
+/// Get a copy of the sprite descriptor to draw. Note that `CObject` is
+/// derived from `LBaseObject` which is inherited from `LSpriteDesc2D`. This
+/// is the only place that the position and orientation in the body array
+/// are written into a sprite descriptor. The simulation runs at a fixed rate that is
+/// usually different from the frame rate, so they are interpolated between
+/// the last two simulation steps.
+/// \return Interpolated sprite descriptor.
+
+const LSpriteDesc2D CObject::GetDrawDesc() const{
+  LSpriteDesc2D desc(*this); //copy of sprite descriptor
+
+  float dr = GetRoll() - m_fPrevRoll; //change in orientation
+  NormalizeAngle(dr); //the short way round
+
+  desc.m_vPos = GetDrawPos();
+  desc.m_fRoll = m_fPrevRoll + m_fSimAlpha*dr;
+
+  return desc;
+} //GetDrawDesc
+
+/// Get the position to draw at, which is interpolated between the positions
+/// at the start and end of the last simulation step.
+/// \return Interpolated position.
+
+const Vector2 CObject::GetDrawPos() const{
+  return Vector2::Lerp(m_vPrevPos, GetPos(), m_fSimAlpha);
+} //GetDrawPos
+
+/// Response to collision. Move back the overlap distance along the collision
+/// normal. 
+/// \param norm Collision normal.
+/// \param d Overlap distance.
+/// \param pObj Pointer to object being collided with (defaults to `nullptr`,
+/// which means collision with a wall).
+
+void CObject::CollisionResponse(const Vector2& norm, float d, CObject* pObj){
+  if(m_bDead)return; //dead, bail out
+
+  const Vector2 vOverlap = d*norm; //overlap in direction of this
+  const bool bStatic = !pObj || pObj->m_bStatic; //whether other object is static
+
+  if(!m_bStatic && !bStatic) //both objects are dynamic
+        Pos() += vOverlap/2; //back off this object by half
+
+  else if(!m_bStatic && bStatic) //only this object is dynamic
+        Pos() += vOverlap; //back off this object
+} //CollisionResponse
+
+/// Flag the object as dead and tell the object manager about it, so that
+/// the manager can reclaim it at the end of the frame without having to
+/// search the object list for dead objects. Killing a dead object does
+/// nothing.
+
+void CObject::Kill(){
+  if(m_bDead)return; //already dead, bail out
+
+  m_bDead = true; //flag for deletion from object list
+
+  CEffectQueue::Post([this](){ //the dead list is shared
+    m_pObjectManager->m_vecDead.push_back(this); //reclaim at end of frame
+  });
+} //Kill
+
+/// Play a sound. The audio player is shared, so if this is called from a
+/// worker thread then the sound is queued until the effect queues are flushed.
+/// \param t Sound type.
+
+void CObject::PlaySound(eSound t) const{
+  CEffectQueue::Post([=](){m_pAudio->play(t);});
+} //PlaySound
+
+/// Create a particle. It goes into the world snapshot being filled in, which
+/// is shared, so if this is called from a worker thread then the particle is
+/// queued until the effect queues are flushed. Particles are only for show,
+/// so they are created at low priority when there is time in the frame.
+/// \param d Particle descriptor.
+
+void CObject::SpawnParticle(const LParticleDesc2D& d) const{
+  PostDeferrable(eTaskPriority::Low, [=](){m_pRenderThread->SpawnParticle(d);});
+} //SpawnParticle
+
+/// Create a burst of particles flying out in random directions at random
+/// speeds. The random numbers for the whole burst are drawn in bulk, and the
+/// particles are created together at low priority.
+/// \param d Particle descriptor, whose velocity is added to each particle's.
+/// \param n Number of particles.
+/// \param fSpeed Fastest speed, the slowest being half of it.
+
+void CObject::SpawnBurst(const LParticleDesc2D& d, UINT n, float fSpeed) const{
+  std::vector<float> r(2*n); //angle and speed for each particle
+  Random(eRngPurpose::Particle).Fill(r.data(), r.size());
+
+  PostDeferrable(eTaskPriority::Low, [=](){
+    LParticleDesc2D p = d; //particle descriptor
+
+    for(UINT i=0; i<n; i++){
+      const float s = fSpeed*(0.5f + 0.5f*r[2*i + 1]); //speed
+      p.m_vVel = d.m_vVel + s*AngleToVector(XM_2PI*r[2*i]);
+      m_pRenderThread->SpawnParticle(p);
+    } //for
+  }); //PostDeferrable
+} //SpawnBurst
+
+/// Get a generator keyed by this object's ID, the current simulation step,
+/// and a purpose. Its numbers depend on nothing else, so they are the same
+/// no matter which thread this object is moved on, what order the objects
+/// are moved in, or how many random numbers it used before. Asking twice
+/// for the same purpose on the same step gives the same numbers.
+/// \param e Purpose.
+/// \return The keyed generator.
+
+CCounterRng CObject::Random(eRngPurpose e) const{
+  return m_pRng->Keyed(m_nID, m_nSimSteps, e);
+} //Random
+
+/// Post work that can slip a frame to the frame budget manager. This may be
+/// called while moving on a worker thread, in which case the posting itself
+/// is captured in the effect queue. Work that uses the object must say so,
+/// so that it is thrown away if the object is deleted first. Work that
+/// doesn't use the object, such as the particles for its death, is done
+/// even if it is deleted.
+/// \param p Priority.
+/// \param f Function call that does the work.
+/// \param bUsesThis true if the work uses this object.
+
+void CObject::PostDeferrable(eTaskPriority p, const std::function<void()>& f,
+  bool bUsesThis) const
+{
+  const void* pOwner = bUsesThis? this: nullptr; //owner for cancelling
+  CEffectQueue::Post([=](){m_pFrameBudget->Post(p, f, pOwner);});
+} //PostDeferrable
+
+/// Create a particle effect to mark the death of the object.
+/// This function is a stub intended to be overridden by various object classes
+/// derived from this class.
+
+void CObject::DeathFX(){
+ //stub
+} //DeathFX
+
+/// Compute the view vector from the object orientation.
+/// \return The view vector.
+
+const Vector2 CObject::GetViewVector() const
+{
+    return AngleToVector(GetRoll());
+} //ViewVector
+
+/// Set an object flag. Flags are never cleared.
+/// \param f Flag to set.
+
+void CObject::SetFlag(eObjectFlag f){
+  m_nFlags |= (UINT)f;
+} //SetFlag
+
+/// Test an object flag.
+/// \param f Flag to test.
+/// \return true if the flag is set.
+
+const bool CObject::GetFlag(eObjectFlag f) const{
+  return (m_nFlags & (UINT)f) != 0;
+} //GetFlag
+
+// Reader function for PowerUp flags.
+// is a powerup
+const bool CObject::isPowerUp() const
+{
+    return GetFlag(eObjectFlag::PowerUp);
+}
+
+// For health pickup
+const bool CObject::isHealth() const 
+{
+    return GetFlag(eObjectFlag::Health);
+}
+
+//increase max Health pickup
+const bool CObject::isHealthUp() const
+{
+    return GetFlag(eObjectFlag::HealthUp);
+}
+
+//increase max Stamina pickup
+const bool CObject::isStaminaUp() const
+{
+    return GetFlag(eObjectFlag::StaminaUp);
+}
+
+//increase max Focus pickup
+const bool CObject::isFocusUp() const
+{
+    return GetFlag(eObjectFlag::FocusUp);
+}
+
+//increase Movement Speed pickup
+const bool CObject::isMovementSpeedUp() const
+{
+    return GetFlag(eObjectFlag::MovementSpeedUp);
+}
+
+//increase Damage pickup
+const bool CObject::isDamageUp() const
+{
+    return GetFlag(eObjectFlag::DamageUp);
+}
+
+/// Reader function for bullet flags.
+/// \return true if a bullet.
+const bool CObject::isBullet() const
+{
+    return GetFlag(eObjectFlag::Bullet);
+} //isBullet
+
+const bool CObject::isPlayerBullet() const 
+{
+    return GetFlag(eObjectFlag::PlayerBullet);
+} //isPlayerBullet
+
+const bool CObject::isEnemyBullet() const
+{
+    return GetFlag(eObjectFlag::EnemyBullet);
+} //isEnemyBullet
+
+// Reader function for creature flags.
+const bool CObject::isPlayer() const 
+{
+    return GetFlag(eObjectFlag::Player);
+} //isPlayer
+
+const bool CObject::isAnt() const 
+{
+    return GetFlag(eObjectFlag::Ant);
+} //isAnt
+
+const bool CObject::isTurret() const
+{
+    return GetFlag(eObjectFlag::Turret);
+} //isTurret
+
+const bool CObject::isAnimalControlOfficer() const 
+{
+    return GetFlag(eObjectFlag::AnimalControlOfficer);
+} //isAnimalControlOfficer
+
+const bool CObject::isBossTurret() const 
+{
+    return GetFlag(eObjectFlag::BossTurret);
+} //isAnimalControlOfficer
+
+const bool CObject::isGhost() const 
+{
+    return GetFlag(eObjectFlag::Ghost);
 } //isAnimalControlOfficer
\ No newline at end of file
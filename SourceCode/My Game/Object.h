@@ -1,99 +1,164 @@
-/// \file Object.h
-/// \brief Interface for the game object class CObject.
-
-#ifndef __L4RC_GAME_OBJECT_H__
-#define __L4RC_GAME_OBJECT_H__
-
-#include "GameDefines.h"
-#include "SpriteRenderer.h"
-#include "Common.h"
-#include "Component.h"
-#include "SpriteDesc.h"
-#include "BaseObject.h"
-#include "EventTimer.h"
-
-/// \brief The game object. 
-///
-/// The abstract representation of an object. `CObjectManager` is a friend of
-/// this class so that it can access any private members as needed to manage
-/// the objects without the need for reader and set functions for each private
-/// or protected member variable. This class must contain public member
-/// functions `move()` and `draw()` to move and draw the object, respectively.
-
-class CObject:
-  public CCommon,
-  public LBaseObject
-{
-  friend class CObjectManager; ///< Object manager needs access so it can manage.
-
-  protected:
-    float m_fRadius = 0; ///< Bounding circle radius.
-
-    float m_fSpeed = 0; ///< Speed.
-    float m_fRotSpeed = 0; ///< Rotational speed.
-    Vector2 m_vVelocity; ///< Velocity.
-
-
-    bool m_bStatic = true; ///< Is static (does not move).
-    bool m_bIsTarget = true; ///< Is a target.
-
-    //bullet object bools
-    bool m_bIsBullet = false; ///< Is a bullet.
-    bool m_bIsPlayerBullet = false; // used to specify that the bullet is the player's bullet
-    bool m_bIsEnemyBullet = false; // used to specify that the bullet is an enemy's bullet
-
-    //powerup object bools
-    bool m_bIsPowerUp = false; // a powerup
-    bool m_bIsHealth = false; //health pickup
-    bool m_bIsHealthUp = false; //increase max Health pickup
-    bool m_bIsStaminaUp = false;  //increase max Stamina pickup
-    bool m_bIsFocusUp = false;    //increase max Focus pickup
-    bool m_bIsMovementSpeedUp = false;  //increase Movement Speed pickup
-    bool m_bIsDamageUp = false; //increase Damage pickup
-
-    //creature object bools
-    bool m_bIsPlayer = false; ///< Is the player.
-    bool m_bIsAnt = false; ///< Is an ant.
-    bool m_bIsTurret = false; // Is a turret
-    bool m_bIsAnimalControlOfficer = false; ///< Is the animal control officer.
-    bool m_bIsBossTurret = false; ///< Is the boss turret.
-    bool m_bIsGhost = false; ///< Is a ghost.
-
-    LEventTimer* m_pGunFireEvent = nullptr; ///< Gun fire event.
-    
-    virtual void CollisionResponse(const Vector2&, float,
-      CObject* = nullptr); ///< Collision response.
-    virtual void DeathFX(); ///< Death special effects.
-
-    const Vector2 GetViewVector() const; ///< Compute view vector.
-
-  public:
-    CObject(eSprite, const Vector2&); ///< Constructor.
-    virtual ~CObject(); ///< Destructor.
-
-    void move(); ///< Move object.
-    void draw(); ///< Draw object.
-
-    //bullet bool functions
-    const bool isBullet() const; ///< Is a bullet.
-    const bool isPlayerBullet() const; // Is a player's bullet.
-    const bool isEnemyBullet() const; // Is an enemy bullet.
-
-    //powerup bool functions
-    const bool isPowerUp() const; //is a powerup
-    const bool isHealth() const;    //health pickup
-    const bool isHealthUp() const;  //increase max Health pickup
-    const bool isStaminaUp() const; //increase max Stamina pickup
-    const bool isFocusUp() const;   //increase max Focus pickup
-    const bool isMovementSpeedUp() const;   //increase Movement Speed pickup
-    const bool isDamageUp() const;  //increase Damage pickup
-
-    //creature bool functions
-    const bool isPlayer() const; ///< Is the player.
-    const bool isAnt() const; ///< Is an ant.
-    const bool isTurret() const; // Is a turret
-    const bool isAnimalControlOfficer() const; ///< Is the animal control officer.
-    const bool isBossTurret() const; ///< Is the boss turret.
-    const bool isGhost() const; ///< Is a ghost.
-}; //CObject
+/// \file Object.h
+/// \brief Interface for the game object class CObject.
+
+#ifndef __L4RC_GAME_OBJECT_H__
+#define __L4RC_GAME_OBJECT_H__
+
+#include "GameDefines.h"
+#include "SpriteRenderer.h"
+#include "Common.h"
+#include "Component.h"
+#include "SpriteDesc.h"
+#include "BaseObject.h"
+#include "SimTimer.h"
+#include "Particle.h"
+#include "EffectQueue.h"
+#include "FrameBudget.h"
+#include "Rng.h"
+
+/// \brief Object flag enumerated type.
+///
+/// Bit flags saying what kind of object this is. They are set once in the
+/// constructor and only read after that, so they are packed into a single
+/// word instead of taking up a bool each.
+
+enum class eObjectFlag: UINT{
+  Target = 1 << 0, ///< Is a target.
+
+  Bullet       = 1 << 1, ///< Is a bullet.
+  PlayerBullet = 1 << 2, ///< Is the player's bullet.
+  EnemyBullet  = 1 << 3, ///< Is an enemy's bullet.
+
+  PowerUp         = 1 << 4,  ///< Is a powerup.
+  Health          = 1 << 5,  ///< Health pickup.
+  HealthUp        = 1 << 6,  ///< Increase max health pickup.
+  StaminaUp       = 1 << 7,  ///< Increase max stamina pickup.
+  FocusUp         = 1 << 8,  ///< Increase max focus pickup.
+  MovementSpeedUp = 1 << 9,  ///< Increase movement speed pickup.
+  DamageUp        = 1 << 10, ///< Increase damage pickup.
+
+  Player               = 1 << 11, ///< Is the player.
+  Ant                  = 1 << 12, ///< Is an ant.
+  Turret               = 1 << 13, ///< Is a turret.
+  AnimalControlOfficer = 1 << 14, ///< Is the animal control officer.
+  BossTurret           = 1 << 15, ///< Is the boss turret.
+  Ghost                = 1 << 16, ///< Is a ghost.
+
+  Thinker = 1 << 17, ///< Has AI that may run at less than the full rate.
+}; //eObjectFlag
+
+/// \brief The game object. 
+///
+/// The abstract representation of an object. `CObjectManager` is a friend of
+/// this class so that it can access any private members as needed to manage
+/// the objects without the need for reader and set functions for each private
+/// or protected member variable. This class must contain public member
+/// functions `move()` and `draw()` to move and draw the object, respectively.
+///
+/// The sprite state comes from the engine's `LSpriteDesc2D` base. Position,
+/// orientation, velocity, speeds and radius live in the object manager's
+/// `CBodyArray` instead, at the object's index, and are reached through
+/// `Pos()` and the other body accessors. They are copied into a sprite
+/// descriptor only by `GetDrawDesc()`. The base's position and orientation
+/// are only where the object was created, so they are made private here.
+/// This class's own member variables are grouped by who writes them and
+/// when, and the per-type bools are packed into a single flag word.
+
+class CObject:
+  public CCommon,
+  public LBaseObject
+{
+  friend class CObjectManager; ///< Object manager needs access so it can manage.
+
+  private:
+    using LSpriteDesc2D::m_vPos; ///< Initial position, see `Pos()`.
+    using LSpriteDesc2D::m_fRoll; ///< Initial orientation, see `Roll()`.
+
+  protected:
+    //motion, the rest of which is in the body array
+
+    bool m_bStatic = true; ///< Is static (does not move).
+
+    //written by the object manager each step, before the object moves
+
+    bool m_bThink = true; ///< Run AI this step.
+    bool m_bAimed = false; ///< Target seen and rotation speed set by the object manager this step.
+    bool m_bOnTarget = false; ///< Aimed close enough to fire this step.
+    UINT m_nThinkInterval = 1; ///< Steps between AI steps, more than 1 if far away.
+
+    //the object's own state, used while it moves
+
+    CSimTimer* m_pGunFireEvent = nullptr; ///< Gun fire event.
+    CRng m_cRng; ///< Random number sequence for this object only, safe on any thread.
+
+    //read only when drawing
+
+    Vector2 m_vPrevPos; ///< Position at the start of the last step.
+    float m_fPrevRoll = 0; ///< Orientation at the start of the last step.
+
+    //bookkeeping, set when the object is created and by the object manager
+
+    UINT m_nFlags = 0; ///< Object flags, see eObjectFlag.
+    UINT m_nID = 0; ///< Identifies the object for keyed random numbers.
+    eLayer m_eLayer = eLayer::Creature; ///< Draw layer.
+    size_t m_nIndex = 0; ///< Index into the object manager's object array, changes when others die.
+    bool m_bSerialMove = false; ///< Must be moved on the main thread.
+    UINT m_nThinkPhase = 0; ///< Offset of AI steps from other objects' AI steps.
+
+    Vector2& Pos(); ///< Position in the body array.
+    Vector2& Velocity(); ///< Velocity in the body array.
+    float& Roll(); ///< Orientation in the body array.
+    float& RotSpeed(); ///< Rotational speed in the body array.
+    float& Speed(); ///< Speed in the body array.
+    float& Radius(); ///< Bounding circle radius in the body array.
+
+    void SetFlag(eObjectFlag); ///< Set an object flag.
+    const bool GetFlag(eObjectFlag) const; ///< Test an object flag.
+    void Kill(); ///< Flag for deletion from object list.
+    void PlaySound(eSound) const; ///< Play a sound.
+    void SpawnParticle(const LParticleDesc2D&) const; ///< Create a particle.
+    void SpawnBurst(const LParticleDesc2D&, UINT, float) const; ///< Create a burst of particles.
+    CCounterRng Random(eRngPurpose) const; ///< Get keyed random numbers.
+    void PostDeferrable(eTaskPriority, const std::function<void()>&,
+      bool=false) const; ///< Post work that can wait.
+    
+    virtual void CollisionResponse(const Vector2&, float,
+      CObject* = nullptr); ///< Collision response.
+    virtual void DeathFX(); ///< Death special effects.
+
+    const Vector2 GetViewVector() const; ///< Compute view vector.
+
+  public:
+    CObject(eSprite, const Vector2&); ///< Constructor.
+    virtual ~CObject(); ///< Destructor.
+
+    void move(); ///< Move object.
+    const Vector2& GetPos() const; ///< Get position.
+    const float GetRoll() const; ///< Get orientation.
+    const LSpriteDesc2D GetDrawDesc() const; ///< Get interpolated sprite.
+
+    const Vector2 GetDrawPos() const; ///< Get interpolated position.
+
+    //bullet bool functions
+    const bool isBullet() const; ///< Is a bullet.
+    const bool isPlayerBullet() const; // Is a player's bullet.
+    const bool isEnemyBullet() const; // Is an enemy bullet.
+
+    //powerup bool functions
+    const bool isPowerUp() const; //is a powerup
+    const bool isHealth() const;    //health pickup
+    const bool isHealthUp() const;  //increase max Health pickup
+    const bool isStaminaUp() const; //increase max Stamina pickup
+    const bool isFocusUp() const;   //increase max Focus pickup
+    const bool isMovementSpeedUp() const;   //increase Movement Speed pickup
+    const bool isDamageUp() const;  //increase Damage pickup
+
+    //creature bool functions
+    const bool isPlayer() const; ///< Is the player.
+    const bool isAnt() const; ///< Is an ant.
+    const bool isTurret() const; // Is a turret
+    const bool isAnimalControlOfficer() const; ///< Is the animal control officer.
+    const bool isBossTurret() const; ///< Is the boss turret.
+    const bool isGhost() const; ///< Is a ghost.
+}; //CObject
 #endif __L4RC_GAME_OBJECT_H__
\ No newline at end of file
@@ -1,215 +1,966 @@
-/// \file ObjectManager.cpp
-/// \brief Code for the the object manager class CObjectManager.
-
-#include "ObjectManager.h"
-#include "ComponentIncludes.h"
-
-#include "PowerUp.h"
-#include "Ant.h"
-#include "Player.h"
-#include "MGTurret.h"
-#include "Turret.h"
-#include "Bullet.h"
-#include "Bullet2.h"
-#include "AnimalControlOfficer.h"
-#include "BossTurret.h"
-#include "Ghost.h"
-#include "ParticleEngine.h"
-#include "Helpers.h"
-#include "GameDefines.h"
-#include "TileManager.h"
-#include <vector>
-
-/// Create an object and put a pointer to it at the back of the object list
-/// `m_stdObjectList`, which it inherits from `LBaseObjectManager`.
-/// \param t Sprite type.
-/// \param pos Initial position.
-/// \return Pointer to the object created.
-
-CObject* CObjectManager::create(eSprite t, const Vector2& pos){
-  CObject* pObj = nullptr;
-
-  switch(t){ //create object of type t
-        //creature creates
-        case eSprite::Ant:     pObj = new CAnt(pos); break;
-        case eSprite::Player:  pObj = new CPlayer(pos); break;
-        case eSprite::Turret:  pObj = new CTurret(pos); break;
-        case eSprite::AnimalControlOfficer: pObj = new CAnimalControlOfficer(pos); break;
-        case eSprite::BossTurret: pObj = new CBossTurret(pos); break;
-        case eSprite::Ghost: pObj = new CGhost(pos); break;
-        case eSprite::MGTurret: pObj = new CMGTurret(pos); break;
-    
-        //bullet creates
-        case eSprite::Bullet:  pObj = new CBullet(eSprite::Bullet,  pos); break;
-        case eSprite::Bullet2: pObj = new CBullet2(eSprite::Bullet2, pos); break;
-
-        //powerup creates
-        case eSprite::Health: pObj = new CPowerUp(eSprite::Health, pos); break;
-        case eSprite::HealthUp: pObj = new CPowerUp(eSprite::HealthUp, pos); break;
-        case eSprite::StaminaUp: pObj = new CPowerUp(eSprite::StaminaUp, pos); break;
-        case eSprite::FocusUp: pObj = new CPowerUp(eSprite::FocusUp, pos); break;
-        case eSprite::MovementSpeedUp: pObj = new CPowerUp(eSprite::MovementSpeedUp, pos); break;
-        case eSprite::DamageUp: pObj = new CPowerUp(eSprite::DamageUp, pos); break;
-
-        //default
-        default: pObj = new CObject(t, pos);
-  } //switch
-  
-  m_stdObjectList.push_back(pObj); //push pointer onto object list
-  return pObj; //return pointer to created object
-} //create
-
-/// Draw the tiled background and the objects in the object list.
-
-void CObjectManager::draw(){
-  m_pTileManager->Draw(eSprite::Tile); //draw tiled background
-
-  if(m_bDrawAABBs)
-    m_pTileManager->DrawBoundingBoxes(eSprite::Line); //draw AABBs
-
-  LBaseObjectManager::draw();
-} //draw
-
-/// Perform collision detection and response for each object with the world
-/// edges and for all objects with another object, making sure that each pair
-/// of objects is processed only once.
-
-void CObjectManager::BroadPhase(){
-  LBaseObjectManager::BroadPhase(); //collide with other objects
-
-  //collide with walls
-
-  for(CObject* pObj: m_stdObjectList) //for each object
-    if(!pObj->m_bDead){ //for each non-dead object, that is
-      for(int i=0; i<2; i++){ //can collide with 2 edges simultaneously
-        Vector2 norm; //collision normal
-        float d = 0; //overlap distance
-        BoundingSphere s(Vector3(pObj->m_vPos), pObj->m_fRadius);
-        
-        if(m_pTileManager->CollideWithWall(s, norm, d)) //collide with wall
-          pObj->CollisionResponse(norm, d); //respond 
-      } //for
-  } //for
-} //BroadPhase
-
-/// Perform collision detection and response for a pair of objects. Makes
-/// use of the helper function Identify() because this function may be called
-/// with the objects in an arbitrary order.
-/// \param p0 Pointer to the first object.
-/// \param p1 Pointer to the second object.
-
-void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
-  Vector2 vSep = p0->m_vPos - p1->m_vPos; //vector from *p1 to *p0
-  const float d = p0->m_fRadius + p1->m_fRadius - vSep.Length(); //overlap
-
-  if(d > 0.0f){ //bounding circles overlap
-    vSep.Normalize(); //vSep is now the collision normal
-
-    p0->CollisionResponse( vSep, d, p1); //this changes separation of objects
-    p1->CollisionResponse(-vSep, d, p0); //same separation and opposite normal
-  } //if
-} //NarrowPhase
-
-/// Create a bullet object and a flash particle effect. It is assumed that the
-/// object is round and that the bullet appears at the edge of the object in
-/// the direction that it is facing and continues moving in that direction.
-/// \param pObj Pointer to an object.
-/// \param bullet Sprite type of bullet.
-
-void CObjectManager::FireGun(CObject* pObj, eSprite bullet)
-{
-    m_pAudio->play(eSound::Gun);
-
-    //if the bullet is a player's bullet, update the bullet's damage amount
-    if (bullet == eSprite::Bullet)
-    {
-        m_pPlayer->UpdatePlayerDamage();
-    }
-
-    const Vector2 view = pObj->GetViewVector();                           //firing object view vector
-    const float w0 = 0.5f*m_pRenderer->GetWidth(pObj->m_nSpriteIndex);    //firing object width
-    const float w1 = m_pRenderer->GetWidth(bullet);                       //bullet width
-    const Vector2 pos = pObj->m_vPos + (w0 + w1)*view;                    //bullet initial position
-
-    //create bullet object
-
-    CObject* pBullet = create(bullet, pos);           //create bullet
-  
-    const Vector2 norm = VectorNormalCC(view);        //normal to view direction
-    const float m = 2.0f * m_pRandom->randf() - 1.0f;
-    Vector2 deflection; //changed to not be a const, hopefully that's fine lol
-
-    if (bullet == eSprite::Bullet)  //player's bullet's accuracy
-    {
-        if (m_pPlayer != nullptr && m_pPlayer->m_nWeaponSelector == 2)  //if player is alive and is using the shotgun
-        {
-            deflection = 0.2f * m * norm;          //random deflection
-        }
-        else
-        {
-            deflection = 0.01f * m * norm;          //random deflection
-        }
-    }
-
-    if (bullet == eSprite::Bullet2)     //enemy's bullet's accuracy
-    {
-        deflection = 0.1f * m * norm;          //random deflection
-    }
-
-    //BULLET VELOCITY HERE
-    if (m_pPlayer != NULL)  //make sure player isn't dead first (prevents a crash)
-    {
-        if (bullet == eSprite::Bullet2 && m_pPlayer->m_bIsFocusing)   //if the bullet is from an enemy turret and the player is focusing
-        {
-            pBullet->m_vVelocity = pObj->m_vVelocity + 100.0f * (view + deflection);
-        }
-        else    //otherwise, fire normally
-        {
-            pBullet->m_vVelocity = pObj->m_vVelocity + 500.0f * (view + deflection);
-        }
-    }
-
-    pBullet->m_fRoll = pObj->m_fRoll; 
-
-    //particle effect for gun fire
-  
-    LParticleDesc2D d;
-
-    d.m_nSpriteIndex = (UINT)eSprite::Spark;
-    d.m_vPos = pos;
-    d.m_vVel = pObj->m_fSpeed*view;
-    d.m_fLifeSpan = 0.25f;
-    d.m_fScaleInFrac = 0.4f;
-    d.m_fFadeOutFrac = 0.5f;
-    d.m_fMaxScale = 0.5f;
-    d.m_f4Tint = XMFLOAT4(Colors::Yellow);
-  
-    m_pParticleEngine->create(d);
-} //FireGun
-
-/// Reader function for the number of turrets. 
-/// \return Number of turrets in the object list.
-
-const size_t CObjectManager::GetNumEnemies() const{
-  size_t n = 0; //number of enemies
-  
-  for (CObject* pObj : m_stdObjectList) //for each object
-  {
-      if (pObj->m_nSpriteIndex == (UINT)eSprite::Turret)
-          n++;
-        
-      if (pObj->m_nSpriteIndex == (UINT)eSprite::Ant)
-          n++;
-
-      if (pObj->m_nSpriteIndex == (UINT)eSprite::Ghost)
-          n++;
-
-      if (pObj->m_nSpriteIndex == (UINT)eSprite::BossTurret)
-          n++;
-
-      if (pObj->m_nSpriteIndex == (UINT)eSprite::MGTurret)
-          n++;
-  }
-
-  return n;
-} //GetNumEnemies
\ No newline at end of file
+/// \file ObjectManager.cpp
+/// \brief Code for the the object manager class CObjectManager.
+
+#include "ObjectManager.h"
+#include "ComponentIncludes.h"
+
+#include "PowerUp.h"
+#include "Ant.h"
+#include "Player.h"
+#include "MGTurret.h"
+#include "Turret.h"
+#include "Bullet.h"
+#include "Bullet2.h"
+#include "AnimalControlOfficer.h"
+#include "BossTurret.h"
+#include "Ghost.h"
+#include "ParticleEngine.h"
+#include "Helpers.h"
+#include "GameDefines.h"
+#include "TileManager.h"
+#include "Archetype.h"
+#include <vector>
+#include <algorithm>
+#include "JobSystem.h"
+#include "RenderThread.h"
+#include "FlowField.h"
+
+/// Delete all of the objects.
+
+CObjectManager::~CObjectManager(){
+  clear();
+} //destructor
+
+/// Delete all of the objects, dead or alive, and empty the object array and
+/// the body array.
+
+void CObjectManager::clear(){
+  for(CObject* pObj: m_vecObjects)
+    delete pObj;
+
+  m_vecObjects.clear();
+  m_cBodies.clear();
+  m_vecDead.clear();
+
+  m_nThinkStep = 0;
+  m_nNextThinkPhase = 0;
+  m_nThinks = m_nThinkerSteps = 0;
+  m_nContacts = m_nAntContacts = m_nContactSteps = 0;
+} //clear
+
+/// Put a pointer to an object at the back of the object array, give it a
+/// body at the back of the body array, and tell the object where they are.
+/// Give it an ID that no other object in this game has had, so that its
+/// keyed random numbers are its own. This is called by the `CObject`
+/// constructor, so the rest of the object is not constructed yet.
+/// \param pObj Pointer to an object.
+
+void CObjectManager::Add(CObject* pObj){
+  pObj->m_nIndex = m_vecObjects.size(); //index of back of array
+  pObj->m_nID = m_nNextID++; //objects are added in the same order every time
+  pObj->m_nThinkPhase = m_nNextThinkPhase++; //spread AI steps out
+  m_vecObjects.push_back(pObj); //push pointer onto object array
+
+  m_cBodies.Add(pObj->m_vPos, pObj->m_fRoll); //where it was created
+} //Add
+
+/// Create an object, which puts a pointer to it at the back of the object
+/// array.
+/// \param t Sprite type.
+/// \param pos Initial position.
+/// \return Pointer to the object created.
+
+CObject* CObjectManager::create(eSprite t, const Vector2& pos){
+  CObject* pObj = nullptr;
+
+  switch(t){ //create object of type t
+        //creature creates
+        case eSprite::Ant:     pObj = new CAnt(pos); break;
+        case eSprite::Player:  pObj = new CPlayer(pos); break;
+        case eSprite::Turret:  pObj = new CTurret(pos); break;
+        case eSprite::AnimalControlOfficer: pObj = new CAnimalControlOfficer(pos); break;
+        case eSprite::BossTurret: pObj = new CBossTurret(pos); break;
+        case eSprite::Ghost: pObj = new CGhost(pos); break;
+        case eSprite::MGTurret: pObj = new CMGTurret(pos); break;
+    
+        //bullet creates
+        case eSprite::Bullet:  pObj = new CBullet(eSprite::Bullet,  pos); break;
+        case eSprite::Bullet2: pObj = new CBullet2(eSprite::Bullet2, pos); break;
+
+        //powerup creates
+        case eSprite::Health: pObj = new CPowerUp(eSprite::Health, pos); break;
+        case eSprite::HealthUp: pObj = new CPowerUp(eSprite::HealthUp, pos); break;
+        case eSprite::StaminaUp: pObj = new CPowerUp(eSprite::StaminaUp, pos); break;
+        case eSprite::FocusUp: pObj = new CPowerUp(eSprite::FocusUp, pos); break;
+        case eSprite::MovementSpeedUp: pObj = new CPowerUp(eSprite::MovementSpeedUp, pos); break;
+        case eSprite::DamageUp: pObj = new CPowerUp(eSprite::DamageUp, pos); break;
+
+        //default
+        default: pObj = new CObject(t, pos);
+  } //switch
+  
+  return pObj; //return pointer to created object
+} //create
+
+/// Create an object of type `T` at each of a list of positions, which puts
+/// pointers to them at the back of the object array. Since the type is known
+/// at compile time there is no need to go through the switch in `create()`.
+/// \param vecPos Vector of positions.
+
+template<class T> void CObjectManager::CreateAll(const std::vector<Vector2>& vecPos){
+  for(const Vector2& pos: vecPos)
+    new T(pos); //adds itself
+} //CreateAll
+
+/// Create the objects listed in a spawn manifest, one object type at a time.
+/// Space for all of them is reserved in the object array and the body array
+/// before any are created, so neither array is reallocated while the level
+/// is being populated.
+/// \param m Spawn manifest.
+/// \return Pointer to the player object.
+
+CPlayer* CObjectManager::Instantiate(const SSpawnManifest& m){
+  const size_t n = m_vecObjects.size() + m.size(); //number of objects after
+  m_vecObjects.reserve(n);
+  m_cBodies.Reserve(n);
+
+  CPlayer* pPlayer = new CPlayer(m.m_vPlayer); //adds itself
+
+  CreateAll<CTurret>(m.m_vecTurrets);
+  CreateAll<CMGTurret>(m.m_vecMGTurrets);
+  CreateAll<CAnt>(m.m_vecAnts);
+  CreateAll<CGhost>(m.m_vecGhosts);
+  CreateAll<CBossTurret>(m.m_vecBoss);
+
+  return pPlayer;
+} //Instantiate
+
+/// Remember where an object was for drawing, then move it.
+/// \param i Index of the object in the object array.
+
+void CObjectManager::MoveObject(size_t i){
+  CObject* pObj = m_vecObjects[i]; //shorthand
+  pObj->m_vPrevPos = m_cBodies.m_vecPos[i];
+  pObj->m_fPrevRoll = m_cBodies.m_vecRoll[i];
+  pObj->move();
+} //MoveObject
+
+/// Take one simulation step, which is `BeginStep()`, `MoveStep()` and
+/// `EndStep()` in that order. The game runs these as separate jobs so that
+/// their timings can be told apart.
+
+void CObjectManager::move(){
+  BeginStep();
+  MoveStep();
+  EndStep();
+} //move
+
+/// Start a simulation step. Decide which objects run their AI, steer the
+/// ants apart, and bring the flow field toward the player up to date, then
+/// move the objects that must be moved on the main thread, such as the
+/// player, whose position the other objects read while they move. Then aim
+/// the turrets at the player all at once. Must be called on the main thread.
+
+void CObjectManager::BeginStep(){
+  m_nStepStart = m_vecObjects.size(); //number of objects at start of step
+
+  ScheduleThinking(); //on the main thread, before anything moves
+  SteerAnts(); //from where the ants are before anything moves
+  if(m_pPlayer)m_pFlowField->Update(m_pPlayer->GetPos()); //chasers read it while moving
+
+  for(size_t i=0; i<m_nStepStart; i++) //objects that must move on the main thread
+    if(m_vecObjects[i]->m_bSerialMove)
+      MoveObject(i);
+
+  AimTurrets(); //after the player moves, before the turrets do
+} //BeginStep
+
+/// Move the rest of the objects in parallel. Objects created while moving,
+/// such as bullets, are moved in the same step, as they were when the
+/// objects were in a list. Must be called on the main thread, which plays
+/// the effects that the moves queued up.
+
+void CObjectManager::MoveStep(){
+  MoveInParallel(); //the rest of the objects that were there at the start
+
+  for(size_t i=m_nStepStart; i<m_vecObjects.size(); i++) //objects created this step
+    MoveObject(i);
+} //MoveStep
+
+/// Finish a simulation step with collision detection and response, then
+/// reclaim the objects that died. Must be called on the main thread.
+
+void CObjectManager::EndStep(){
+  BroadPhase(); //collision detection and response
+  CullDeadObjects(); //remove dead objects from object array
+} //EndStep
+
+/// Work out which way each ant that thinks this step should turn to keep
+/// clear of the other ants, so that crowds spread out instead of piling up
+/// and colliding. The live ants are copied out and sorted into a grid of
+/// cells as wide as the separation distance of the two largest ants, with a
+/// counting sort that keeps them in object order within each cell, so that
+/// each ant only looks at the ants in its own cell and the eight around it.
+/// The ants are then steered in parallel, each one writing only its own
+/// steering, which it turns toward as it moves. Ants that don't think this
+/// step keep their old steering.
+
+void CObjectManager::SteerAnts(){
+  m_vecNeighbors.clear(); //keeps its capacity from step to step
+  if(!m_bSeparation)return;
+
+  float r = 0; //largest radius
+
+  for(size_t i=0; i<m_vecObjects.size(); i++){
+    CObject* pObj = m_vecObjects[i]; //shorthand
+
+    if(pObj->GetFlag(eObjectFlag::Ant) && !pObj->m_bDead){
+      const float radius = m_cBodies.m_vecRadius[i]; //shorthand
+      m_vecNeighbors.push_back({m_cBodies.m_vecPos[i], m_cBodies.m_vecVelocity[i], radius, (CAnt*)pObj});
+      r = std::max(r, radius);
+    } //if
+  } //for
+
+  const size_t n = m_vecNeighbors.size(); //number of ants
+  if(n == 0)return;
+
+  m_fCellSize = std::max(2.0f*r*m_fSeparation, 1.0f);
+  m_nCellsWide = std::max((size_t)(m_vWorldSize.x/m_fCellSize) + 1, (size_t)1);
+  const size_t nHigh = std::max((size_t)(m_vWorldSize.y/m_fCellSize) + 1, (size_t)1); //cells high
+  const size_t nCells = m_nCellsWide*nHigh; //number of cells
+
+  m_vecCellStart.assign(nCells + 1, 0);
+  m_vecAntCell.resize(n);
+  m_vecCellAnts.resize(n);
+
+  for(size_t i=0; i<n; i++){ //count ants per cell
+    const Vector2& p = m_vecNeighbors[i].m_vPos; //shorthand
+    const size_t x = std::min((size_t)std::max(p.x/m_fCellSize, 0.0f), m_nCellsWide - 1); //column
+    const size_t y = std::min((size_t)std::max(p.y/m_fCellSize, 0.0f), nHigh - 1); //row
+
+    m_vecAntCell[i] = (UINT)(y*m_nCellsWide + x);
+    m_vecCellStart[m_vecAntCell[i] + 1]++;
+  } //for
+
+  for(size_t c=0; c<nCells; c++) //counts to starts
+    m_vecCellStart[c + 1] += m_vecCellStart[c];
+
+  for(size_t i=0; i<n; i++) //each start moves on to the next cell's
+    m_vecCellAnts[m_vecCellStart[m_vecAntCell[i]]++] = (UINT)i;
+
+  for(size_t c=nCells; c>0; c--) //move them back
+    m_vecCellStart[c] = m_vecCellStart[c - 1];
+
+  m_vecCellStart[0] = 0;
+
+  m_pJobSystem->ParallelFor("Steer", n, m_nMinRange, [&](size_t, size_t i0, size_t i1){
+    for(size_t i=i0; i<i1; i++){
+      CAnt* pAnt = m_vecNeighbors[i].m_pAnt; //shorthand
+      if(pAnt->m_bThink)pAnt->m_vSteer = GetSteering(i);
+    } //for
+  }); //ParallelFor
+} //SteerAnts
+
+/// Get the crowd steering for an ant from the ants near it. Each neighbor
+/// closer than the separation distance pushes it directly away, harder the
+/// closer it is. Each neighbor that it will hit within the look-ahead time
+/// if they both keep going pushes it away from where the neighbor will be
+/// when they are closest, harder the sooner that is.
+/// \param i Index of ant in the neighbor array.
+/// \return Steering, to be added to the ant's unit heading.
+
+const Vector2 CObjectManager::GetSteering(size_t i) const{
+  const SNeighbor& a = m_vecNeighbors[i]; //shorthand
+  const size_t cx = m_vecAntCell[i]%m_nCellsWide; //cell column
+  const size_t cy = m_vecAntCell[i]/m_nCellsWide; //cell row
+  const size_t nHigh = (m_vecCellStart.size() - 1)/m_nCellsWide; //cells high
+
+  Vector2 steer = Vector2::Zero; //steering so far
+
+  for(int dy=-1; dy<=1; dy++)
+    for(int dx=-1; dx<=1; dx++){
+      const size_t x = cx + dx, y = cy + dy; //neighboring cell, wraps if off the grid
+      if(x >= m_nCellsWide || y >= nHigh)continue;
+
+      const size_t c = y*m_nCellsWide + x; //cell index
+
+      for(UINT k=m_vecCellStart[c]; k<m_vecCellStart[c + 1]; k++){
+        const UINT j = m_vecCellAnts[k]; //neighbor index
+        if(j == i)continue; //not its own neighbor
+
+        const SNeighbor& b = m_vecNeighbors[j]; //shorthand
+        const Vector2 dp = a.m_vPos - b.m_vPos; //from neighbor to ant
+        const float r = a.m_fRadius + b.m_fRadius; //contact distance
+        const float R = m_fSeparation*r; //separation distance
+        const float d2 = dp.LengthSquared(); //squared distance
+
+        if(d2 > 0 && d2 < R*R){ //separation
+          const float d = sqrtf(d2); //distance
+          steer += (1.0f - d/R)/d*dp;
+        } //if
+
+        const Vector2 dv = a.m_vVelocity - b.m_vVelocity; //relative velocity
+        const float v2 = dv.LengthSquared(); //squared relative speed
+        if(v2 <= 0)continue; //moving together
+
+        const float t = -dp.Dot(dv)/v2; //time until closest
+        if(t <= 0 || t >= m_fAvoidTime)continue; //moving apart or not soon
+
+        const Vector2 f = dp + t*dv; //from neighbor to ant when closest
+        const float f2 = f.LengthSquared(); //squared distance when closest
+
+        if(f2 < r*r){ //avoidance
+          const float fd = sqrtf(f2); //distance when closest
+          const Vector2 away = fd > 0? f/fd: Vector2(-dv.y, dv.x)/sqrtf(v2); //head on, so sidestep
+          steer += (1.0f - t/m_fAvoidTime)*away;
+        } //if
+      } //for
+    } //for
+
+  return steer;
+} //GetSteering
+
+/// Aim the turrets that think this step and can see the player. Whether each
+/// one can see the player is worked out in parallel, since that walks the
+/// tiles between them, and the aims of all of them, seen or not, are written
+/// into the aim batch, which then works out the rotation speeds and whether
+/// they can fire in one vectorized pass. The results are copied back into
+/// the turrets that can see the player, which only fire or scan when they
+/// move. A turret that can't see the player sets its own rotation speed.
+/// The boss is aimed with them, and uses the result only while its bullet
+/// pattern aims at the player.
+
+void CObjectManager::AimTurrets(){
+  m_vecAimers.clear(); //keeps its capacity from step to step
+  if(m_pPlayer == nullptr)return; //nothing to aim at
+
+  for(CObject* pObj: m_vecObjects)
+    if((pObj->GetFlag(eObjectFlag::Turret) || pObj->GetFlag(eObjectFlag::BossTurret)) &&
+      pObj->m_bThink && !pObj->m_bDead)
+      m_vecAimers.push_back(pObj);
+
+  const size_t n = m_vecAimers.size(); //number of turrets
+  if(n == 0)return;
+
+  const Vector2 target = m_pPlayer->GetPos(); //player position
+  const float r = m_cBodies.m_vecRadius[m_pPlayer->m_nIndex]; //player radius
+  m_cAimBatch.Resize(n);
+
+  m_pJobSystem->ParallelFor("Sight", n, m_nMinRange, [&](size_t, size_t i0, size_t i1){
+    for(size_t i=i0; i<i1; i++){
+      CObject* pObj = m_vecAimers[i]; //shorthand
+      const Vector2& pos = m_cBodies.m_vecPos[pObj->m_nIndex]; //turret position
+      pObj->m_bAimed = m_pTileManager->Visible(pos, target, r);
+      m_cAimBatch.Set(i, target - pos, m_cBodies.m_vecRoll[pObj->m_nIndex]);
+    } //for
+  }); //ParallelFor
+
+  m_cAimBatch.Aim();
+
+  for(size_t i=0; i<n; i++){
+    CObject* pObj = m_vecAimers[i]; //shorthand
+
+    if(pObj->m_bAimed){
+      m_cBodies.m_vecRotSpeed[pObj->m_nIndex] = m_cAimBatch.GetRotSpeed(i);
+      pObj->m_bOnTarget = m_cAimBatch.GetOnTarget(i);
+    } //if
+  } //for
+} //AimTurrets
+
+/// Decide which objects with AI run it this step. An object's think interval
+/// is `m_nBaseThinkInterval`, which comes from the AI update rate, within
+/// `m_fThinkNear` of the player, and doubles each time that distance
+/// doubles, up to `m_nMaxThinkInterval`. An object thinks on the steps whose
+/// number plus its think phase is a multiple of its interval. Think phases
+/// are handed out in the order that objects are created, so the AI steps of
+/// far away objects are spread evenly over the steps instead of all landing
+/// on the same one. The distance is to the player rather than the camera,
+/// since the camera depends on the window size and the camera update rate,
+/// neither of which is part of the simulation, so a replay would think on
+/// different steps if they changed. The camera stays near the player
+/// anyway. Objects that don't think on a step still move, they just keep
+/// doing what they decided last time. With no player, everything thinks at
+/// the full rate.
+
+void CObjectManager::ScheduleThinking(){
+  const UINT step = m_nThinkStep++; //this step's number
+  const UINT nMax = std::max(m_nMaxThinkInterval, m_nBaseThinkInterval); //longest interval
+  const Vector2 player = m_pPlayer? m_pPlayer->GetPos(): Vector2::Zero; //player position
+
+  for(size_t i=0; i<m_vecObjects.size(); i++){
+    CObject* pObj = m_vecObjects[i]; //shorthand
+    if(!pObj->GetFlag(eObjectFlag::Thinker))continue; //no AI
+
+    UINT interval = m_nBaseThinkInterval; //steps between AI steps
+
+    if(m_bThinkLOD && m_pPlayer){
+      const float d = Vector2::DistanceSquared(m_cBodies.m_vecPos[i], player); //squared distance
+      float r = m_fThinkNear*m_fThinkNear; //squared radius for this interval
+
+      while(d > r && interval < nMax){
+        interval *= 2;
+        r *= 4; //double the radius
+      } //while
+    } //if
+
+    pObj->m_nThinkInterval = interval;
+    pObj->m_bThink = (step + pObj->m_nThinkPhase)%interval == 0;
+
+    m_nThinkerSteps++;
+    if(pObj->m_bThink)m_nThinks++;
+  } //for
+} //ScheduleThinking
+
+/// Split the object array into contiguous ranges and move the objects in
+/// each range in a separate job. An object moved here must only change its
+/// own state. Anything else it wants to do is captured in the effect queue
+/// for its range, and the queues are flushed on the main thread in
+/// range order afterwards. Since the objects in a range are moved in index
+/// order, the effects happen in the same order no matter how many ranges
+/// there are, which means that the result is the same as moving all of the
+/// objects on one thread.
+
+void CObjectManager::MoveInParallel(){
+  const size_t n = m_vecObjects.size(); //number of objects
+  const size_t nRanges = m_pJobSystem->GetNumChunks(n, m_nMinRange); //number of ranges
+
+  if(m_vecEffectQueues.size() < nRanges)
+    m_vecEffectQueues.resize(nRanges);
+
+  m_pJobSystem->ParallelFor("Move", n, m_nMinRange, [&](size_t k, size_t i0, size_t i1){
+    CEffectQueue& q = m_vecEffectQueues[k]; //this range's effect queue
+    q.Begin(); //capture effects on this thread
+
+    for(size_t i=i0; i<i1; i++) //for each object in range
+      if(!m_vecObjects[i]->m_bSerialMove)MoveObject(i);
+
+    q.End(); //stop capturing effects
+  }); //ParallelFor
+
+  for(size_t k=0; k<nRanges; k++) //in range order
+    m_vecEffectQueues[k].Flush(); //do the captured effects on the main thread
+} //MoveInParallel
+
+/// Remove the objects that were killed this frame from the object array by
+/// swapping each one with the object at the back of the array, and their
+/// bodies from the body array in the same way, then delete them. The
+/// deletions are sorted by sprite type so that objects of the same type are
+/// destroyed together.
+
+void CObjectManager::CullDeadObjects(){
+  if(m_vecDead.empty())return; //nothing died, bail out
+
+  for(CObject* pDead: m_vecDead){ //swap-remove each dead object
+    const size_t i = pDead->m_nIndex; //index of hole
+    CObject* pBack = m_vecObjects.back(); //object at back of array
+    m_vecObjects[i] = pBack; //fill the hole
+    m_cBodies.Remove(i); //and its body
+    pBack->m_nIndex = i; //back object's new index
+    m_vecObjects.pop_back(); //array is now one shorter
+  } //for
+
+  std::sort(m_vecDead.begin(), m_vecDead.end(), [](CObject* p0, CObject* p1){
+    return p0->m_nSpriteIndex < p1->m_nSpriteIndex;
+  }); //batch by type
+
+  for(CObject* pDead: m_vecDead)
+    delete pDead;
+
+  m_vecDead.clear(); //keeps its capacity from frame to frame
+} //CullDeadObjects
+
+/// Copy the interpolated sprite descriptors of the objects in the object
+/// array into a world snapshot, in the order that they are to be drawn.
+/// Since swap-removal scrambles the order of the object array, the objects
+/// are copied one layer at a time so that bullets stay on top of creatures
+/// and creatures stay on top of pickups.
+/// \param vecSprites [out] Sprite descriptors in drawing order.
+
+void CObjectManager::Snapshot(std::vector<LSpriteDesc2D>& vecSprites) const{
+  vecSprites.clear(); //keeps its capacity from frame to frame
+
+  for(UINT i=(UINT)eLayer::Pickup; i<=(UINT)eLayer::Bullet; i++) //for each layer
+    for(CObject* pObj: m_vecObjects) //for each object
+      if((UINT)pObj->m_eLayer == i) //in that layer
+        vecSprites.push_back(pObj->GetDrawDesc());
+} //Snapshot
+
+/// Perform collision detection and response for each object with the world
+/// edges and for all objects with another object, making sure that each pair
+/// of objects is processed only once. Contacts between objects are found
+/// first, then sorted into batches in which no object appears more than
+/// once, so that the contacts in a batch can be responded to in parallel.
+/// The batches are done one after the other, then any contacts that didn't
+/// fit in a batch, then the collisions with walls.
+
+void CObjectManager::BroadPhase(){
+  FindContacts(); //collide with other objects
+  BatchContacts();
+
+  for(const std::vector<SContact>& batch: m_vecBatches) //in batch order
+    if(!batch.empty())ResolveBatch(batch);
+
+  for(const SContact& c: m_vecOverflow) //leftovers, on this thread
+    NarrowPhase(c.m_p0, c.m_p1);
+
+  //collide with walls
+
+  for(size_t j=0; j<m_vecObjects.size(); j++){ //for each object
+    CObject* pObj = m_vecObjects[j]; //shorthand
+
+    if(!pObj->m_bDead){ //for each non-dead object, that is
+      for(int i=0; i<2; i++){ //can collide with 2 edges simultaneously
+        Vector2 norm; //collision normal
+        float d = 0; //overlap distance
+        BoundingSphere s(Vector3(m_cBodies.m_vecPos[j]), m_cBodies.m_vecRadius[j]);
+        
+        if(m_pTileManager->CollideWithWall(s, norm, d)) //collide with wall
+          pObj->CollisionResponse(norm, d); //respond 
+      } //for
+    } //if
+  } //for
+} //BroadPhase
+
+/// Find the pairs of objects whose bounding circles overlap. The pairs are
+/// tested by streaming through the position and radius arrays of the body
+/// array, without touching the objects unless they overlap. Contacts are all
+/// found before any object is moved by a response, so they are found using
+/// the positions at the start of the collision pass. The narrow phase checks
+/// the overlap again using the positions at the time of response.
+
+void CObjectManager::FindContacts(){
+  m_vecContacts.clear(); //keeps its capacity from frame to frame
+
+  const std::vector<Vector2>& pos = m_cBodies.m_vecPos; //shorthand
+  const std::vector<float>& radius = m_cBodies.m_vecRadius; //shorthand
+  const size_t n = pos.size(); //number of bodies
+
+  for(size_t i=0; i<n; i++){ //for each body
+    const Vector2 v0 = pos[i]; //first position
+    const float r0 = radius[i]; //first radius
+
+    for(size_t j=i+1; j<n; j++){ //for each later body
+      const float r = r0 + radius[j]; //sum of radii
+
+      if(Vector2::DistanceSquared(v0, pos[j]) < r*r){ //overlap
+        CObject* p0 = m_vecObjects[i]; //shorthand
+        CObject* p1 = m_vecObjects[j]; //shorthand
+        m_vecContacts.push_back({p0, p1});
+
+        if(p0->GetFlag(eObjectFlag::Ant) && p1->GetFlag(eObjectFlag::Ant))
+          m_nAntContacts++;
+      } //if
+    } //for
+  } //for
+
+  m_nContacts += (UINT)m_vecContacts.size();
+  m_nContactSteps++;
+} //FindContacts
+
+/// Sort the contacts into batches by greedy graph coloring. Each object has a
+/// 64-bit mask with a bit set for each batch that it is already in, and each
+/// contact goes into the first batch that none of its objects is in. A
+/// player's bullet changes the player's combo when it hits something, so the
+/// player counts as being in every contact that has a player's bullet in it.
+/// A contact that can't go in any of the 64 batches is put in the overflow
+/// list to be done on the main thread. Contacts are batched in the order
+/// that they were found, so the batches depend only on the contacts and not
+/// on the number of threads.
+
+void CObjectManager::BatchContacts(){
+  m_vecBatchMask.assign(m_vecObjects.size(), 0); //nobody is in a batch yet
+  m_vecOverflow.clear();
+
+  for(std::vector<SContact>& batch: m_vecBatches)
+    batch.clear(); //keeps its capacity from frame to frame
+
+  for(const SContact& c: m_vecContacts){ //for each contact
+    uint64_t& m0 = m_vecBatchMask[c.m_p0->m_nIndex]; //first object's batches
+    uint64_t& m1 = m_vecBatchMask[c.m_p1->m_nIndex]; //second object's batches
+
+    const bool bPlayer = m_pPlayer != nullptr &&
+      (c.m_p0->isPlayerBullet() || c.m_p1->isPlayerBullet()); //player involved
+    uint64_t* pm2 = bPlayer? &m_vecBatchMask[m_pPlayer->m_nIndex]: nullptr;
+
+    const uint64_t used = m0 | m1 | (pm2? *pm2: 0); //batches that conflict
+
+    if(used == ~0ULL){ //all batches conflict
+      m_vecOverflow.push_back(c);
+      continue;
+    } //if
+
+    UINT b = 0; //first free batch
+    while(used & (1ULL << b))b++;
+
+    const uint64_t bit = 1ULL << b; //mask for batch b
+    m0 |= bit;
+    m1 |= bit;
+    if(pm2)*pm2 |= bit;
+
+    if(m_vecBatches.size() <= b)
+      m_vecBatches.resize(b + 1);
+
+    m_vecBatches[b].push_back(c);
+  } //for
+} //BatchContacts
+
+/// Respond to a batch of contacts in parallel. No object is in more than one
+/// contact in a batch, so each job only changes objects that no other job
+/// touches. Anything else that a response wants to do is captured in the
+/// effect queue for its job, and the queues are flushed on the main thread
+/// in job order before the next batch, as in `MoveInParallel()`.
+/// \param batch Contacts in which no object appears twice.
+
+void CObjectManager::ResolveBatch(const std::vector<SContact>& batch){
+  const size_t n = batch.size(); //number of contacts
+  const size_t nJobs = m_pJobSystem->GetNumChunks(n, m_nMinBatch); //number of jobs
+
+  if(m_vecEffectQueues.size() < nJobs)
+    m_vecEffectQueues.resize(nJobs);
+
+  m_pJobSystem->ParallelFor("Collide", n, m_nMinBatch, [&](size_t k, size_t i0, size_t i1){
+    CEffectQueue& q = m_vecEffectQueues[k]; //this job's effect queue
+    q.Begin(); //capture effects on this thread
+
+    for(size_t i=i0; i<i1; i++) //for each contact in range
+      NarrowPhase(batch[i].m_p0, batch[i].m_p1);
+
+    q.End(); //stop capturing effects
+  }); //ParallelFor
+
+  for(size_t k=0; k<nJobs; k++) //in job order
+    m_vecEffectQueues[k].Flush(); //do the captured effects on the main thread
+} //ResolveBatch
+
+/// Perform collision detection and response for a pair of objects. Makes
+/// use of the helper function Identify() because this function may be called
+/// with the objects in an arbitrary order.
+/// \param p0 Pointer to the first object.
+/// \param p1 Pointer to the second object.
+
+void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
+  const size_t i0 = p0->m_nIndex, i1 = p1->m_nIndex; //body indices
+
+  Vector2 vSep = m_cBodies.m_vecPos[i0] - m_cBodies.m_vecPos[i1]; //vector from *p1 to *p0
+  const float d = m_cBodies.m_vecRadius[i0] + m_cBodies.m_vecRadius[i1] - vSep.Length(); //overlap
+
+  if(d > 0.0f){ //bounding circles overlap
+    vSep.Normalize(); //vSep is now the collision normal
+
+    p0->CollisionResponse( vSep, d, p1); //this changes separation of objects
+    p1->CollisionResponse(-vSep, d, p0); //same separation and opposite normal
+  } //if
+} //NarrowPhase
+
+/// Create a bullet object and a flash particle effect. It is assumed that the
+/// object is round and that the bullet appears at the edge of the object in
+/// the direction that it is facing and continues moving in that direction.
+/// \param pObj Pointer to an object.
+/// \param bullet Sprite type of bullet.
+
+void CObjectManager::FireGun(CObject* pObj, eSprite bullet)
+{
+    if (CEffectQueue::Defer([=]() { FireGun(pObj, bullet); }))
+        return; //called from a worker thread, so fire when the queue is flushed
+
+    m_pAudio->play(eSound::Gun);
+
+    //if the bullet is a player's bullet, update the bullet's damage amount
+    if (bullet == eSprite::Bullet)
+    {
+        m_pPlayer->UpdatePlayerDamage();
+    }
+
+    const Vector2 view = pObj->GetViewVector();                           //firing object view vector
+    const float w0 = 0.5f*CArchetypeTable::Get(pObj->m_nSpriteIndex).m_fWidth; //firing object width
+    const float w1 = CArchetypeTable::Get(bullet).m_fWidth;                     //bullet width
+    const Vector2 pos = pObj->Pos() + (w0 + w1)*view;                     //bullet initial position
+
+    //create bullet object
+
+    CObject* pBullet = create(bullet, pos);           //create bullet
+  
+    const Vector2 norm = VectorNormalCC(view);        //normal to view direction
+    const float m = pObj->m_cRng.Float(-1.0f, 1.0f); //firing object's own random numbers
+    Vector2 deflection; //changed to not be a const, hopefully that's fine lol
+
+    if (bullet == eSprite::Bullet)  //player's bullet's accuracy
+    {
+        if (m_pPlayer != nullptr && m_pPlayer->m_nWeaponSelector == 2)  //if player is alive and is using the shotgun
+        {
+            deflection = 0.2f * m * norm;          //random deflection
+        }
+        else
+        {
+            deflection = 0.01f * m * norm;          //random deflection
+        }
+    }
+
+    if (bullet == eSprite::Bullet2)     //enemy's bullet's accuracy
+    {
+        deflection = 0.1f * m * norm;          //random deflection
+    }
+
+    //BULLET VELOCITY HERE
+    if (m_pPlayer != NULL)  //make sure player isn't dead first (prevents a crash)
+    {
+        if (bullet == eSprite::Bullet2 && m_pPlayer->m_bIsFocusing)   //if the bullet is from an enemy turret and the player is focusing
+        {
+            pBullet->Velocity() = pObj->Velocity() + 100.0f * (view + deflection);
+        }
+        else    //otherwise, fire normally
+        {
+            pBullet->Velocity() = pObj->Velocity() + 500.0f * (view + deflection);
+        }
+    }
+
+    pBullet->Roll() = pObj->Roll(); 
+
+    //particle effect for gun fire
+  
+    LParticleDesc2D d;
+
+    d.m_nSpriteIndex = (UINT)eSprite::Spark;
+    d.m_vPos = pos;
+    d.m_vVel = pObj->Speed()*view;
+    d.m_fLifeSpan = 0.25f;
+    d.m_fScaleInFrac = 0.4f;
+    d.m_fFadeOutFrac = 0.5f;
+    d.m_fMaxScale = 0.5f;
+    d.m_f4Tint = XMFLOAT4(Colors::Yellow);
+  
+    m_pRenderThread->SpawnParticle(d);
+} //FireGun
+
+/// Fire a volley of bullets from an object all at once, one in each of a
+/// list of directions. Unlike firing them one at a time with `FireGun()`,
+/// the gun sound and the muzzle flash are played once for the whole volley,
+/// and space for all of the bullets is reserved in the object array and the
+/// body array before any are created. Each bullet gets its own
+/// random deflection from the firing object's random numbers, and bullets
+/// are slowed down while the player is focusing, as in `FireGun()`.
+/// \param pObj Pointer to the firing object.
+/// \param bullet Bullet sprite type.
+/// \param angles Bullet directions.
+/// \param speed Bullet speed.
+/// \param jitter Largest random deflection.
+
+void CObjectManager::FireVolley(CObject* pObj, eSprite bullet, const std::vector<float>& angles,
+  float speed, float jitter)
+{
+  if(angles.empty())return; //nothing to fire
+
+  if(CEffectQueue::Defer([=](){FireVolley(pObj, bullet, angles, speed, jitter);}))
+    return; //called from a worker thread, so fire when the queue is flushed
+
+  m_pAudio->play(eSound::Gun); //once for the whole volley
+
+  const float w0 = 0.5f*CArchetypeTable::Get(pObj->m_nSpriteIndex).m_fWidth; //firing object width
+  const float w1 = CArchetypeTable::Get(bullet).m_fWidth; //bullet width
+  const bool bSlow = m_pPlayer != nullptr && m_pPlayer->m_bIsFocusing; //player is focusing
+  const float s = bSlow? 0.2f*speed: speed; //bullet speed
+
+  const size_t n = m_vecObjects.size() + angles.size(); //number of objects after
+  m_vecObjects.reserve(n);
+  m_cBodies.Reserve(n);
+
+  for(const float a: angles){
+    const Vector2 view = AngleToVector(a); //bullet direction
+    const float m = pObj->m_cRng.Float(-1.0f, 1.0f); //firing object's own random numbers
+
+    CObject* pBullet = create(bullet, pObj->Pos() + (w0 + w1)*view);
+    pBullet->Velocity() = pObj->Velocity() + s*(view + jitter*m*VectorNormalCC(view));
+    pBullet->Roll() = a;
+  } //for
+
+  //particle effect for gun fire
+
+  LParticleDesc2D d;
+
+  d.m_nSpriteIndex = (UINT)eSprite::Spark;
+  d.m_vPos = pObj->Pos() + (w0 + w1)*pObj->GetViewVector();
+  d.m_vVel = pObj->Speed()*pObj->GetViewVector();
+  d.m_fLifeSpan = 0.25f;
+  d.m_fScaleInFrac = 0.4f;
+  d.m_fFadeOutFrac = 0.5f;
+  d.m_fMaxScale = 0.5f;
+  d.m_f4Tint = XMFLOAT4(Colors::Yellow);
+
+  m_pRenderThread->SpawnParticle(d);
+} //FireVolley
+
+/// Reader function for the number of turrets. 
+/// \return Number of turrets in the object list.
+
+const size_t CObjectManager::GetNumEnemies() const{
+  size_t n = 0; //number of enemies
+  
+  for (CObject* pObj : m_vecObjects) //for each object
+  {
+      if (pObj->m_nSpriteIndex == (UINT)eSprite::Turret)
+          n++;
+        
+      if (pObj->m_nSpriteIndex == (UINT)eSprite::Ant)
+          n++;
+
+      if (pObj->m_nSpriteIndex == (UINT)eSprite::Ghost)
+          n++;
+
+      if (pObj->m_nSpriteIndex == (UINT)eSprite::BossTurret)
+          n++;
+
+      if (pObj->m_nSpriteIndex == (UINT)eSprite::MGTurret)
+          n++;
+  }
+
+  return n;
+} //GetNumEnemies
+
+/// Compute a checksum of the state of the objects for checking that a replay
+/// matches its recording. It is a 32-bit FNV-1a hash of the sprite type,
+/// position and orientation of each object in object array order, which is
+/// enough to catch a replay wandering off on a different path.
+/// \return Checksum.
+
+const uint32_t CObjectManager::GetChecksum() const{
+  uint32_t hash = 2166136261U; //FNV offset basis
+
+  auto Add = [&](const void* p, size_t n){ //hash n bytes
+    for(size_t i=0; i<n; i++){
+      hash ^= ((const uint8_t*)p)[i];
+      hash *= 16777619U; //FNV prime
+    } //for
+  }; //Add
+
+  for(size_t i=0; i<m_vecObjects.size(); i++){ //for each object
+    Add(&m_vecObjects[i]->m_nSpriteIndex, sizeof(m_vecObjects[i]->m_nSpriteIndex));
+    Add(&m_cBodies.m_vecPos[i], sizeof(Vector2));
+    Add(&m_cBodies.m_vecRoll[i], sizeof(float));
+  } //for
+
+  return hash;
+} //GetChecksum
+
+/// Set the AI level of detail.
+/// \param b true to run far away AI at less than the full rate.
+/// \param r Distance within which AI runs at the full rate.
+/// \param n Most steps between AI steps.
+
+void CObjectManager::SetThinkLOD(bool b, float r, UINT n){
+  m_bThinkLOD = b;
+  m_fThinkNear = std::max(r, 1.0f);
+  m_nMaxThinkInterval = std::max(n, 1u);
+} //SetThinkLOD
+
+/// Turn the AI level of detail on or off.
+/// \param b true to run far away AI at less than the full rate.
+
+void CObjectManager::SetThinkLOD(bool b){
+  m_bThinkLOD = b;
+} //SetThinkLOD
+
+/// Reader function for the AI level of detail flag.
+/// \return true if far away AI runs at less than the full rate.
+
+const bool CObjectManager::GetThinkLOD() const{
+  return m_bThinkLOD;
+} //GetThinkLOD
+
+/// Set the number of steps between AI steps for objects that are near the
+/// player. Far away objects think less often than this.
+/// \param n Steps between AI steps.
+
+void CObjectManager::SetThinkInterval(UINT n){
+  m_nBaseThinkInterval = std::max(n, 1u);
+} //SetThinkInterval
+
+/// Reader function for the number of steps between AI steps for objects that
+/// are near the player.
+/// \return Steps between AI steps.
+
+const UINT CObjectManager::GetThinkInterval() const{
+  return m_nBaseThinkInterval;
+} //GetThinkInterval
+
+/// Reader function for the distance within which AI runs at the full rate.
+/// \return Distance.
+
+const float CObjectManager::GetThinkNear() const{
+  return m_fThinkNear;
+} //GetThinkNear
+
+/// Reader function for the most steps between AI steps.
+/// \return Most steps between AI steps.
+
+const UINT CObjectManager::GetMaxThinkInterval() const{
+  return m_nMaxThinkInterval;
+} //GetMaxThinkInterval
+
+/// Set the ant separation.
+/// \param b true to steer ants apart before they collide.
+/// \param d Distance to keep between ants, as a multiple of the sum of their radii.
+/// \param t How far ahead to look for collisions, in seconds.
+
+void CObjectManager::SetSeparation(bool b, float d, float t){
+  m_fSeparation = std::max(d, 1.0f);
+  m_fAvoidTime = std::max(t, 0.0f);
+  SetSeparation(b);
+} //SetSeparation
+
+/// Turn the ant separation on or off. Ants keep the steering that they had
+/// when it was turned off until it is turned on again.
+/// \param b true to steer ants apart before they collide.
+
+void CObjectManager::SetSeparation(bool b){
+  m_bSeparation = b;
+
+  if(!b)
+    for(CObject* pObj: m_vecObjects)
+      if(pObj->GetFlag(eObjectFlag::Ant))
+        ((CAnt*)pObj)->m_vSteer = Vector2::Zero;
+} //SetSeparation
+
+/// Reader function for the ant separation flag.
+/// \return true if ants are steered apart before they collide.
+
+const bool CObjectManager::GetSeparation() const{
+  return m_bSeparation;
+} //GetSeparation
+
+/// Reader function for the separation distance.
+/// \return Distance to keep between ants, as a multiple of the sum of their radii.
+
+const float CObjectManager::GetSeparationDistance() const{
+  return m_fSeparation;
+} //GetSeparationDistance
+
+/// Reader function for the avoidance look-ahead time.
+/// \return How far ahead to look for collisions, in seconds.
+
+const float CObjectManager::GetAvoidTime() const{
+  return m_fAvoidTime;
+} //GetAvoidTime
+
+/// Get the mean number of contacts that the broad phase found per step since
+/// the level started.
+/// \return Contacts per step.
+
+const float CObjectManager::GetContactsPerStep() const{
+  return m_nContactSteps > 0? (float)m_nContacts/m_nContactSteps: 0.0f;
+} //GetContactsPerStep
+
+/// Get the mean number of contacts between two ants that the broad phase
+/// found per step since the level started.
+/// \return Ant contacts per step.
+
+const float CObjectManager::GetAntContactsPerStep() const{
+  return m_nContactSteps > 0? (float)m_nAntContacts/m_nContactSteps: 0.0f;
+} //GetAntContactsPerStep
+
+/// Get the fraction of the AI steps that could have been run since the
+/// level started that actually were run.
+/// \return Fraction of AI steps run, 1 if there were none to run.
+
+const float CObjectManager::GetThinkFraction() const{
+  return m_nThinkerSteps > 0? (float)m_nThinks/m_nThinkerSteps: 1.0f;
+} //GetThinkFraction
@@ -1,43 +1,164 @@
-/// \file ObjectManager.h
-/// \brief Interface for the object manager CObjectManager.
-
-#ifndef __L4RC_GAME_OBJECTMANAGER_H__
-#define __L4RC_GAME_OBJECTMANAGER_H__
-
-#include "BaseObjectManager.h"
-#include "Object.h"
-#include "Common.h"
-
-/// \brief The object manager.
-///
-/// A collection of all of the game objects.
-
-class CObjectManager: 
-  public LBaseObjectManager<CObject>,
-  public CCommon
-{
-  private:
-    //bool m_bLevelCompleted = false; ///< Level completion flag.
-
-    void BroadPhase(); ///< Broad phase collision detection and response.
-    void NarrowPhase(CObject*, CObject*); ///< Narrow phase collision detection and response.
-
-  public:
-    //virtual void clear(); ///< Reset to empty and delete all objects.
-
-    CObject* create(eSprite, const Vector2&); ///< Create new object.
-    
-    virtual void draw(); ///< Draw all objects.
-
-    void FireGun(CObject*, eSprite); ///< Fire object's gun.
-    const size_t GetNumEnemies() const; ///< Get number of turrets in object list.
-    const int maxGhosts = 3;
-    int numOfGhosts = 0;
-    //const bool LevelCompleted() const; ///< Level completed.
-
-    //Difficulty Variables
-    UINT m_nDifficultyModifier = 0; //this stat is used to determine outcomes based on the game's difficulty
-
-}; //CObjectManager
-
-#endif //__L4RC_GAME_OBJECTMANAGER_H__
+/// \file ObjectManager.h
+/// \brief Interface for the object manager CObjectManager.
+
+#ifndef __L4RC_GAME_OBJECTMANAGER_H__
+#define __L4RC_GAME_OBJECTMANAGER_H__
+
+#include "Component.h"
+#include "Object.h"
+#include "Common.h"
+#include "EffectQueue.h"
+#include "AimBatch.h"
+#include "BodyArray.h"
+
+#include <vector>
+#include <cstdint>
+
+struct SSpawnManifest; //forward declaration
+class CPlayer; //forward declaration
+class CAnt; //forward declaration
+
+/// \brief A contact.
+///
+/// A pair of objects whose bounding circles overlapped at the start of the
+/// collision pass.
+
+struct SContact{
+  CObject* m_p0 = nullptr; ///< Pointer to the first object.
+  CObject* m_p1 = nullptr; ///< Pointer to the second object.
+}; //SContact
+
+/// \brief A crowd neighbor.
+///
+/// The parts of an ant that the separation pass reads about its neighbors.
+/// These are copied out once per step before any ant is steered, so that the
+/// ants can be steered in parallel without reading each other's state.
+
+struct SNeighbor{
+  Vector2 m_vPos; ///< Position.
+  Vector2 m_vVelocity; ///< Velocity.
+  float m_fRadius = 0; ///< Bounding circle radius.
+  CAnt* m_pAnt = nullptr; ///< Pointer to the ant.
+}; //SNeighbor
+
+/// \brief The object manager.
+///
+/// A collection of all of the game objects. The objects are kept in a dense
+/// array, and each object knows its own index in that array. Their bodies
+/// are kept in a second array at the same indices, which is what the move,
+/// steering, aiming and collision loops read. An object that dies
+/// registers itself with `CObject::Kill()`, and once per frame the dead
+/// objects are swap-removed from both arrays, so reclaiming them costs time
+/// proportional to the number of deaths rather than the number of objects.
+
+class CObjectManager: 
+  public LComponent,
+  public CCommon
+{
+  friend class CObject; ///< Objects register themselves, their bodies, and their deaths.
+
+  private:
+    //bool m_bLevelCompleted = false; ///< Level completion flag.
+
+    std::vector<SContact> m_vecContacts; ///< Contacts found this step.
+    std::vector<std::vector<SContact>> m_vecBatches; ///< Contacts in conflict-free batches.
+    std::vector<SContact> m_vecOverflow; ///< Contacts that didn't fit in a batch.
+    std::vector<uint64_t> m_vecBatchMask; ///< Batches that each object is in.
+    const size_t m_nMinBatch = 32; ///< Minimum number of contacts per job.
+
+    UINT m_nContacts = 0; ///< Contacts found since the level started.
+    UINT m_nAntContacts = 0; ///< Contacts between two ants since the level started.
+    UINT m_nContactSteps = 0; ///< Steps that contacts were counted for.
+
+    std::vector<SNeighbor> m_vecNeighbors; ///< Live ants, in object order.
+    std::vector<UINT> m_vecAntCell; ///< Grid cell of each ant.
+    std::vector<UINT> m_vecCellStart; ///< First ant in each grid cell, and one past the last.
+    std::vector<UINT> m_vecCellAnts; ///< Ants sorted by grid cell.
+    size_t m_nCellsWide = 0; ///< Number of grid cells wide.
+    float m_fCellSize = 1; ///< Grid cell width and height.
+
+    bool m_bSeparation = true; ///< Steer ants apart before they collide.
+    float m_fSeparation = 2.0f; ///< Distance to keep between ants, as a multiple of the sum of radii.
+    float m_fAvoidTime = 0.5f; ///< How far ahead to look for collisions, in seconds.
+
+    std::vector<CObject*> m_vecAimers; ///< Turrets that think this step.
+    CAimBatch m_cAimBatch; ///< Their aims.
+
+    std::vector<CObject*> m_vecObjects; ///< Dense array of objects.
+    CBodyArray m_cBodies; ///< Their bodies, at the same indices.
+    size_t m_nStepStart = 0; ///< Number of objects at the start of this step.
+    std::vector<CObject*> m_vecDead; ///< Objects killed this frame.
+
+    std::vector<CEffectQueue> m_vecEffectQueues; ///< One effect queue per object range.
+    const size_t m_nMinRange = 64; ///< Minimum number of objects per range.
+
+    bool m_bThinkLOD = true; ///< Run far away AI at less than the full rate.
+    float m_fThinkNear = 1024.0f; ///< Distance within which AI runs at the full rate.
+    UINT m_nMaxThinkInterval = 8; ///< Most steps between AI steps.
+    UINT m_nBaseThinkInterval = 1; ///< Steps between AI steps when near.
+    UINT m_nThinks = 0; ///< AI steps run since the level started.
+    UINT m_nThinkerSteps = 0; ///< AI steps that could have run since the level started.
+    UINT m_nThinkStep = 0; ///< Steps taken, for scheduling AI.
+    UINT m_nNextThinkPhase = 0; ///< Think phase for the next object added.
+    UINT m_nNextID = 0; ///< ID for the next object added, never reset.
+
+    void Add(CObject*); ///< Add an object to the object array.
+    void MoveObject(size_t); ///< Move one object.
+    void MoveInParallel(); ///< Move the objects that are safe to move in parallel.
+    void ScheduleThinking(); ///< Decide which objects run their AI this step.
+    void SteerAnts(); ///< Steer ants apart.
+    const Vector2 GetSteering(size_t) const; ///< Get one ant's crowd steering.
+    void AimTurrets(); ///< Aim the turrets that can see the player.
+    template<class T> void CreateAll(const std::vector<Vector2>&); ///< Create objects of one type.
+    void CullDeadObjects(); ///< Reclaim the objects killed this frame.
+    void BroadPhase(); ///< Broad phase collision detection and response.
+    void FindContacts(); ///< Find pairs of overlapping objects.
+    void BatchContacts(); ///< Sort contacts into conflict-free batches.
+    void ResolveBatch(const std::vector<SContact>&); ///< Respond to a batch of contacts.
+    void NarrowPhase(CObject*, CObject*); ///< Narrow phase collision detection and response.
+
+  public:
+    ~CObjectManager(); ///< Destructor.
+
+    void clear(); ///< Reset to empty and delete all objects.
+
+    CObject* create(eSprite, const Vector2&); ///< Create new object.
+    CPlayer* Instantiate(const SSpawnManifest&); ///< Create objects from a map.
+    
+    void move(); ///< Move all objects.
+    void BeginStep(); ///< Start a step and move the serial objects.
+    void MoveStep(); ///< Move the rest of the objects.
+    void EndStep(); ///< Collide objects and reclaim the dead.
+    void Snapshot(std::vector<LSpriteDesc2D>&) const; ///< Copy sprites to draw.
+
+    void FireGun(CObject*, eSprite); ///< Fire object's gun.
+    void FireVolley(CObject*, eSprite, const std::vector<float>&, float, float); ///< Fire a volley.
+    const size_t GetNumEnemies() const; ///< Get number of turrets in object list.
+    const uint32_t GetChecksum() const; ///< Get checksum of object states.
+
+    void SetThinkLOD(bool, float, UINT); ///< Set AI level of detail.
+    void SetThinkLOD(bool); ///< Turn AI level of detail on or off.
+    const bool GetThinkLOD() const; ///< Reader function for AI level of detail.
+    void SetThinkInterval(UINT); ///< Set steps between AI steps when near.
+    const UINT GetThinkInterval() const; ///< Get steps between AI steps when near.
+    const float GetThinkNear() const; ///< Get full rate AI distance.
+    const UINT GetMaxThinkInterval() const; ///< Get most steps between AI steps.
+    const float GetThinkFraction() const; ///< Get fraction of AI steps run.
+
+    void SetSeparation(bool, float, float); ///< Set ant separation.
+    void SetSeparation(bool); ///< Turn ant separation on or off.
+    const bool GetSeparation() const; ///< Reader function for ant separation flag.
+    const float GetSeparationDistance() const; ///< Get separation distance.
+    const float GetAvoidTime() const; ///< Get avoidance look-ahead time.
+    const float GetContactsPerStep() const; ///< Get mean contacts per step.
+    const float GetAntContactsPerStep() const; ///< Get mean ant contacts per step.
+    const int maxGhosts = 3;
+    int numOfGhosts = 0;
+    //const bool LevelCompleted() const; ///< Level completed.
+
+    //Difficulty Variables
+    UINT m_nDifficultyModifier = 0; //this stat is used to determine outcomes based on the game's difficulty
+
+}; //CObjectManager
+
+#endif //__L4RC_GAME_OBJECTMANAGER_H__
@@ -0,0 +1,88 @@
+/// \file ParticleSystem.cpp
+/// \brief Code for the particle system CParticleSystem.
+
+#include "ParticleSystem.h"
+#include "SpriteRenderer.h"
+
+#include <algorithm>
+
+/// Create a particle at the start of its life, so that it starts out scaled
+/// to nothing if it scales in. It is drawn there until its first step.
+/// \param d Particle descriptor.
+
+void CParticleSystem::create(const LParticleDesc2D& d){
+  SParticle p;
+  p.m_desc = d;
+
+  if(d.m_fScaleInFrac > 0)
+    p.m_desc.m_fXScale = p.m_desc.m_fYScale = 0;
+
+  else p.m_desc.m_fXScale = p.m_desc.m_fYScale = d.m_fMaxScale;
+
+  p.m_vPrevPos = p.m_desc.m_vPos;
+  p.m_fPrevScale = p.m_desc.m_fXScale;
+  p.m_fPrevAlpha = p.m_desc.m_fAlpha;
+
+  m_vecParticles.push_back(p);
+} //create
+
+/// Age all particles, delete the ones that have outlived their lifespans,
+/// and move, scale and fade the rest. A particle scales up from nothing to
+/// its maximum scale over the first `m_fScaleInFrac` of its life and back
+/// down to nothing over the last `m_fScaleOutFrac`, and fades out over the
+/// last `m_fFadeOutFrac`.
+/// \param t Time since the last step in seconds.
+
+void CParticleSystem::step(float t){
+  auto dead = [](const SParticle& p){return p.m_fAge >= p.m_desc.m_fLifeSpan;};
+
+  for(SParticle& p: m_vecParticles){
+    LParticleDesc2D& d = p.m_desc; //shorthand
+
+    p.m_fAge += t;
+    if(dead(p))continue; //deleted below
+
+    p.m_vPrevPos = d.m_vPos;
+    p.m_fPrevScale = d.m_fXScale;
+    p.m_fPrevAlpha = d.m_fAlpha;
+
+    d.m_vPos += t*d.m_vVel;
+
+    const float life = p.m_fAge/d.m_fLifeSpan; //fraction of lifespan used
+    float scale = d.m_fMaxScale;
+
+    if(life < d.m_fScaleInFrac)
+      scale *= life/d.m_fScaleInFrac;
+
+    else if(d.m_fScaleOutFrac > 0 && life > 1 - d.m_fScaleOutFrac)
+      scale *= (1 - life)/d.m_fScaleOutFrac;
+
+    d.m_fXScale = d.m_fYScale = scale;
+
+    if(d.m_fFadeOutFrac > 0 && life > 1 - d.m_fFadeOutFrac)
+      d.m_fAlpha = (1 - life)/d.m_fFadeOutFrac;
+  } //for
+
+  m_vecParticles.erase(std::remove_if(m_vecParticles.begin(),
+    m_vecParticles.end(), dead), m_vecParticles.end());
+} //step
+
+/// Draw all particles part of the way from where they were before their last
+/// step to where they are now.
+/// \param alpha Fraction of a step since the last step, in [0, 1].
+
+void CParticleSystem::Draw(float alpha){
+  for(const SParticle& p: m_vecParticles){
+    LParticleDesc2D d = p.m_desc; //what gets drawn
+    d.m_vPos = p.m_vPrevPos + alpha*(p.m_desc.m_vPos - p.m_vPrevPos);
+    d.m_fXScale = d.m_fYScale = p.m_fPrevScale + alpha*(p.m_desc.m_fXScale - p.m_fPrevScale);
+    d.m_fAlpha = p.m_fPrevAlpha + alpha*(p.m_desc.m_fAlpha - p.m_fPrevAlpha);
+    m_pRenderer->Draw(&d);
+  } //for
+} //Draw
+
+/// Delete all particles.
+
+void CParticleSystem::clear(){
+  m_vecParticles.clear();
+} //clear
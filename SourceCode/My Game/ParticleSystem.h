@@ -0,0 +1,49 @@
+/// \file ParticleSystem.h
+/// \brief Interface for the particle system CParticleSystem.
+
+#ifndef __L4RC_GAME_PARTICLESYSTEM_H__
+#define __L4RC_GAME_PARTICLESYSTEM_H__
+
+#include "Common.h"
+#include "Particle.h"
+
+#include <vector>
+
+/// \brief A particle.
+///
+/// A particle descriptor and the particle's age, with its position, scale
+/// and fade before its last step so that it can be drawn part of the way
+/// between steps.
+
+struct SParticle{
+  LParticleDesc2D m_desc; ///< Descriptor, updated as the particle ages.
+  float m_fAge = 0; ///< Time since it was created in seconds.
+
+  Vector2 m_vPrevPos; ///< Position before the last step.
+  float m_fPrevScale = 0; ///< Scale before the last step.
+  float m_fPrevAlpha = 1; ///< Fade before the last step.
+}; //SParticle
+
+/// \brief The particle system.
+///
+/// The particles, which are drawn from world snapshots and may be on the
+/// render thread. The engine's particle engine reads the timer, which the
+/// main thread ticks while the render thread is drawing, so the particles
+/// are kept here instead and are only ever told how much time has passed.
+/// They move in a straight line and scale in, scale out, and fade out over
+/// their lifespans as their descriptors say. They may be stepped less often
+/// than they are drawn, in which case they are drawn interpolated between
+/// their last two steps, like the objects are.
+
+class CParticleSystem: public CCommon{
+  private:
+    std::vector<SParticle> m_vecParticles; ///< Live particles.
+
+  public:
+    void create(const LParticleDesc2D&); ///< Create a particle.
+    void step(float); ///< Age all particles.
+    void Draw(float); ///< Draw all particles.
+    void clear(); ///< Delete all particles.
+}; //CParticleSystem
+
+#endif //__L4RC_GAME_PARTICLESYSTEM_H__
@@ -0,0 +1,244 @@
+/// \file PathFinder.cpp
+/// \brief Code for the path finder CPathFinder.
+
+#include "PathFinder.h"
+#include "TileManager.h"
+#include "Helpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/// Find a path between two points. The path goes from the tile under the
+/// start point to the tile under the goal point. The start tile may be a
+/// wall, since chasers that don't collide with walls can end up inside one,
+/// but the goal tile may not.
+/// \param from Start point.
+/// \param to Goal point.
+/// \param path [out] Waypoints, which are the centers of the jump points
+/// after the start tile, except that the last one is the goal point itself.
+/// Its memory is reused.
+/// \return true if there is a path.
+
+bool CPathFinder::FindPath(const Vector2& from, const Vector2& to, std::vector<Vector2>& path){
+  path.clear();
+  m_sStats.m_nQueries++;
+  m_sStats.m_nExpanded = 0;
+
+  size_t i0, j0, i1, j1; //start and goal tiles
+  if(!m_pTileManager->GetTile(from, i0, j0) || !m_pTileManager->GetTile(to, i1, j1))
+    return false; //off the map
+
+  Prepare();
+  if(!Open(i1, j1))return false; //goal in a wall
+
+  const UINT start = (UINT)(i0*m_nWidth + j0); //start index
+  m_nGoal = i1*m_nWidth + j1;
+  m_vecOpen.clear();
+  Push(i0, j0, start, 0); //the start is its own parent
+
+  bool bFound = false; //reached the goal
+
+  while(!m_vecOpen.empty()){
+    std::pop_heap(m_vecOpen.begin(), m_vecOpen.end(), std::greater<>());
+    const UINT n = m_vecOpen.back().second; //node with least estimated cost
+    m_vecOpen.pop_back();
+
+    SPathNode& s = m_vecNode[n]; //shorthand
+    if(s.m_bClosed)continue; //already expanded with a lower cost
+
+    s.m_bClosed = true;
+    m_sStats.m_nExpanded++;
+
+    if(n == m_nGoal){
+      bFound = true;
+      break;
+    } //if
+
+    Expand(n);
+  } //while
+
+  m_sStats.m_nTotalExpanded += m_sStats.m_nExpanded;
+  if(!bFound)return false;
+
+  m_vecJumps.clear();
+
+  for(UINT n=(UINT)m_nGoal; n!=start; n=m_vecNode[n].m_nParent)
+    m_vecJumps.push_back(n);
+
+  for(auto p=m_vecJumps.rbegin(); p!=m_vecJumps.rend(); p++)
+    path.push_back(m_pTileManager->GetTileCenter(*p/m_nWidth, *p%m_nWidth));
+
+  if(path.empty())path.push_back(to); //already on the goal tile
+  else path.back() = to;
+
+  m_sStats.m_nFound++;
+  return true;
+} //FindPath
+
+/// Get the node pool ready for a new search. The pool is only reallocated
+/// when the map changes size. Otherwise the search number is bumped, which
+/// makes every node count as unreached without touching it, and the nodes
+/// are only cleared on the rare occasion that the search number wraps.
+
+void CPathFinder::Prepare(){
+  const size_t w = m_pTileManager->GetWidth(); //map width
+  const size_t h = m_pTileManager->GetHeight(); //map height
+
+  if(w != m_nWidth || h != m_nHeight){ //different map size
+    m_nWidth = w;
+    m_nHeight = h;
+    m_vecNode.assign(w*h, SPathNode());
+    m_nSearch = 0;
+  } //if
+
+  if(++m_nSearch == 0){ //wrapped
+    for(SPathNode& s: m_vecNode)
+      s.m_nSearch = 0;
+
+    m_nSearch = 1;
+  } //if
+} //Prepare
+
+/// Test whether a tile can be walked on.
+/// \param i Row, which may be off the map.
+/// \param j Column, which may be off the map.
+/// \return true if the tile is on the map and isn't a wall.
+
+const bool CPathFinder::Open(size_t i, size_t j) const{
+  return !m_pTileManager->IsWall(i, j);
+} //Open
+
+/// Run from a tile in a direction until reaching a jump point, which is the
+/// goal or a tile where a wall corner just behind it to one side means that
+/// there is a new way to go that can't be reached any quicker another way.
+/// A diagonal run stops at any tile from which a straight run in either of
+/// its two parts reaches a jump point. Diagonal steps past a wall corner
+/// aren't allowed.
+/// \param i [in, out] Row to start from, and of the jump point.
+/// \param j [in, out] Column to start from, and of the jump point.
+/// \param di Row step, -1, 0, or 1.
+/// \param dj Column step, -1, 0, or 1.
+/// \return true if there is a jump point in that direction.
+
+const bool CPathFinder::Jump(size_t& i, size_t& j, int di, int dj) const{
+  while(true){
+    if(di != 0 && dj != 0 && (!Open(i + di, j) || !Open(i, j + dj)))
+      return false; //would cut a corner
+
+    i += di; j += dj; //wraps if off the map, which IsWall catches
+    if(!Open(i, j))return false;
+    if(i*m_nWidth + j == m_nGoal)return true;
+
+    if(di != 0 && dj != 0){ //diagonal
+      size_t i1 = i, j1 = j; //for vertical run
+      size_t i2 = i, j2 = j; //for horizontal run
+      if(Jump(i1, j1, di, 0) || Jump(i2, j2, 0, dj))return true;
+    } //if
+
+    else if(dj != 0){ //horizontal
+      if((Open(i - 1, j) && !Open(i - 1, j - dj)) || (Open(i + 1, j) && !Open(i + 1, j - dj)))
+        return true; //forced neighbor above or below
+    } //else if
+
+    else if((Open(i, j - 1) && !Open(i - di, j - 1)) || (Open(i, j + 1) && !Open(i - di, j + 1)))
+      return true; //vertical with forced neighbor left or right
+  } //while
+} //Jump
+
+/// Expand a node by running from it in each direction that might lead
+/// somewhere new and adding the jump points found to the open list. The
+/// start goes in all eight directions. Any other node only goes on in the
+/// direction that it was reached in, plus the directions that a wall corner
+/// beside it may have opened up, since anywhere else is reached at least as
+/// quickly without going through it.
+/// \param n Node index.
+
+void CPathFinder::Expand(UINT n){
+  const size_t i = n/m_nWidth; //row
+  const size_t j = n%m_nWidth; //column
+  const SPathNode& s = m_vecNode[n]; //shorthand
+
+  int di[8], dj[8]; //directions to run in
+  int k = 0; //number of directions
+
+  if(s.m_nParent == n){ //start, so all directions
+    for(int a=-1; a<=1; a++)
+      for(int b=-1; b<=1; b++)
+        if(a != 0 || b != 0){
+          di[k] = a; dj[k++] = b;
+        } //if
+  } //if
+
+  else{
+    const size_t ip = s.m_nParent/m_nWidth; //parent row
+    const size_t jp = s.m_nParent%m_nWidth; //parent column
+    const int a = (i > ip) - (i < ip); //row direction reached in
+    const int b = (j > jp) - (j < jp); //column direction reached in
+
+    if(a != 0 && b != 0){ //diagonal
+      di[k] = a; dj[k++] = b;
+      di[k] = a; dj[k++] = 0;
+      di[k] = 0; dj[k++] = b;
+    } //if
+
+    else if(b != 0){ //horizontal
+      for(int c=-1; c<=1; c++){
+        di[k] = c; dj[k++] = b;
+      } //for
+
+      di[k] = -1; dj[k++] = 0;
+      di[k] = 1; dj[k++] = 0;
+    } //else if
+
+    else{ //vertical
+      for(int c=-1; c<=1; c++){
+        di[k] = a; dj[k++] = c;
+      } //for
+
+      di[k] = 0; dj[k++] = -1;
+      di[k] = 0; dj[k++] = 1;
+    } //else
+  } //else
+
+  for(int e=0; e<k; e++){
+    size_t i1 = i, j1 = j; //jump point
+
+    if(Jump(i1, j1, di[e], dj[e]))
+      Push(i1, j1, n, s.m_fCost + OctileDistance(i, j, i1, j1));
+  } //for
+} //Expand
+
+/// Add a node to the open list, unless it has already been reached by a
+/// path that costs no more.
+/// \param i Row.
+/// \param j Column.
+/// \param parent Index of the jump point that it was reached from.
+/// \param cost Cost of the path to it from the start.
+
+void CPathFinder::Push(size_t i, size_t j, UINT parent, float cost){
+  const UINT n = (UINT)(i*m_nWidth + j); //node index
+  SPathNode& s = m_vecNode[n]; //shorthand
+
+  if(s.m_nSearch != m_nSearch){ //first time this search
+    s.m_nSearch = m_nSearch;
+    s.m_bClosed = false;
+  } //if
+
+  else if(s.m_bClosed || cost >= s.m_fCost)
+    return; //no better
+
+  s.m_fCost = cost;
+  s.m_nParent = parent;
+
+  const float f = cost + OctileDistance(i, j, m_nGoal/m_nWidth, m_nGoal%m_nWidth); //estimated cost
+  m_vecOpen.push_back(std::make_pair(f, n));
+  std::push_heap(m_vecOpen.begin(), m_vecOpen.end(), std::greater<>());
+} //Push
+
+/// Reader function for the statistics.
+/// \return Path finding statistics.
+
+const SPathStats& CPathFinder::GetStats() const{
+  return m_sStats;
+} //GetStats
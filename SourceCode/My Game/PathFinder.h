@@ -0,0 +1,71 @@
+/// \file PathFinder.h
+/// \brief Interface for the path finder CPathFinder.
+
+#ifndef __L4RC_GAME_PATHFINDER_H__
+#define __L4RC_GAME_PATHFINDER_H__
+
+#include "Common.h"
+
+#include <utility>
+#include <vector>
+
+/// \brief A path finding node.
+///
+/// What a search knows about a tile. A node whose search number isn't the
+/// current search's hasn't been reached yet, so the nodes never need to be
+/// cleared between searches.
+
+struct SPathNode{
+  float m_fCost = 0; ///< Cost of the best path to here found so far.
+  UINT m_nParent = 0; ///< Index of previous jump point on that path.
+  UINT m_nSearch = 0; ///< Search that last reached this node.
+  bool m_bClosed = false; ///< Expanded by that search.
+}; //SPathNode
+
+/// \brief Path finding statistics.
+
+struct SPathStats{
+  UINT m_nQueries = 0; ///< Paths asked for so far.
+  UINT m_nFound = 0; ///< Paths found so far.
+  UINT m_nExpanded = 0; ///< Nodes expanded by the last search.
+  UINT m_nTotalExpanded = 0; ///< Nodes expanded so far.
+}; //SPathStats
+
+/// \brief The path finder.
+///
+/// A* over the tiles of the map with Jump Point Search. Moves are to any of
+/// the eight neighbors of a tile, but not diagonally past a wall corner.
+/// Instead of adding every neighbor of a tile to the open list, JPS runs in
+/// a straight line from it until something interesting happens, a wall
+/// corner that opens up a new way to go or the goal, and only adds that tile,
+/// so on open maps a search touches a handful of nodes instead of hundreds.
+/// The path is the list of jump points, which are joined by straight or
+/// diagonal lines of non-wall tiles. The node pool and the open list are
+/// members that are kept from one search to the next, so a search allocates
+/// nothing unless the map has grown. It must only be used on the main thread.
+
+class CPathFinder: public CCommon{
+  private:
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    size_t m_nGoal = 0; ///< Index of goal tile in the current search.
+    UINT m_nSearch = 0; ///< Current search number.
+
+    std::vector<SPathNode> m_vecNode; ///< Node pool, one per tile.
+    std::vector<std::pair<float, UINT>> m_vecOpen; ///< Open list, a heap of estimated cost and node index.
+    std::vector<UINT> m_vecJumps; ///< Jump points of the last path, goal first.
+
+    SPathStats m_sStats; ///< Statistics.
+
+    void Prepare(); ///< Get the node pool ready for a search.
+    const bool Open(size_t, size_t) const; ///< Can a tile be walked on.
+    const bool Jump(size_t&, size_t&, int, int) const; ///< Find next jump point.
+    void Expand(UINT); ///< Add a node's jump points to the open list.
+    void Push(size_t, size_t, UINT, float); ///< Add a node to the open list.
+
+  public:
+    bool FindPath(const Vector2&, const Vector2&, std::vector<Vector2>&); ///< Find a path.
+    const SPathStats& GetStats() const; ///< Reader function for statistics.
+}; //CPathFinder
+
+#endif //__L4RC_GAME_PATHFINDER_H__
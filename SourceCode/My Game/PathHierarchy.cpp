@@ -0,0 +1,553 @@
+/// \file PathHierarchy.cpp
+/// \brief Code for the hierarchical path finder CPathHierarchy.
+
+#include "PathHierarchy.h"
+#include "TileManager.h"
+#include "Helpers.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <functional>
+
+/// Border runs of open tiles at least this long get an entrance at each end
+/// instead of one in the middle.
+
+static const size_t LONG_RUN = 6;
+
+/// Constructor.
+/// \param n Cluster width and height in tiles.
+
+CPathHierarchy::CPathHierarchy(size_t n):
+  m_nClusterSize(std::max(n, (size_t)2)){
+} //constructor
+
+/// Bring the hierarchy up to date with the map. If a new map has been loaded
+/// or restored since it was built, build it again from scratch. If some
+/// tiles have changed since, mark their clusters dirty and rebuild those.
+/// This is done when a map is loaded, and again before each query in case
+/// tiles have changed in between.
+
+void CPathHierarchy::Update(){
+  const CTileManager* p = m_pTileManager; //shorthand
+  const UINT v = p->GetVersion(); //current map version
+
+  if(v == m_nVersion && !m_vecCluster.empty())
+    return; //up to date
+
+  const UINT v0 = p->GetLoadVersion(); //version when map was loaded
+  const std::vector<size_t>& vecEdits = p->GetEdits(); //tiles changed since
+
+  if(m_vecCluster.empty() || m_nVersion < v0 || m_nVersion > v ||
+    p->GetWidth() != m_nWidth || p->GetHeight() != m_nHeight)
+    Build(); //different map
+
+  else{
+    for(size_t k=m_nVersion - v0; k<vecEdits.size(); k++) //edits not yet seen
+      m_vecDirty[GetCluster(vecEdits[k])] = true;
+
+    Rebuild();
+  } //else
+
+  m_nVersion = v;
+} //Update
+
+/// Get the cluster that a tile is in.
+/// \param n Tile index.
+/// \return Cluster index.
+
+const size_t CPathHierarchy::GetCluster(size_t n) const{
+  const size_t i = n/m_nWidth; //row
+  const size_t j = n%m_nWidth; //column
+
+  return (i/m_nClusterSize)*m_nClustersWide + j/m_nClusterSize;
+} //GetCluster
+
+/// Build the hierarchy from scratch: cut the map into clusters, find the
+/// entrances on every border, cache the costs between the entrances of each
+/// cluster, and join it all up into the abstract graph.
+
+void CPathHierarchy::Build(){
+  const size_t t = m_nClusterSize; //shorthand
+
+  m_nWidth = m_pTileManager->GetWidth();
+  m_nHeight = m_pTileManager->GetHeight();
+  m_nClustersWide = (m_nWidth + t - 1)/t;
+  m_nClustersHigh = (m_nHeight + t - 1)/t;
+
+  const size_t n = m_nClustersWide*m_nClustersHigh; //number of clusters
+  m_vecCluster.assign(n, SCluster());
+  m_vecDirty.assign(n, false);
+  m_vecNodeTile.clear();
+  m_vecNodeOf.assign(m_nWidth*m_nHeight, UINT_MAX);
+
+  for(size_t k=0; k<n; k++){ //bounds
+    SCluster& s = m_vecCluster[k]; //shorthand
+    s.m_nRow = (k/m_nClustersWide)*t;
+    s.m_nCol = (k%m_nClustersWide)*t;
+    s.m_nRows = std::min(t, m_nHeight - s.m_nRow);
+    s.m_nCols = std::min(t, m_nWidth - s.m_nCol);
+  } //for
+
+  for(size_t k=0; k<n; k++){
+    MakeBorder(k, true);
+    MakeBorder(k, false);
+  } //for
+
+  for(size_t k=0; k<n; k++){
+    CollectTiles(k);
+    MakeCosts(k);
+  } //for
+
+  MakeGraph();
+
+  m_sStats.m_nBuilds++;
+  m_sStats.m_nClusters = (UINT)n;
+} //Build
+
+/// Rebuild the dirty clusters. The borders on all four sides of a dirty
+/// cluster are done again, which may move the entrances of its neighbors as
+/// well as its own. The cached costs are worked out again for each dirty
+/// cluster, and for each neighbor whose entrances moved. Other clusters are
+/// left alone. Finally the abstract graph is joined up again.
+
+void CPathHierarchy::Rebuild(){
+  const size_t n = m_vecCluster.size(); //number of clusters
+  const size_t w = m_nClustersWide; //shorthand
+
+  for(size_t k=0; k<n; k++)
+    if(m_vecDirty[k]){
+      MakeBorder(k, true); //right
+      MakeBorder(k, false); //below
+      if(k%w > 0)MakeBorder(k - 1, true); //left
+      if(k >= w)MakeBorder(k - w, false); //above
+    } //if
+
+  std::vector<UINT> vecOld; //entrance tiles before
+
+  for(size_t k=0; k<n; k++){
+    const bool bDirty = m_vecDirty[k]; //tiles changed in this cluster
+    const bool bNear = bDirty || //this or a neighbor is dirty
+      (k%w > 0 && m_vecDirty[k - 1]) || (k%w + 1 < w && m_vecDirty[k + 1]) ||
+      (k >= w && m_vecDirty[k - w]) || (k + w < n && m_vecDirty[k + w]);
+
+    if(!bNear)continue; //unaffected
+
+    SCluster& s = m_vecCluster[k]; //shorthand
+    vecOld = s.m_vecTiles;
+    CollectTiles(k);
+
+    if(bDirty || s.m_vecTiles != vecOld){
+      MakeCosts(k);
+      m_sStats.m_nRebuilt++;
+    } //if
+  } //for
+
+  m_vecDirty.assign(n, false);
+  MakeGraph();
+} //Rebuild
+
+/// Find the entrances on the border between a cluster and the one to its
+/// right or the one below it. Walk along the border looking for runs of
+/// places where the tiles on both sides are open. A short run gets one
+/// entrance in the middle, a long one an entrance at each end.
+/// \param k Cluster index.
+/// \param bEast true for the border on the right, false for the one below.
+
+void CPathHierarchy::MakeBorder(size_t k, bool bEast){
+  SCluster& s = m_vecCluster[k]; //shorthand
+  std::vector<std::pair<UINT, UINT>>& v = bEast? s.m_vecEast: s.m_vecSouth;
+  v.clear();
+
+  if(bEast? k%m_nClustersWide + 1 >= m_nClustersWide: k + m_nClustersWide >= m_vecCluster.size())
+    return; //nothing on the other side
+
+  const size_t len = bEast? s.m_nRows: s.m_nCols; //border length
+
+  auto Tile = [&](size_t u, size_t& i, size_t& j){ //tile this side of place u
+    i = bEast? s.m_nRow + u: s.m_nRow + s.m_nRows - 1;
+    j = bEast? s.m_nCol + s.m_nCols - 1: s.m_nCol + u;
+  }; //Tile
+
+  auto Add = [&](size_t u){ //add an entrance at place u
+    size_t i, j; //tile this side
+    Tile(u, i, j);
+    const size_t n = i*m_nWidth + j; //tile index
+    v.push_back(std::make_pair((UINT)n, (UINT)(bEast? n + 1: n + m_nWidth)));
+  }; //Add
+
+  size_t run = 0; //length of current run of open places
+
+  for(size_t u=0; u<=len; u++){
+    bool bOpen = false; //both sides open
+
+    if(u < len){
+      size_t i, j; //tile this side
+      Tile(u, i, j);
+      bOpen = !m_pTileManager->IsWall(i, j) &&
+        !m_pTileManager->IsWall(bEast? i: i + 1, bEast? j + 1: j);
+    } //if
+
+    if(bOpen)run++;
+
+    else if(run > 0){ //end of run
+      if(run < LONG_RUN)Add(u - run + run/2);
+
+      else{
+        Add(u - run);
+        Add(u - 1);
+      } //else
+
+      run = 0;
+    } //else if
+  } //for
+} //MakeBorder
+
+/// List the entrance tiles on this side of all four borders of a cluster,
+/// in order and without duplicates, since a corner tile can be on two.
+/// \param k Cluster index.
+
+void CPathHierarchy::CollectTiles(size_t k){
+  SCluster& s = m_vecCluster[k]; //shorthand
+  std::vector<UINT>& v = s.m_vecTiles; //shorthand
+  v.clear();
+
+  for(const auto& p: s.m_vecEast)v.push_back(p.first);
+  for(const auto& p: s.m_vecSouth)v.push_back(p.first);
+
+  if(k%m_nClustersWide > 0) //cluster to the left
+    for(const auto& p: m_vecCluster[k - 1].m_vecEast)v.push_back(p.second);
+
+  if(k >= m_nClustersWide) //cluster above
+    for(const auto& p: m_vecCluster[k - m_nClustersWide].m_vecSouth)v.push_back(p.second);
+
+  std::sort(v.begin(), v.end());
+  v.erase(std::unique(v.begin(), v.end()), v.end());
+} //CollectTiles
+
+/// Cache the cost of getting from each entrance tile of a cluster to each
+/// other one without leaving the cluster.
+/// \param k Cluster index.
+
+void CPathHierarchy::MakeCosts(size_t k){
+  SCluster& s = m_vecCluster[k]; //shorthand
+  const size_t n = s.m_vecTiles.size(); //number of entrance tiles
+  s.m_vecCost.assign(n*n, FLT_MAX);
+
+  for(size_t a=0; a<n; a++){
+    SearchCluster(k, s.m_vecTiles[a]);
+
+    for(size_t b=0; b<n; b++)
+      s.m_vecCost[a*n + b] = GetLocal(k, s.m_vecTiles[b]);
+  } //for
+} //MakeCosts
+
+/// Join the clusters up into the abstract graph. Each cluster's entrance
+/// tiles become a block of nodes. The edges leaving each node are stored
+/// together, first the cached ones to the other entrance tiles of its
+/// cluster that it can reach, then the ones across borders.
+
+void CPathHierarchy::MakeGraph(){
+  for(UINT t: m_vecNodeTile) //forget the old nodes
+    m_vecNodeOf[t] = UINT_MAX;
+
+  const size_t n = m_vecCluster.size(); //number of clusters
+  m_vecNodeTile.clear();
+  m_vecFirstNode.resize(n);
+
+  for(size_t k=0; k<n; k++){ //nodes
+    m_vecFirstNode[k] = (UINT)m_vecNodeTile.size();
+
+    for(UINT t: m_vecCluster[k].m_vecTiles){
+      m_vecNodeOf[t] = (UINT)m_vecNodeTile.size();
+      m_vecNodeTile.push_back(t);
+    } //for
+  } //for
+
+  const size_t nNodes = m_vecNodeTile.size(); //number of nodes
+  m_vecEdgeStart.assign(nNodes + 1, 0);
+
+  for(int pass=0; pass<2; pass++){ //count edges, then fill them in
+    for(size_t k=0; k<n; k++){
+      const SCluster& s = m_vecCluster[k]; //shorthand
+      const size_t m = s.m_vecTiles.size(); //number of entrance tiles
+      const UINT first = m_vecFirstNode[k]; //first node
+
+      for(size_t a=0; a<m; a++) //within cluster
+        for(size_t b=0; b<m; b++)
+          if(a != b && s.m_vecCost[a*m + b] < FLT_MAX){
+            if(pass == 0)m_vecEdgeStart[first + a]++;
+            else m_vecEdge[m_vecEdgeStart[first + a]++] = {first + (UINT)b, s.m_vecCost[a*m + b]};
+          } //if
+
+      for(const auto* v: {&s.m_vecEast, &s.m_vecSouth}) //across borders
+        for(const auto& p: *v){
+          const UINT u0 = m_vecNodeOf[p.first]; //node this side
+          const UINT u1 = m_vecNodeOf[p.second]; //node other side
+
+          if(pass == 0){
+            m_vecEdgeStart[u0]++;
+            m_vecEdgeStart[u1]++;
+          } //if
+
+          else{
+            m_vecEdge[m_vecEdgeStart[u0]++] = {u1, 1.0f};
+            m_vecEdge[m_vecEdgeStart[u1]++] = {u0, 1.0f};
+          } //else
+        } //for
+    } //for
+
+    if(pass == 0){ //counts to starts
+      UINT sum = 0; //edges so far
+
+      for(size_t u=0; u<=nNodes; u++){
+        const UINT count = m_vecEdgeStart[u]; //edges leaving node u
+        m_vecEdgeStart[u] = sum;
+        sum += count;
+      } //for
+
+      m_vecEdge.resize(sum);
+    } //if
+  } //for
+
+  for(size_t u=nNodes; u>0; u--) //filling moved each start on to the next
+    m_vecEdgeStart[u] = m_vecEdgeStart[u - 1];
+
+  m_vecEdgeStart[0] = 0;
+
+  m_sStats.m_nNodes = (UINT)nNodes;
+  m_sStats.m_nEdges = (UINT)m_vecEdge.size();
+} //MakeGraph
+
+/// Find the cost of getting from a tile to every tile of its cluster without
+/// leaving the cluster, using Dijkstra's algorithm with the same moves as
+/// the JPS path finder. The start tile may be a wall.
+/// \param k Cluster index.
+/// \param n Index of start tile, which must be in the cluster.
+
+void CPathHierarchy::SearchCluster(size_t k, size_t n){
+  const SCluster& s = m_vecCluster[k]; //shorthand
+  const CTileManager* p = m_pTileManager; //shorthand
+
+  m_vecLocal.assign(s.m_nRows*s.m_nCols, FLT_MAX);
+  m_vecHeap.clear();
+
+  const UINT start = (UINT)((n/m_nWidth - s.m_nRow)*s.m_nCols + n%m_nWidth - s.m_nCol); //local index
+  m_vecLocal[start] = 0;
+  m_vecHeap.push_back(std::make_pair(0.0f, start));
+
+  while(!m_vecHeap.empty()){
+    std::pop_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<>());
+    const float d = m_vecHeap.back().first; //cost to this tile
+    const UINT u = m_vecHeap.back().second; //local index of this tile
+    m_vecHeap.pop_back();
+
+    if(d > m_vecLocal[u])continue; //already done with a lower cost
+
+    const size_t i = s.m_nRow + u/s.m_nCols; //row
+    const size_t j = s.m_nCol + u%s.m_nCols; //column
+
+    for(int a=-1; a<=1; a++) //row offset
+      for(int b=-1; b<=1; b++){ //column offset
+        const size_t i1 = i + a, j1 = j + b; //neighbor, wraps if off the map
+        if((a == 0 && b == 0) || i1 - s.m_nRow >= s.m_nRows || j1 - s.m_nCol >= s.m_nCols)
+          continue; //not a neighbor in the cluster
+        if(p->IsWall(i1, j1))continue;
+        if(a != 0 && b != 0 && (p->IsWall(i1, j) || p->IsWall(i, j1)))continue; //corner
+
+        const float d1 = d + (a != 0 && b != 0? 1.41421356f: 1.0f); //cost to neighbor
+        const UINT u1 = (UINT)((i1 - s.m_nRow)*s.m_nCols + j1 - s.m_nCol); //neighbor local index
+
+        if(d1 < m_vecLocal[u1]){
+          m_vecLocal[u1] = d1;
+          m_vecHeap.push_back(std::make_pair(d1, u1));
+          std::push_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<>());
+        } //if
+      } //for
+  } //while
+} //SearchCluster
+
+/// Get the cost to a tile found by the last cluster search.
+/// \param k Cluster index.
+/// \param n Tile index, which must be in the cluster.
+/// \return Cost in tiles, or `FLT_MAX` if it can't be reached.
+
+const float CPathHierarchy::GetLocal(size_t k, size_t n) const{
+  const SCluster& s = m_vecCluster[k]; //shorthand
+  return m_vecLocal[(n/m_nWidth - s.m_nRow)*s.m_nCols + n%m_nWidth - s.m_nCol];
+} //GetLocal
+
+/// Search the abstract graph with A*, with the start and goal tiles joined
+/// in as two extra nodes. The start has edges to the entrances of its
+/// cluster and the entrances of the goal's cluster have edges to the goal,
+/// costing what a search of the cluster says. The node pool is reused, with
+/// search numbers as in the JPS path finder.
+/// \param s Index of start tile.
+/// \param g Index of goal tile.
+/// \param cs Start cluster.
+/// \param cg Goal cluster, which must be different from the start cluster.
+/// \return true if there is a path, which is left in `m_vecPath`.
+
+bool CPathHierarchy::SearchAbstract(size_t s, size_t g, size_t cs, size_t cg){
+  const UINT nNodes = (UINT)m_vecNodeTile.size(); //number of nodes in graph
+  const UINT start = nNodes; //start node
+  const UINT goal = nNodes + 1; //goal node
+
+  if(m_vecNode.size() < nNodes + 2)
+    m_vecNode.resize(nNodes + 2);
+
+  if(++m_nSearch == 0){ //wrapped
+    for(SPathNode& p: m_vecNode)
+      p.m_nSearch = 0;
+
+    m_nSearch = 1;
+  } //if
+
+  const SCluster& a = m_vecCluster[cs]; //start cluster
+  SearchCluster(cs, s);
+  m_vecStartCost.resize(a.m_vecTiles.size());
+
+  for(size_t k=0; k<a.m_vecTiles.size(); k++)
+    m_vecStartCost[k] = GetLocal(cs, a.m_vecTiles[k]);
+
+  const SCluster& b = m_vecCluster[cg]; //goal cluster
+  SearchCluster(cg, g);
+  m_vecGoalCost.resize(b.m_vecTiles.size());
+
+  for(size_t k=0; k<b.m_vecTiles.size(); k++)
+    m_vecGoalCost[k] = GetLocal(cg, b.m_vecTiles[k]);
+
+  const size_t gi = g/m_nWidth, gj = g%m_nWidth; //goal row and column
+
+  auto Push = [&](UINT n, UINT parent, float cost, size_t t){ //add node n on tile t
+    SPathNode& p = m_vecNode[n]; //shorthand
+
+    if(p.m_nSearch != m_nSearch){ //first time this search
+      p.m_nSearch = m_nSearch;
+      p.m_bClosed = false;
+    } //if
+
+    else if(p.m_bClosed || cost >= p.m_fCost)
+      return; //no better
+
+    p.m_fCost = cost;
+    p.m_nParent = parent;
+
+    const float f = cost + OctileDistance(t/m_nWidth, t%m_nWidth, gi, gj); //estimated cost
+    m_vecHeap.push_back(std::make_pair(f, n));
+    std::push_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<>());
+  }; //Push
+
+  m_vecHeap.clear();
+  Push(start, start, 0, s);
+  bool bFound = false; //reached the goal
+
+  while(!m_vecHeap.empty()){
+    std::pop_heap(m_vecHeap.begin(), m_vecHeap.end(), std::greater<>());
+    const UINT n = m_vecHeap.back().second; //node with least estimated cost
+    m_vecHeap.pop_back();
+
+    SPathNode& p = m_vecNode[n]; //shorthand
+    if(p.m_bClosed)continue; //already expanded with a lower cost
+
+    p.m_bClosed = true;
+    m_sStats.m_nExpanded++;
+
+    if(n == goal){
+      bFound = true;
+      break;
+    } //if
+
+    const float cost = p.m_fCost; //cost to here
+
+    if(n == start){ //to the entrances of the start cluster
+      for(size_t k=0; k<a.m_vecTiles.size(); k++)
+        if(m_vecStartCost[k] < FLT_MAX)
+          Push(m_vecFirstNode[cs] + (UINT)k, start, m_vecStartCost[k], a.m_vecTiles[k]);
+    } //if
+
+    else{
+      for(UINT e=m_vecEdgeStart[n]; e<m_vecEdgeStart[n + 1]; e++){ //edges
+        const SAbstractEdge& r = m_vecEdge[e]; //shorthand
+        Push(r.m_nTo, n, cost + r.m_fCost, m_vecNodeTile[r.m_nTo]);
+      } //for
+
+      const UINT k = n - m_vecFirstNode[cg]; //index in goal cluster, wraps if below
+
+      if(k < b.m_vecTiles.size() && m_vecGoalCost[k] < FLT_MAX) //to the goal
+        Push(goal, n, cost + m_vecGoalCost[k], g);
+    } //else
+  } //while
+
+  if(!bFound)return false;
+
+  m_vecPath.clear();
+
+  for(UINT n=goal; n!=start; n=m_vecNode[n].m_nParent)
+    m_vecPath.push_back(n == goal? (UINT)g: m_vecNodeTile[n]);
+
+  m_vecPath.push_back((UINT)s);
+  std::reverse(m_vecPath.begin(), m_vecPath.end());
+
+  return true;
+} //SearchAbstract
+
+/// Find a path between two points. If they are in the same or neighboring
+/// clusters, just ask the JPS path finder. Otherwise search the abstract
+/// graph, then ask the JPS path finder for each hop of the abstract path,
+/// which is short, and join the pieces together.
+/// \param from Start point.
+/// \param to Goal point.
+/// \param path [out] Waypoints, ending with the goal point itself. Its
+/// memory is reused.
+/// \return true if there is a path.
+
+bool CPathHierarchy::FindPath(const Vector2& from, const Vector2& to, std::vector<Vector2>& path){
+  path.clear();
+  Update();
+
+  m_sStats.m_nQueries++;
+  m_sStats.m_nExpanded = 0;
+
+  size_t i0, j0, i1, j1; //start and goal tiles
+  if(!m_pTileManager->GetTile(from, i0, j0) || !m_pTileManager->GetTile(to, i1, j1))
+    return false; //off the map
+  if(m_pTileManager->IsWall(i1, j1))return false; //goal in a wall
+
+  const size_t cs = GetCluster(i0*m_nWidth + j0); //start cluster
+  const size_t cg = GetCluster(i1*m_nWidth + j1); //goal cluster
+  const size_t w = m_nClustersWide; //shorthand
+
+  const size_t di = std::max(cs/w, cg/w) - std::min(cs/w, cg/w); //cluster rows apart
+  const size_t dj = std::max(cs%w, cg%w) - std::min(cs%w, cg%w); //cluster columns apart
+
+  if(di <= 1 && dj <= 1) //near, so no need for the abstract graph
+    return m_pPathFinder->FindPath(from, to, path);
+
+  if(!SearchAbstract(i0*m_nWidth + j0, i1*m_nWidth + j1, cs, cg))
+    return false;
+
+  for(size_t k=1; k<m_vecPath.size(); k++){ //refine each hop
+    const size_t t0 = m_vecPath[k - 1]; //tile at start of hop
+    const size_t t1 = m_vecPath[k]; //tile at end of hop
+
+    const Vector2 v0 = k == 1? from: m_pTileManager->GetTileCenter(t0/m_nWidth, t0%m_nWidth);
+    const Vector2 v1 = k + 1 == m_vecPath.size()? to: m_pTileManager->GetTileCenter(t1/m_nWidth, t1%m_nWidth);
+
+    if(!m_pPathFinder->FindPath(v0, v1, m_vecSegment)){ //shouldn't happen
+      path.clear();
+      return false;
+    } //if
+
+    path.insert(path.end(), m_vecSegment.begin(), m_vecSegment.end());
+  } //for
+
+  return true;
+} //FindPath
+
+/// Reader function for the statistics.
+/// \return Hierarchical path finding statistics.
+
+const SHierarchyStats& CPathHierarchy::GetStats() const{
+  return m_sStats;
+} //GetStats
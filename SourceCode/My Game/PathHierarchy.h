@@ -0,0 +1,124 @@
+/// \file PathHierarchy.h
+/// \brief Interface for the hierarchical path finder CPathHierarchy.
+
+#ifndef __L4RC_GAME_PATHHIERARCHY_H__
+#define __L4RC_GAME_PATHHIERARCHY_H__
+
+#include "Common.h"
+#include "PathFinder.h"
+
+#include <utility>
+#include <vector>
+
+/// \brief A cluster of tiles.
+///
+/// A square block of the map, smaller at the right and bottom edges, with
+/// its entrances and the cached costs of getting from each entrance to each
+/// other one without leaving the cluster.
+
+struct SCluster{
+  size_t m_nRow = 0; ///< Top row.
+  size_t m_nCol = 0; ///< Left column.
+  size_t m_nRows = 0; ///< Number of rows.
+  size_t m_nCols = 0; ///< Number of columns.
+
+  std::vector<std::pair<UINT, UINT>> m_vecEast; ///< Entrances to the cluster to the right, this side first.
+  std::vector<std::pair<UINT, UINT>> m_vecSouth; ///< Entrances to the cluster below, this side first.
+  std::vector<UINT> m_vecTiles; ///< Entrance tiles on this side of all four borders, in order.
+  std::vector<float> m_vecCost; ///< Costs between entrance tiles, row by row, `FLT_MAX` if none.
+}; //SCluster
+
+/// \brief An edge of the abstract graph.
+
+struct SAbstractEdge{
+  UINT m_nTo = 0; ///< Node at the other end.
+  float m_fCost = 0; ///< Cost in tiles.
+}; //SAbstractEdge
+
+/// \brief Hierarchical path finding statistics.
+
+struct SHierarchyStats{
+  UINT m_nClusters = 0; ///< Number of clusters.
+  UINT m_nNodes = 0; ///< Nodes in the abstract graph.
+  UINT m_nEdges = 0; ///< Edges in the abstract graph, counting each way.
+  UINT m_nBuilds = 0; ///< Times built from scratch.
+  UINT m_nRebuilt = 0; ///< Clusters rebuilt after tile changes so far.
+  UINT m_nQueries = 0; ///< Paths asked for so far.
+  UINT m_nExpanded = 0; ///< Abstract nodes expanded by the last search.
+}; //SHierarchyStats
+
+/// \brief The hierarchical path finder.
+///
+/// HPA* over the tile map. The map is cut into square clusters. Wherever
+/// two neighboring clusters have a run of open tiles facing each other
+/// across their border, there are entrances, one in the middle of a short
+/// run or one at each end of a long one. The abstract graph has a node for
+/// each entrance tile, an edge across the border for each entrance, and an
+/// edge between each pair of entrance tiles in a cluster that can reach each
+/// other inside it, costing the length of the shortest path between them
+/// there, which is cached.
+///
+/// A long path is found by joining the start and goal to the entrances of
+/// their clusters, searching the small abstract graph with A*, and then
+/// refining each hop of the abstract path into tiles with the JPS path
+/// finder, which only has to look a cluster or so ahead. A short path, with
+/// the start and goal in the same or neighboring clusters, goes straight to
+/// the JPS path finder. Paths are near optimal rather than optimal, since
+/// they must go through entrances.
+///
+/// The hierarchy is built when a map is loaded. When tiles change, only the
+/// clusters that they are in and the borders of those clusters are redone,
+/// and the cached costs are only worked out again for those clusters and any
+/// neighbors whose entrances moved. The abstract graph itself is then joined
+/// back up from the clusters, which is quick. It must only be used on the
+/// main thread.
+
+class CPathHierarchy: public CCommon{
+  private:
+    size_t m_nClusterSize = 8; ///< Cluster width and height in tiles.
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+    size_t m_nClustersWide = 0; ///< Number of clusters wide.
+    size_t m_nClustersHigh = 0; ///< Number of clusters high.
+    UINT m_nVersion = 0; ///< Map version that the hierarchy was built from.
+
+    std::vector<SCluster> m_vecCluster; ///< Clusters, row by row.
+    std::vector<bool> m_vecDirty; ///< Clusters with changed tiles.
+
+    std::vector<UINT> m_vecFirstNode; ///< First abstract node of each cluster.
+    std::vector<UINT> m_vecNodeTile; ///< Tile of each abstract node.
+    std::vector<UINT> m_vecNodeOf; ///< Abstract node of each tile, or `UINT_MAX`.
+    std::vector<UINT> m_vecEdgeStart; ///< First edge of each abstract node, and one past the last.
+    std::vector<SAbstractEdge> m_vecEdge; ///< Edges, grouped by the node that they leave.
+
+    std::vector<float> m_vecLocal; ///< Costs from a tile within its cluster.
+    std::vector<std::pair<float, UINT>> m_vecHeap; ///< Open list for searches.
+    std::vector<SPathNode> m_vecNode; ///< Abstract node pool, plus the start and goal.
+    UINT m_nSearch = 0; ///< Current abstract search number.
+    std::vector<float> m_vecStartCost; ///< Costs from the start to its cluster's entrances.
+    std::vector<float> m_vecGoalCost; ///< Costs to the goal from its cluster's entrances.
+    std::vector<UINT> m_vecPath; ///< Tiles on the abstract path, start first.
+    std::vector<Vector2> m_vecSegment; ///< Refined waypoints for one hop.
+
+    SHierarchyStats m_sStats; ///< Statistics.
+
+    const size_t GetCluster(size_t) const; ///< Get cluster of a tile.
+    void Build(); ///< Build from scratch.
+    void Rebuild(); ///< Rebuild dirty clusters.
+    void MakeBorder(size_t, bool); ///< Find the entrances on a border.
+    void CollectTiles(size_t); ///< List a cluster's entrance tiles.
+    void MakeCosts(size_t); ///< Cache a cluster's entrance costs.
+    void MakeGraph(); ///< Join the clusters into the abstract graph.
+    void SearchCluster(size_t, size_t); ///< Find costs within a cluster.
+    const float GetLocal(size_t, size_t) const; ///< Get cost to a tile in a cluster.
+    bool SearchAbstract(size_t, size_t, size_t, size_t); ///< Search the abstract graph.
+
+  public:
+    CPathHierarchy(size_t=8); ///< Constructor.
+
+    void Update(); ///< Catch up with map changes.
+    bool FindPath(const Vector2&, const Vector2&, std::vector<Vector2>&); ///< Find a path.
+    const SHierarchyStats& GetStats() const; ///< Reader function for statistics.
+}; //CPathHierarchy
+
+#endif //__L4RC_GAME_PATHHIERARCHY_H__
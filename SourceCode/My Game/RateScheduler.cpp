@@ -0,0 +1,123 @@
+/// \file RateScheduler.cpp
+/// \brief Code for the multi-rate scheduler CRateScheduler.
+
+#include "RateScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+/// Name the subsystems. They all start out being updated once every frame.
+
+CRateScheduler::CRateScheduler(){
+  const char* names[] = {"Physics", "AI", "Camera", "Particles"};
+
+  for(UINT i=0; i<(UINT)eSubsystem::Size; i++)
+    m_sSubsystem[i].m_strName = names[i];
+} //constructor
+
+/// Set the time between updates of a subsystem.
+/// \param e Subsystem.
+/// \param t Time between updates in seconds, or 0 for once every frame.
+/// \param n Most updates per frame. If more are due, the rest are dropped.
+
+void CRateScheduler::SetStep(eSubsystem e, float t, UINT n){
+  SSubsystem& s = m_sSubsystem[(UINT)e]; //shorthand
+
+  s.m_fStep = std::max(t, 0.0f);
+  s.m_nMaxTicks = std::max(n, 1u);
+  s.m_fAccumulator = 0;
+  s.m_fAlpha = 0;
+} //SetStep
+
+/// Set the update frequency of a subsystem.
+/// \param e Subsystem.
+/// \param f Updates per second, or 0 for once every frame.
+/// \param n Most updates per frame. If more are due, the rest are dropped.
+
+void CRateScheduler::SetRate(eSubsystem e, float f, UINT n){
+  SetStep(e, f > 0? 1.0f/f: 0.0f, n);
+} //SetRate
+
+/// Add a frame's time to a subsystem's accumulator and take off as many
+/// whole steps as fit, up to the maximum number of updates per frame. If the
+/// maximum is reached, the backlog is thrown away so that the subsystem slows
+/// down instead of falling further and further behind.
+/// \param e Subsystem.
+/// \param t Frame time in seconds.
+/// \return Number of updates due this frame.
+
+UINT CRateScheduler::Advance(eSubsystem e, float t){
+  SSubsystem& s = m_sSubsystem[(UINT)e]; //shorthand
+  UINT n = 0; //number of updates due
+
+  if(s.m_fStep <= 0)n = 1; //every frame
+
+  else{
+    s.m_fAccumulator += t;
+
+    while(s.m_fAccumulator >= s.m_fStep && n < s.m_nMaxTicks){
+      s.m_fAccumulator -= s.m_fStep;
+      n++;
+    } //while
+
+    if(n == s.m_nMaxTicks) //fell behind
+      s.m_fAccumulator = std::min(s.m_fAccumulator, s.m_fStep); //drop the backlog
+
+    s.m_fAlpha = std::min(s.m_fAccumulator/s.m_fStep, 1.0f); //interpolation fraction
+  } //else
+
+  s.m_nTicks = n;
+  s.m_nFrames++;
+  s.m_nTotalTicks += n;
+  if(n == 0)s.m_nIdleFrames++;
+
+  return n;
+} //Advance
+
+/// Zero the update counts of all subsystems, for example to measure a
+/// replay only.
+
+void CRateScheduler::ResetStats(){
+  for(SSubsystem& s: m_sSubsystem)
+    s.m_nTicks = s.m_nFrames = s.m_nTotalTicks = s.m_nIdleFrames = 0;
+} //ResetStats
+
+/// Get the fraction of a step that has passed since a subsystem was last
+/// updated, for interpolating between updates.
+/// \param e Subsystem.
+/// \return Fraction of a step in [0, 1].
+
+const float CRateScheduler::GetAlpha(eSubsystem e) const{
+  return m_sSubsystem[(UINT)e].m_fAlpha;
+} //GetAlpha
+
+/// Get the update frequency of a subsystem.
+/// \param e Subsystem.
+/// \return Updates per second, or 0 for once every frame.
+
+const float CRateScheduler::GetRate(eSubsystem e) const{
+  const float t = m_sSubsystem[(UINT)e].m_fStep; //shorthand
+  return t > 0? 1.0f/t: 0.0f;
+} //GetRate
+
+/// Get the number of physics steps between updates of a subsystem that runs
+/// on physics steps, such as the AI. This is the subsystem's step divided by
+/// the physics step, rounded to the nearest whole number but at least 1.
+/// \param e Subsystem.
+/// \return Physics steps between updates.
+
+const UINT CRateScheduler::GetInterval(eSubsystem e) const{
+  const float t = m_sSubsystem[(UINT)e].m_fStep; //shorthand
+  const float tPhysics = m_sSubsystem[(UINT)eSubsystem::Physics].m_fStep; //shorthand
+
+  if(t <= 0 || tPhysics <= 0)return 1; //every step
+  return std::max(1u, (UINT)std::lround(t/tPhysics));
+} //GetInterval
+
+/// Get a subsystem's schedule, including its update counts.
+/// \param e Subsystem.
+/// \return The subsystem's schedule.
+
+const SSubsystem& CRateScheduler::Get(eSubsystem e) const{
+  return m_sSubsystem[(UINT)e];
+} //Get
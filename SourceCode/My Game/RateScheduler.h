@@ -0,0 +1,68 @@
+/// \file RateScheduler.h
+/// \brief Interface for the multi-rate scheduler CRateScheduler.
+
+#ifndef __L4RC_GAME_RATESCHEDULER_H__
+#define __L4RC_GAME_RATESCHEDULER_H__
+
+#include "Defines.h"
+
+/// \brief Subsystem enumerated type.
+///
+/// The parts of a frame that are updated at their own rates. `Size` is the
+/// number of subsystems.
+
+enum class eSubsystem{
+  Physics, AI, Camera, Particles, Size
+}; //eSubsystem
+
+/// \brief A subsystem's schedule.
+///
+/// How often a subsystem is updated, how much frame time it has not yet been
+/// updated for, and how many updates it has had.
+
+struct SSubsystem{
+  const char* m_strName = ""; ///< Subsystem name.
+  float m_fStep = 0; ///< Time between updates in seconds, 0 for every frame.
+  UINT m_nMaxTicks = 1; ///< Most updates per frame.
+  float m_fAccumulator = 0; ///< Frame time not yet updated for.
+  float m_fAlpha = 0; ///< Fraction of a step since the last update.
+
+  UINT m_nTicks = 0; ///< Updates last frame.
+  UINT m_nFrames = 0; ///< Frames so far.
+  UINT m_nTotalTicks = 0; ///< Updates so far.
+  UINT m_nIdleFrames = 0; ///< Frames so far with no update.
+}; //SSubsystem
+
+/// \brief The multi-rate scheduler.
+///
+/// Each subsystem declares how often it wants to be updated. Once a frame,
+/// `Advance()` adds the frame time to a subsystem's accumulator and says how
+/// many whole steps are due, keeping the rest for next frame, so that a
+/// subsystem running slower than the frame rate is updated on only some of
+/// the frames and one running faster is updated more than once on some. A
+/// subsystem with a step of zero is updated exactly once every frame. The
+/// fraction of a step left over is for interpolating between updates.
+///
+/// The AI is the exception. It must run on simulation steps so that replays
+/// come out the same, so its rate is turned into a number of physics steps
+/// between AI updates by `GetInterval()` instead.
+
+class CRateScheduler{
+  private:
+    SSubsystem m_sSubsystem[(UINT)eSubsystem::Size]; ///< Schedules.
+
+  public:
+    CRateScheduler(); ///< Constructor.
+
+    void SetStep(eSubsystem, float, UINT=1); ///< Set time between updates.
+    void SetRate(eSubsystem, float, UINT=1); ///< Set update frequency.
+    UINT Advance(eSubsystem, float); ///< Add frame time and get updates due.
+    void ResetStats(); ///< Zero the update counts.
+
+    const float GetAlpha(eSubsystem) const; ///< Get fraction of a step since last update.
+    const float GetRate(eSubsystem) const; ///< Get update frequency.
+    const UINT GetInterval(eSubsystem) const; ///< Get physics steps between updates.
+    const SSubsystem& Get(eSubsystem) const; ///< Get a subsystem's schedule.
+}; //CRateScheduler
+
+#endif //__L4RC_GAME_RATESCHEDULER_H__
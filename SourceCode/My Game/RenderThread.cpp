@@ -0,0 +1,188 @@
+/// \file RenderThread.cpp
+/// \brief Code for the render thread CRenderThread.
+
+#include "RenderThread.h"
+
+/// Remember the drawing function and start the render thread if required.
+/// \param f Function that draws a snapshot.
+/// \param bThreaded Draw on a render thread.
+
+CRenderThread::CRenderThread(const std::function<void(const SWorldSnapshot&)>& f,
+  bool bThreaded): m_fnDraw(f)
+{
+  m_tStatsStart = std::chrono::steady_clock::now();
+  if(bThreaded)Start();
+} //constructor
+
+/// Draw anything that is still waiting to be drawn, then stop the render
+/// thread.
+
+CRenderThread::~CRenderThread(){
+  Stop();
+} //destructor
+
+/// The render thread waits for a snapshot to be published, draws it, and
+/// tells the simulation that the buffer is free again. A snapshot that is
+/// published before the thread is told to quit is drawn before it quits.
+
+void CRenderThread::ThreadLoop(){
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while(true){
+    m_cv.wait(lock, [&](){return m_bQuit || m_bFull;});
+
+    if(m_bFull){ //draw the front buffer
+      const SWorldSnapshot& s = m_snapshot[m_nBack ^ 1]; //front buffer
+
+      lock.unlock(); //simulation can carry on with the back buffer
+      Draw(s);
+      lock.lock();
+
+      m_bFull = false;
+      m_cv.notify_all(); //front buffer is free
+    } //if
+
+    else break; //quit
+  } //while
+} //ThreadLoop
+
+/// Draw a snapshot and add its draw time and latency to the statistics. The
+/// latency is measured from when the input for the snapshot was read to
+/// when it has been drawn.
+/// \param s Snapshot.
+
+void CRenderThread::Draw(const SWorldSnapshot& s){
+  const auto t0 = std::chrono::steady_clock::now();
+  m_fnDraw(s);
+  const auto t1 = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_nFrames++;
+  m_fRenderTotal += std::chrono::duration<double, std::milli>(t1 - t0).count();
+  m_fLatencyTotal += std::chrono::duration<double, std::milli>(t1 - s.m_tInput).count();
+} //Draw
+
+/// Start the render thread, if it isn't already running.
+
+void CRenderThread::Start(){
+  if(m_thread.joinable())return; //already running
+  m_thread = std::thread(&CRenderThread::ThreadLoop, this);
+} //Start
+
+/// Stop the render thread, if it's running, after it draws anything that
+/// has been published.
+
+void CRenderThread::Stop(){
+  if(!m_thread.joinable())return; //not running
+
+  { std::lock_guard<std::mutex> lock(m_mutex);
+    m_bQuit = true;
+  } //lock
+
+  m_cv.notify_all();
+  m_thread.join();
+  m_bQuit = false;
+} //Stop
+
+/// Get the back buffer, which is the snapshot that the simulation fills in.
+/// Only the simulation thread may call this.
+/// \return Reference to the back buffer.
+
+SWorldSnapshot& CRenderThread::GetBackBuffer(){
+  return m_snapshot[m_nBack];
+} //GetBackBuffer
+
+/// Create a particle. The particle is added to the back buffer and is
+/// created in the particle system when the snapshot is drawn. Only the
+/// simulation thread may call this.
+/// \param d Particle descriptor.
+
+void CRenderThread::SpawnParticle(const LParticleDesc2D& d){
+  m_snapshot[m_nBack].m_vecParticles.push_back(d);
+} //SpawnParticle
+
+/// Hand over the back buffer to be drawn. If threaded, wait until the render
+/// thread has finished drawing the front buffer, then swap the buffers and
+/// wake up the render thread. Otherwise just draw the back buffer now. Either
+/// way the particles in the buffer that will be filled in next have been
+/// created already, so they are removed from it.
+
+void CRenderThread::Publish(){
+  if(!m_thread.joinable()){ //not threaded
+    SWorldSnapshot& s = m_snapshot[m_nBack]; //shorthand
+    Draw(s);
+    s.m_vecParticles.clear();
+    return;
+  } //if
+
+  { std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [&](){return !m_bFull;}); //front buffer is free
+
+    m_nBack ^= 1; //swap buffers
+    m_bFull = true; //new front buffer needs drawing
+  } //lock
+
+  m_cv.notify_all();
+  m_snapshot[m_nBack].m_vecParticles.clear(); //old front buffer, already drawn
+} //Publish
+
+/// Wait until everything that has been published has been drawn, so that
+/// the drawing function isn't reading anything when it is changed.
+
+void CRenderThread::Flush(){
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [&](){return !m_bFull;});
+} //Flush
+
+/// Reader function for the threaded flag.
+/// \return true if the snapshots are drawn on the render thread.
+
+const bool CRenderThread::IsThreaded() const{
+  return m_thread.joinable();
+} //IsThreaded
+
+/// Start or stop drawing on the render thread, and reset the statistics so
+/// that they only cover one mode.
+/// \param bThreaded Draw on the render thread.
+
+void CRenderThread::SetThreaded(bool bThreaded){
+  if(bThreaded == IsThreaded())return; //nothing to do
+
+  if(bThreaded)Start();
+  else Stop();
+
+  ResetStats();
+} //SetThreaded
+
+/// Get the render statistics since they were last reset.
+/// \return Render statistics.
+
+SRenderStats CRenderThread::GetStats(){
+  const auto t = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  SRenderStats stats;
+
+  stats.m_bThreaded = m_thread.joinable();
+  stats.m_nFrames = m_nFrames;
+
+  if(m_nFrames > 0){
+    const double secs = std::chrono::duration<double>(t - m_tStatsStart).count();
+    stats.m_fFrameRate = secs > 0? float(m_nFrames/secs): 0.0f;
+    stats.m_fRenderTime = float(m_fRenderTotal/m_nFrames);
+    stats.m_fLatency = float(m_fLatencyTotal/m_nFrames);
+  } //if
+
+  return stats;
+} //GetStats
+
+/// Reset the render statistics.
+
+void CRenderThread::ResetStats(){
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_tStatsStart = std::chrono::steady_clock::now();
+  m_nFrames = 0;
+  m_fRenderTotal = 0;
+  m_fLatencyTotal = 0;
+} //ResetStats
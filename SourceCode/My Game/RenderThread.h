@@ -0,0 +1,165 @@
+/// \file RenderThread.h
+/// \brief Interface for the render thread CRenderThread.
+
+#ifndef __L4RC_GAME_RENDERTHREAD_H__
+#define __L4RC_GAME_RENDERTHREAD_H__
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Defines.h"
+#include "SpriteDesc.h"
+#include "Particle.h"
+#include "JobSystem.h"
+#include "FrameBudget.h"
+#include "RateScheduler.h"
+
+/// \brief Render statistics.
+///
+/// Averages over the frames drawn since the statistics were last reset.
+
+struct SRenderStats{
+  bool m_bThreaded = false; ///< Drawn on the render thread.
+  UINT m_nFrames = 0; ///< Number of frames drawn.
+  float m_fFrameRate = 0; ///< Frames drawn per second of wall-clock time.
+  float m_fRenderTime = 0; ///< Time to draw a snapshot in ms.
+  float m_fLatency = 0; ///< Time from reading input to finishing drawing in ms.
+}; //SRenderStats
+
+/// \brief The debug HUD state.
+///
+/// The frame rate, render statistics, job timings and update rates that the
+/// debug HUD shows. These are gathered when there is time left in a frame,
+/// which may not be every frame, so the game keeps the latest ones and
+/// copies them into every snapshot.
+
+struct SDebugHud{
+  int m_nFPS = 0; ///< Frame rate.
+  std::vector<SJobTiming> m_vecJobTimings; ///< Last frame's job timings.
+  float m_fCriticalPath = 0; ///< Last frame's critical path in ms.
+  SSubsystem m_sSubsystem[(UINT)eSubsystem::Size]; ///< Subsystem update rates and counts.
+  float m_fThinkFraction = 1; ///< Fraction of AI steps run.
+  SRenderStats m_stats; ///< Render statistics.
+  float m_fRestartTime = 0; ///< Last level start to end of its first frame in ms.
+  bool m_bRestored = false; ///< Last level start was from a snapshot.
+  bool m_bThinkLOD = false; ///< Far away AI runs at less than the full rate.
+  SBudgetStats m_sBudget; ///< Frame budget statistics.
+  float m_fBudget = 0; ///< Frame time budget in ms.
+}; //SDebugHud
+
+/// \brief The HUD state.
+///
+/// Everything that the heads-up display shows, copied out of the player, the
+/// object manager, the job system and the render thread when a snapshot is
+/// taken. The numbers are turned into text when the snapshot is drawn, not
+/// when it is taken.
+
+struct SHudState{
+  bool m_bPlayerAlive = false; ///< Player exists.
+
+  UINT m_nHealth = 0; ///< Player's health.
+  UINT m_nMaxHealth = 0; ///< Player's maximum health.
+  UINT m_nFocus = 0; ///< Player's focus.
+  UINT m_nMaxFocus = 0; ///< Player's maximum focus.
+  UINT m_nStamina = 0; ///< Player's stamina.
+  UINT m_nMaxStamina = 0; ///< Player's maximum stamina.
+  UINT m_nCombo = 0; ///< Player's combo.
+  UINT m_nPlayerDamage = 0; ///< Player's damage.
+  INT m_nWeaponSelector = 0; ///< Player's current weapon.
+  UINT m_nRevolverMag = 0; ///< Rounds in the revolver.
+  UINT m_nRevolverFullMag = 0; ///< Revolver capacity.
+  UINT m_nPistolMag = 0; ///< Rounds in the pistol.
+  UINT m_nPistolFullMag = 0; ///< Pistol capacity.
+  UINT m_nShotgunMag = 0; ///< Rounds in the shotgun.
+  UINT m_nShotgunFullMag = 0; ///< Shotgun capacity.
+  bool m_bIsFocusing = false; ///< Player is focusing.
+  bool m_bIsReloading = false; ///< Player is reloading.
+  UINT m_nDifficulty = 0; ///< Difficulty modifier.
+
+  bool m_bDrawFrameRate = false; ///< Draw the frame rate.
+  bool m_bDrawJobTimes = false; ///< Draw the job timings.
+  bool m_bDrawAABBs = false; ///< Draw the AABBs.
+  bool m_bGodMode = false; ///< God mode is on.
+
+  SDebugHud m_debug; ///< Debug HUD state.
+}; //SHudState
+
+/// \brief A world snapshot.
+///
+/// An immutable copy of everything needed to draw one frame, made by the
+/// simulation at the end of a frame. The sprites are already interpolated
+/// and sorted into layers. Particles are only drawn, never simulated, so the
+/// particle system belongs to whoever draws the snapshots and the snapshot
+/// carries the particles created since the last one. It also carries the
+/// time to step them by and how far to interpolate them, worked out from the
+/// frame time, since the timer is ticked by the simulation and must not be
+/// read while drawing.
+
+struct SWorldSnapshot{
+  Vector3 m_vCameraPos; ///< Camera position.
+  std::vector<LSpriteDesc2D> m_vecSprites; ///< Sprites in drawing order.
+  std::vector<LParticleDesc2D> m_vecParticles; ///< Particles to create.
+  float m_fParticleStep = 0; ///< Time to step particles by in seconds, 0 if not due.
+  float m_fParticleAlpha = 1; ///< Fraction of a particle step since the last one.
+  SHudState m_hud; ///< HUD state.
+
+  std::chrono::steady_clock::time_point m_tInput; ///< When input was read.
+}; //SWorldSnapshot
+
+/// \brief The render thread.
+///
+/// Draws world snapshots. The simulation fills in the back buffer, then
+/// publishes it, which makes it the front buffer. If threaded, a render
+/// thread draws the front buffer while the simulation fills in the back
+/// buffer for the next frame, so the simulation is at most one frame ahead
+/// of what is on the screen. Otherwise the snapshot is drawn on the calling
+/// thread when it is published, which gives a baseline to compare against.
+/// Either way the same snapshots are drawn by the same function.
+///
+/// Anything that the drawing function reads other than the snapshot, such as
+/// the tile map, must not be changed without calling `Flush()` first.
+
+class CRenderThread{
+  private:
+    std::function<void(const SWorldSnapshot&)> m_fnDraw; ///< Draws a snapshot.
+
+    SWorldSnapshot m_snapshot[2]; ///< Double buffer.
+    UINT m_nBack = 0; ///< Index of the back buffer.
+
+    std::thread m_thread; ///< Render thread.
+    std::mutex m_mutex; ///< Lock.
+    std::condition_variable m_cv; ///< Signals changes of state.
+    bool m_bFull = false; ///< The front buffer has not been drawn yet.
+    bool m_bQuit = false; ///< Render thread should exit.
+
+    std::chrono::steady_clock::time_point m_tStatsStart; ///< Start of stats.
+    UINT m_nFrames = 0; ///< Frames drawn since stats reset.
+    double m_fRenderTotal = 0; ///< Total draw time in ms.
+    double m_fLatencyTotal = 0; ///< Total latency in ms.
+
+    void ThreadLoop(); ///< Render thread loop.
+    void Draw(const SWorldSnapshot&); ///< Draw a snapshot and time it.
+    void Start(); ///< Start the render thread.
+    void Stop(); ///< Stop the render thread.
+
+  public:
+    CRenderThread(const std::function<void(const SWorldSnapshot&)>&, bool); ///< Constructor.
+    ~CRenderThread(); ///< Destructor.
+
+    SWorldSnapshot& GetBackBuffer(); ///< Get the snapshot being filled in.
+    void SpawnParticle(const LParticleDesc2D&); ///< Create a particle.
+    void Publish(); ///< Hand over the back buffer to be drawn.
+    void Flush(); ///< Wait until everything published has been drawn.
+
+    const bool IsThreaded() const; ///< Drawing on the render thread.
+    void SetThreaded(bool); ///< Draw on the render thread or not.
+
+    SRenderStats GetStats(); ///< Get the render statistics.
+    void ResetStats(); ///< Reset the render statistics.
+}; //CRenderThread
+
+#endif //__L4RC_GAME_RENDERTHREAD_H__
@@ -0,0 +1,187 @@
+/// \file Replay.cpp
+/// \brief Code for the input recorder and player CReplay.
+
+#include "Replay.h"
+
+#include <cstring>
+
+/// Close the replay file, if one is open.
+
+CReplay::~CReplay(){
+  Stop();
+} //destructor
+
+/// Write a value to the replay file as raw bytes.
+/// \param x Value to write.
+
+template<class T> void CReplay::Write(const T& x){
+  fwrite(&x, sizeof(T), 1, m_pFile);
+} //Write
+
+/// Read a value from the replay file as raw bytes.
+/// \param x [out] Value read.
+/// \return true if the whole value was read.
+
+template<class T> bool CReplay::Read(T& x){
+  return fread(&x, sizeof(T), 1, m_pFile) == 1;
+} //Read
+
+/// Open a replay file for writing and write the header.
+/// \param filename Name of replay file.
+/// \param h Replay header.
+/// \return true if the file was opened.
+
+bool CReplay::Record(const char* filename, const SReplayHeader& h){
+  Stop(); //in case something was already open
+
+  fopen_s(&m_pFile, filename, "wb");
+  if(m_pFile == nullptr)return false; //bail out
+
+  Write(h);
+
+  m_eMode = eReplayMode::Record;
+  m_strFileName = filename;
+  m_nFrames = 0;
+  m_tStart = std::chrono::steady_clock::now();
+  return true;
+} //Record
+
+/// Open a replay file for reading and read the header.
+/// \param filename Name of replay file.
+/// \param h [out] Replay header.
+/// \return true if the file was opened and has a header of the right type.
+
+bool CReplay::Play(const char* filename, SReplayHeader& h){
+  Stop(); //in case something was already open
+
+  fopen_s(&m_pFile, filename, "rb");
+  if(m_pFile == nullptr)return false; //bail out
+
+  const SReplayHeader expected; //for magic number and version
+
+  if(!Read(h) || memcmp(h.m_pMagic, expected.m_pMagic, 4) != 0 ||
+    h.m_nVersion != expected.m_nVersion)
+  { //not a replay file, or the wrong version
+    Stop();
+    return false;
+  } //if
+
+  m_eMode = eReplayMode::Play;
+  m_strFileName = filename;
+  m_nFrames = 0;
+  m_bDiverged = false;
+  m_tStart = std::chrono::steady_clock::now();
+  return true;
+} //Play
+
+/// Close the replay file and stop recording or playing back.
+
+void CReplay::Stop(){
+  if(m_pFile)fclose(m_pFile);
+  m_pFile = nullptr;
+  m_eMode = eReplayMode::Off;
+} //Stop
+
+/// Read the next frame from the replay file, including the checksum that
+/// will be compared with the world state at the end of the frame.
+/// \param f [out] Input frame.
+/// \return true if a whole frame was read.
+
+bool CReplay::ReadFrame(SInputFrame& f){
+  if(m_eMode != eReplayMode::Play)return false;
+
+  f = SInputFrame();
+  uint8_t flags = 0;
+
+  if(!Read(f.m_fFrameTime) || !Read(flags))
+    return false; //end of file
+
+  bool bOK = true; //whole frame was read
+
+  if(flags & 1) //keys
+    bOK = Read(f.m_nKeyDown) && Read(f.m_nKeyTriggerDown) && Read(f.m_nKeyTriggerUp);
+
+  if(bOK && (flags & 2)){ //controller
+    f.m_bConnected = true;
+    bOK = Read(f.m_nButtons) && Read(f.m_fLTrigger) && Read(f.m_fRTrigger) &&
+      Read(f.m_vRThumb.x) && Read(f.m_vRThumb.y);
+  } //if
+
+  return bOK && Read(m_nChecksum);
+} //ReadFrame
+
+/// Finish a frame. When recording, write the frame and the checksum of the
+/// world state. When playing back, compare the checksum of the world state
+/// with the recorded one.
+/// \param f Input frame.
+/// \param checksum Checksum of the world state at the end of the frame.
+
+void CReplay::EndFrame(const SInputFrame& f, uint32_t checksum){
+  if(m_eMode == eReplayMode::Record){
+    const bool bKeys = f.m_nKeyDown || f.m_nKeyTriggerDown || f.m_nKeyTriggerUp;
+    const uint8_t flags = (bKeys? 1: 0) | (f.m_bConnected? 2: 0);
+
+    Write(f.m_fFrameTime);
+    Write(flags);
+
+    if(bKeys){
+      Write(f.m_nKeyDown);
+      Write(f.m_nKeyTriggerDown);
+      Write(f.m_nKeyTriggerUp);
+    } //if
+
+    if(f.m_bConnected){
+      Write(f.m_nButtons);
+      Write(f.m_fLTrigger);
+      Write(f.m_fRTrigger);
+      Write(f.m_vRThumb.x);
+      Write(f.m_vRThumb.y);
+    } //if
+
+    Write(checksum);
+  } //if
+
+  else if(m_eMode == eReplayMode::Play)
+    if(!m_bDiverged && checksum != m_nChecksum){ //first difference
+      m_bDiverged = true;
+      m_nDivergedFrame = m_nFrames;
+    } //if
+
+  if(m_eMode != eReplayMode::Off)
+    m_nFrames++;
+} //EndFrame
+
+/// Reader function for the recording flag.
+/// \return true if recording.
+
+const bool CReplay::IsRecording() const{
+  return m_eMode == eReplayMode::Record;
+} //IsRecording
+
+/// Reader function for the playing back flag.
+/// \return true if playing back.
+
+const bool CReplay::IsPlaying() const{
+  return m_eMode == eReplayMode::Play;
+} //IsPlaying
+
+/// Describe the replay so far: the file name, the number of frames, the
+/// wall-clock time taken, and whether the world state matched the recording
+/// on every frame.
+/// \return Summary text.
+
+std::string CReplay::GetSummary() const{
+  const auto t = std::chrono::steady_clock::now() - m_tStart;
+  const double secs = std::chrono::duration<double>(t).count();
+  const double ms = m_nFrames > 0? 1000.0*secs/m_nFrames: 0.0; //per frame
+
+  char buffer[256];
+  int n = snprintf(buffer, sizeof(buffer), "%s: %u frames in %.2f s, %.3f ms/frame, ",
+    m_strFileName.c_str(), m_nFrames, secs, ms);
+
+  if(m_bDiverged)
+    snprintf(buffer + n, sizeof(buffer) - n, "diverged at frame %u", m_nDivergedFrame);
+  else snprintf(buffer + n, sizeof(buffer) - n, "matched");
+
+  return buffer;
+} //GetSummary
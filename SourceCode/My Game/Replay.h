@@ -0,0 +1,82 @@
+/// \file Replay.h
+/// \brief Interface for the input recorder and player CReplay.
+
+#ifndef __L4RC_GAME_REPLAY_H__
+#define __L4RC_GAME_REPLAY_H__
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "Defines.h"
+#include "Input.h"
+
+/// \brief Replay mode.
+
+enum class eReplayMode{
+  Off, Record, Play
+}; //eReplayMode
+
+/// \brief Replay file header.
+///
+/// What is needed to start a replay in the same state as the recording: the
+/// random number seed, the simulation settings, and the AI settings, which
+/// decide on which steps the AI runs and how the ants steer.
+
+struct SReplayHeader{
+  char m_pMagic[4] = {'R', 'R', 'P', 'L'}; ///< File type.
+  uint32_t m_nVersion = 3; ///< File format version.
+  uint32_t m_nSeed = 0; ///< Random number seed.
+  float m_fSimStep = 0; ///< Simulation time step in seconds.
+  uint32_t m_nMaxSimSteps = 0; ///< Maximum simulation steps per frame.
+  uint32_t m_nThinkInterval = 1; ///< Steps between AI steps when near.
+  uint32_t m_nThinkLOD = 0; ///< AI level of detail is on.
+  float m_fThinkNear = 0; ///< Distance within which AI runs at the full rate.
+  uint32_t m_nMaxThinkInterval = 1; ///< Most steps between AI steps.
+  uint32_t m_nSeparation = 0; ///< Ant crowd steering is on.
+  float m_fSeparation = 0; ///< Ant separation distance in radii.
+  float m_fAvoidTime = 0; ///< Ant avoidance look-ahead time in seconds.
+}; //SReplayHeader
+
+/// \brief The input recorder and player.
+///
+/// Records the input frames of a play session to a binary file and plays
+/// them back. The file starts with an `SReplayHeader`. Each frame is stored
+/// as the frame time, a byte of flags saying whether any keys were in use and
+/// whether the controller was connected, the key masks and controller state
+/// if so, and a checksum of the world state at the end of the frame. When
+/// playing back, the checksum of each frame is compared with the recorded
+/// one, so that any difference between the recording and the replay is
+/// caught on the frame where it first happens.
+
+class CReplay{
+  private:
+    eReplayMode m_eMode = eReplayMode::Off; ///< Current mode.
+    FILE* m_pFile = nullptr; ///< Replay file.
+    std::string m_strFileName; ///< Replay file name.
+
+    UINT m_nFrames = 0; ///< Number of frames recorded or played.
+    uint32_t m_nChecksum = 0; ///< Recorded checksum for this frame.
+    bool m_bDiverged = false; ///< A checksum didn't match.
+    UINT m_nDivergedFrame = 0; ///< First frame whose checksum didn't match.
+    std::chrono::steady_clock::time_point m_tStart; ///< Wall-clock start time.
+
+    template<class T> void Write(const T&); ///< Write to file.
+    template<class T> bool Read(T&); ///< Read from file.
+
+  public:
+    ~CReplay(); ///< Destructor.
+
+    bool Record(const char*, const SReplayHeader&); ///< Start recording.
+    bool Play(const char*, SReplayHeader&); ///< Start playing back.
+    void Stop(); ///< Stop recording or playing back.
+
+    bool ReadFrame(SInputFrame&); ///< Read the next frame.
+    void EndFrame(const SInputFrame&, uint32_t); ///< Record or check a frame.
+
+    const bool IsRecording() const; ///< Recording.
+    const bool IsPlaying() const; ///< Playing back.
+    std::string GetSummary() const; ///< Describe the replay so far.
+}; //CReplay
+
+#endif //__L4RC_GAME_REPLAY_H__
@@ -0,0 +1,399 @@
+/// \file Rng.cpp
+/// \brief Code for the random number generators CRng and CCounterRng and the
+/// random number service CRngService.
+
+#include "Rng.h"
+
+#include <emmintrin.h>
+
+/// Get a random number below a bound from a generator, with no bias, by
+/// Lemire's method of multiplying by the bound and keeping the top 32 bits.
+/// Numbers that would make some results more likely than others are thrown
+/// away, which happens very rarely for small bounds.
+/// \param rng Generator.
+/// \param n Bound.
+/// \return A random number in [0, n), or 0 if n is 0.
+
+template<class T> static uint32_t Bounded(T& rng, uint32_t n){
+  uint64_t m = (uint64_t)rng.Next()*n;
+  uint32_t low = (uint32_t)m;
+
+  if(low < n){ //might be biased
+    const uint32_t t = (0u - n)%n; //2^32 mod n
+
+    while(low < t){
+      m = (uint64_t)rng.Next()*n;
+      low = (uint32_t)m;
+    } //while
+  } //if
+
+  return (uint32_t)(m >> 32);
+} //Bounded
+
+/// Turn a random number into a random float using its top 24 bits, which is
+/// all that fits in a float's mantissa.
+/// \param n Random number.
+/// \return A random float in [0, 1).
+
+static inline float ToFloat(uint32_t n){
+  return (n >> 8)*(1.0f/16777216.0f);
+} //ToFloat
+
+/// Create and seed a generator.
+/// \param seed Seed.
+/// \param stream Stream selector.
+
+CRng::CRng(uint64_t seed, uint64_t stream){
+  Seed(seed, stream);
+} //constructor
+
+/// Seed the generator. The same seed and stream selector always give the
+/// same sequence.
+/// \param seed Seed.
+/// \param stream Stream selector.
+
+void CRng::Seed(uint64_t seed, uint64_t stream){
+  m_nState = 0;
+  m_nInc = (stream << 1) | 1; //must be odd
+  Next();
+  m_nState += seed;
+  Next();
+} //Seed
+
+/// Make a new generator that is seeded, and given a stream selector, from
+/// this one's next four outputs. The two generators' sequences are
+/// independent of each other.
+/// \return The new generator.
+
+CRng CRng::Split(){
+  uint32_t n[4]; //one at a time, since the order of calls in an expression isn't fixed
+  Fill(n, 4);
+
+  return CRng((uint64_t)n[0] << 32 | n[1], (uint64_t)n[2] << 32 | n[3]);
+} //Split
+
+/// Get the next random number. Advance the linear congruential generator,
+/// then scramble the old state with an xorshift and a rotation by an amount
+/// taken from its top bits.
+/// \return A random 32-bit number.
+
+uint32_t CRng::Next(){
+  const uint64_t old = m_nState;
+  m_nState = old*6364136223846793005ULL + m_nInc;
+
+  const uint32_t x = (uint32_t)(((old >> 18) ^ old) >> 27); //xorshift
+  const uint32_t r = (uint32_t)(old >> 59); //rotation
+
+  return (x >> r) | (x << ((0u - r) & 31));
+} //Next
+
+/// Get a random number below a bound, with no bias.
+/// \param n Bound.
+/// \return A random number in [0, n), or 0 if n is 0.
+
+uint32_t CRng::Below(uint32_t n){
+  return Bounded(*this, n);
+} //Below
+
+/// Get a random number in a range.
+/// \param lo Smallest number.
+/// \param hi Largest number, which must be at least lo.
+/// \return A random number in [lo, hi].
+
+int CRng::Range(int lo, int hi){
+  return lo + (int)Below((uint32_t)(hi - lo) + 1);
+} //Range
+
+/// Get a random float.
+/// \return A random float in [0, 1).
+
+float CRng::Float(){
+  return ToFloat(Next());
+} //Float
+
+/// Get a random float in a range.
+/// \param lo Bottom of range.
+/// \param hi Top of range.
+/// \return A random float in [lo, hi).
+
+float CRng::Float(float lo, float hi){
+  return lo + (hi - lo)*Float();
+} //Float
+
+/// Fill an array with random numbers, the same ones that calling `Next()`
+/// that many times would give.
+/// \param p Array.
+/// \param n Number of entries.
+
+void CRng::Fill(uint32_t* p, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = Next();
+} //Fill
+
+/// Fill an array with random floats in [0, 1), the same ones that calling
+/// `Float()` that many times would give.
+/// \param p Array.
+/// \param n Number of entries.
+
+void CRng::Fill(float* p, size_t n){
+  for(size_t i=0; i<n; i++)
+    p[i] = Float();
+} //Fill
+
+/// Philox multipliers and key increments.
+
+static const uint32_t PHILOX_M0 = 0xD2511F53; ///< Multiplier for counter word 0.
+static const uint32_t PHILOX_M1 = 0xCD9E8D57; ///< Multiplier for counter word 2.
+static const uint32_t PHILOX_W0 = 0x9E3779B9; ///< Increment for key word 0, the golden ratio.
+static const uint32_t PHILOX_W1 = 0xBB67AE85; ///< Increment for key word 1, sqrt(3) - 1.
+
+/// Compute one Philox4x32-10 block. Each round multiplies counter words 0
+/// and 2 by constants, and swaps and xors the high and low halves of the
+/// products with the other two words and the key. The key is bumped by
+/// constants between rounds.
+/// \param key Key.
+/// \param ctr Counter.
+/// \param out [out] Four random numbers.
+
+static void PhiloxBlock(const uint32_t key[2], const uint32_t ctr[4], uint32_t out[4]){
+  uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+  uint32_t k0 = key[0], k1 = key[1];
+
+  for(int r=0; r<10; r++){
+    if(r > 0){k0 += PHILOX_W0; k1 += PHILOX_W1;} //bump key
+
+    const uint64_t p0 = (uint64_t)PHILOX_M0*c0;
+    const uint64_t p1 = (uint64_t)PHILOX_M1*c2;
+
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)p1;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)p0;
+  } //for
+
+  out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+} //PhiloxBlock
+
+/// Multiply four pairs of 32-bit numbers and split the 64-bit products into
+/// high and low halves. SSE2 only multiplies the even lanes, so the odd lanes
+/// are shifted down and multiplied separately, and the halves are shuffled
+/// back into lane order.
+/// \param a Four numbers.
+/// \param m Four multipliers.
+/// \param lo [out] Low halves of the products.
+/// \param hi [out] High halves of the products.
+
+static inline void MulHiLo(__m128i a, __m128i m, __m128i& lo, __m128i& hi){
+  const __m128i even = _mm_mul_epu32(a, m); //lanes 0 and 2
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m); //lanes 1 and 3
+
+  const __m128i e = _mm_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 2, 0)); //lo0 lo2 hi0 hi2
+  const __m128i o = _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 2, 0)); //lo1 lo3 hi1 hi3
+
+  lo = _mm_unpacklo_epi32(e, o);
+  hi = _mm_unpackhi_epi32(e, o);
+} //MulHiLo
+
+/// Compute four consecutive Philox4x32-10 blocks at once, one per SSE2
+/// lane, then transpose them so that they come out in the same order as
+/// four calls to `PhiloxBlock()` with block indices counting up from the
+/// counter's.
+/// \param key Key.
+/// \param ctr Counter of the first block.
+/// \param out [out] Four blocks, one per vector.
+
+static void PhiloxBlock4(const uint32_t key[2], const uint32_t ctr[4], __m128i out[4]){
+  __m128i c0 = _mm_add_epi32(_mm_set1_epi32((int)ctr[0]), _mm_set_epi32(3, 2, 1, 0));
+  __m128i c1 = _mm_set1_epi32((int)ctr[1]);
+  __m128i c2 = _mm_set1_epi32((int)ctr[2]);
+  __m128i c3 = _mm_set1_epi32((int)ctr[3]);
+
+  __m128i k0 = _mm_set1_epi32((int)key[0]);
+  __m128i k1 = _mm_set1_epi32((int)key[1]);
+
+  const __m128i m0 = _mm_set1_epi32((int)PHILOX_M0);
+  const __m128i m1 = _mm_set1_epi32((int)PHILOX_M1);
+  const __m128i w0 = _mm_set1_epi32((int)PHILOX_W0);
+  const __m128i w1 = _mm_set1_epi32((int)PHILOX_W1);
+
+  for(int r=0; r<10; r++){
+    if(r > 0){k0 = _mm_add_epi32(k0, w0); k1 = _mm_add_epi32(k1, w1);} //bump key
+
+    __m128i lo0, hi0, lo1, hi1;
+    MulHiLo(c0, m0, lo0, hi0);
+    MulHiLo(c2, m1, lo1, hi1);
+
+    c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), k0);
+    c1 = lo1;
+    c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), k1);
+    c3 = lo0;
+  } //for
+
+  const __m128i t0 = _mm_unpacklo_epi32(c0, c1); //blocks 0 and 1, words 0 and 1
+  const __m128i t1 = _mm_unpacklo_epi32(c2, c3); //blocks 0 and 1, words 2 and 3
+  const __m128i t2 = _mm_unpackhi_epi32(c0, c1); //blocks 2 and 3, words 0 and 1
+  const __m128i t3 = _mm_unpackhi_epi32(c2, c3); //blocks 2 and 3, words 2 and 3
+
+  out[0] = _mm_unpacklo_epi64(t0, t1);
+  out[1] = _mm_unpackhi_epi64(t0, t1);
+  out[2] = _mm_unpacklo_epi64(t2, t3);
+  out[3] = _mm_unpackhi_epi64(t2, t3);
+} //PhiloxBlock4
+
+/// Create a keyed generator. The block index starts at zero.
+/// \param seed Seed, which is the key.
+/// \param id Object ID.
+/// \param step Simulation step.
+/// \param e Purpose.
+
+CCounterRng::CCounterRng(uint64_t seed, uint32_t id, uint32_t step, eRngPurpose e){
+  m_nKey[0] = (uint32_t)seed;
+  m_nKey[1] = (uint32_t)(seed >> 32);
+
+  m_nCounter[0] = 0; //block index
+  m_nCounter[1] = (uint32_t)e;
+  m_nCounter[2] = step;
+  m_nCounter[3] = id;
+} //constructor
+
+/// Get the next random number, computing a new block when the current one
+/// is used up.
+/// \return A random 32-bit number.
+
+uint32_t CCounterRng::Next(){
+  if(m_nUsed == 4){ //current block used up
+    PhiloxBlock(m_nKey, m_nCounter, m_nBlock);
+    m_nCounter[0]++;
+    m_nUsed = 0;
+  } //if
+
+  return m_nBlock[m_nUsed++];
+} //Next
+
+/// Get a random number below a bound, with no bias.
+/// \param n Bound.
+/// \return A random number in [0, n), or 0 if n is 0.
+
+uint32_t CCounterRng::Below(uint32_t n){
+  return Bounded(*this, n);
+} //Below
+
+/// Get a random number in a range.
+/// \param lo Smallest number.
+/// \param hi Largest number, which must be at least lo.
+/// \return A random number in [lo, hi].
+
+int CCounterRng::Range(int lo, int hi){
+  return lo + (int)Below((uint32_t)(hi - lo) + 1);
+} //Range
+
+/// Get a random float.
+/// \return A random float in [0, 1).
+
+float CCounterRng::Float(){
+  return ToFloat(Next());
+} //Float
+
+/// Get a random float in a range.
+/// \param lo Bottom of range.
+/// \param hi Top of range.
+/// \return A random float in [lo, hi).
+
+float CCounterRng::Float(float lo, float hi){
+  return lo + (hi - lo)*Float();
+} //Float
+
+/// Fill an array with random numbers, the same ones that calling `Next()`
+/// that many times would give. What is left of the current block is used
+/// first, then sixteen numbers at a time are computed four blocks at once,
+/// and the rest one at a time.
+/// \param p Array.
+/// \param n Number of entries.
+
+void CCounterRng::Fill(uint32_t* p, size_t n){
+  size_t i = 0;
+
+  while(i < n && m_nUsed < 4) //rest of current block
+    p[i++] = m_nBlock[m_nUsed++];
+
+  for(; i + 16 <= n; i += 16){ //four blocks at a time
+    __m128i v[4];
+    PhiloxBlock4(m_nKey, m_nCounter, v);
+    m_nCounter[0] += 4;
+
+    for(int j=0; j<4; j++)
+      _mm_storeu_si128((__m128i*)(p + i + 4*j), v[j]);
+  } //for
+
+  while(i < n) //stragglers
+    p[i++] = Next();
+} //Fill
+
+/// Fill an array with random floats in [0, 1), the same ones that calling
+/// `Float()` that many times would give. Works like the other `Fill()`, but
+/// also converts to float four at a time.
+/// \param p Array.
+/// \param n Number of entries.
+
+void CCounterRng::Fill(float* p, size_t n){
+  size_t i = 0;
+
+  while(i < n && m_nUsed < 4) //rest of current block
+    p[i++] = ToFloat(m_nBlock[m_nUsed++]);
+
+  const __m128 scale = _mm_set1_ps(1.0f/16777216.0f); //2^-24
+
+  for(; i + 16 <= n; i += 16){ //four blocks at a time
+    __m128i v[4];
+    PhiloxBlock4(m_nKey, m_nCounter, v);
+    m_nCounter[0] += 4;
+
+    for(int j=0; j<4; j++){ //top 24 bits fit in a signed int, so convert exactly
+      const __m128 f = _mm_cvtepi32_ps(_mm_srli_epi32(v[j], 8));
+      _mm_storeu_ps(p + i + 4*j, _mm_mul_ps(f, scale));
+    } //for
+  } //for
+
+  while(i < n) //stragglers
+    p[i++] = Float();
+} //Fill
+
+/// Seed all of the streams from the same seed, each with its own stream
+/// selector.
+/// \param seed Seed.
+
+void CRngService::Seed(uint64_t seed){
+  m_nSeed = seed;
+
+  for(size_t i=0; i<(size_t)eRngStream::Size; i++)
+    m_cStream[i].Seed(seed, i);
+} //Seed
+
+/// Get the generator for a stream. Must only be called on the main thread.
+/// \param e Stream.
+/// \return The stream's generator.
+
+CRng& CRngService::Get(eRngStream e){
+  return m_cStream[(size_t)e];
+} //Get
+
+/// Split a new generator off a stream. Must only be called on the main
+/// thread, but the new generator can be used on any thread.
+/// \param e Stream.
+/// \return The new generator.
+
+CRng CRngService::Split(eRngStream e){
+  return m_cStream[(size_t)e].Split();
+} //Split
+
+/// Make a generator keyed by the seed, an object ID, a simulation step, and
+/// a purpose. It gives the same numbers for the same key no matter which
+/// thread makes it or when. This may be called on any thread.
+/// \param id Object ID.
+/// \param step Simulation step.
+/// \param e Purpose.
+/// \return The keyed generator.
+
+CCounterRng CRngService::Keyed(uint32_t id, uint32_t step, eRngPurpose e) const{
+  return CCounterRng(m_nSeed, id, step, e);
+} //Keyed
@@ -0,0 +1,55 @@
+/// \file SimTimer.cpp
+/// \brief Code for the simulation event timer CSimTimer.
+
+#include "SimTimer.h"
+
+/// Create a timer and schedule its first event.
+/// \param t Time between events.
+/// \param d Maximum random variation in the interval (defaults to zero).
+/// \param pRng Random number generator for the variation (defaults to
+/// `nullptr`, which means the timers' stream of the random number service).
+
+CSimTimer::CSimTimer(float t, float d, CRng* pRng):
+  m_fInterval(t), m_fDelta(d),
+  m_pTimerRng(pRng? pRng: &m_pRng->Get(eRngStream::Timers))
+{
+  Reset(m_fSimTime);
+} //constructor
+
+/// Schedule the next event one interval from a given time, give or take a
+/// random amount of at most `m_fDelta`.
+/// \param t Simulation time.
+
+void CSimTimer::Reset(float t){
+  m_fNextTime = t + m_fInterval;
+
+  if(m_fDelta > 0) //only touch the random number generator if we have to
+    m_fNextTime += m_pTimerRng->Float(-m_fDelta, m_fDelta); //random variation
+} //Reset
+
+/// Check whether the next event has happened, and if so schedule another.
+/// \return true If the next event has happened.
+
+bool CSimTimer::Triggered(){
+  return Triggered(m_fSimTime);
+} //Triggered
+
+/// Check whether the next event had happened by a given simulation time, and
+/// if so schedule another one interval after it. This is for work that was
+/// decided on at that time but done later.
+/// \param t Simulation time.
+/// \return true If the next event had happened.
+
+bool CSimTimer::Triggered(float t){
+  if(t < m_fNextTime)return false; //not yet
+
+  Reset(t); //schedule the next one
+  return true;
+} //Triggered
+
+/// Set the interval between events. This takes effect after the next event.
+/// \param t Time between events.
+
+void CSimTimer::SetDelay(float t){
+  m_fInterval = t;
+} //SetDelay
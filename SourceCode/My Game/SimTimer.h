@@ -0,0 +1,40 @@
+/// \file SimTimer.h
+/// \brief Interface for the simulation event timer CSimTimer.
+
+#ifndef __L4RC_GAME_SIMTIMER_H__
+#define __L4RC_GAME_SIMTIMER_H__
+
+#include "Common.h"
+#include "Component.h"
+#include "Rng.h"
+
+/// \brief The simulation event timer.
+///
+/// A drop-in replacement for `LEventTimer` that runs on the simulation clock
+/// `m_fSimTime` instead of the frame clock, so that an event fires on the
+/// same simulation step no matter how many steps are taken per frame. A
+/// timer with a random variation in its interval draws from the generator
+/// that it was given, or from the timers' stream of the random number
+/// service if none, in which case it must only be used on the main thread.
+
+class CSimTimer:
+  public CCommon,
+  public LComponent
+{
+  private:
+    float m_fInterval = 0; ///< Time between events.
+    float m_fDelta = 0; ///< Maximum random variation in the interval.
+    float m_fNextTime = 0; ///< Simulation time of next event.
+    CRng* m_pTimerRng = nullptr; ///< Random number generator for the variation.
+
+    void Reset(float); ///< Schedule the next event.
+
+  public:
+    CSimTimer(float, float=0, CRng* =nullptr); ///< Constructor.
+
+    bool Triggered(); ///< Has the next event happened?
+    bool Triggered(float); ///< Had the next event happened by a given time?
+    void SetDelay(float); ///< Set the interval between events.
+}; //CSimTimer
+
+#endif //__L4RC_GAME_SIMTIMER_H__
@@ -0,0 +1,155 @@
+/// \file SpawnPool.cpp
+/// \brief Code for the spawn pools CSpawnPool.
+
+#include "SpawnPool.h"
+#include "TileManager.h"
+#include "Settings.h"
+
+#include <algorithm>
+#include <cstring>
+
+std::vector<SSpawnPool> CSpawnPool::m_vecPools;
+
+/// Set the enemies and weights of a pool's band for a given difficulty,
+/// adding the band if there isn't one already. Bands are kept in increasing
+/// order of difficulty.
+/// \param pool Spawn pool.
+/// \param difficulty Lowest difficulty that the band is used at.
+/// \param vecEnemies Enemy types and their weights.
+
+void CSpawnPool::SetBand(SSpawnPool& pool, UINT difficulty,
+  const std::vector<std::pair<eSprite, float>>& vecEnemies)
+{
+  auto it = std::find_if(pool.m_vecBands.begin(), pool.m_vecBands.end(),
+    [&](const SSpawnBand& b){return b.m_nDifficulty >= difficulty;}); //where it goes
+
+  if(it == pool.m_vecBands.end() || it->m_nDifficulty != difficulty){ //new band
+    it = pool.m_vecBands.insert(it, SSpawnBand());
+    it->m_nDifficulty = difficulty;
+  } //if
+
+  std::vector<float> w; //weights
+  it->m_vecEnemies.clear();
+
+  for(const auto& p: vecEnemies){
+    it->m_vecEnemies.push_back(p.first);
+    w.push_back(p.second);
+  } //for
+
+  it->m_cAlias.Build(w);
+} //SetBand
+
+/// Set the default spawn pools, then replace or add any that are given in
+/// the `spawns` tag of `gamesettings.xml`. Each `pool` tag names its map
+/// character and has a `band` tag for each difficulty band, which has a
+/// `spawn` tag for each enemy with the enemy's sprite name and its weight.
+/// Pools for characters that already mean something on the map, such as `W`
+/// for a wall or `T` for a turret, are ignored.
+/// \param pSettings Pointer to the settings tag.
+/// \param vecSprites Sprite types and their names in `gamesettings.xml`.
+
+void CSpawnPool::Load(tinyxml2::XMLElement* pSettings,
+  const std::vector<std::pair<eSprite, const char*>>& vecSprites)
+{
+  m_vecPools.clear();
+
+  SSpawnPool e; //E gets more machine gun turrets as difficulty goes up
+  e.m_chMarker = 'E';
+
+  for(UINT d=0; d<=8; d++)
+    SetBand(e, d, {{eSprite::Ant, 1}, {eSprite::Turret, 3}, {eSprite::MGTurret, (float)d}});
+
+  SSpawnPool r; //R doesn't change with difficulty
+  r.m_chMarker = 'R';
+  SetBand(r, 0, {{eSprite::Ant, 1}, {eSprite::Turret, 3}, {eSprite::MGTurret, 1}});
+
+  m_vecPools.push_back(e);
+  m_vecPools.push_back(r);
+
+  if(pSettings == nullptr)return; //no settings, use defaults
+
+  tinyxml2::XMLElement* pSpawns = pSettings->FirstChildElement("spawns");
+  if(pSpawns == nullptr)return; //no spawns tag, use defaults
+
+  const eSprite spawnable[] = { //enemy types that a map can list
+    eSprite::Ant, eSprite::Turret, eSprite::MGTurret, eSprite::Ghost, eSprite::BossTurret
+  }; //spawnable
+
+  for(tinyxml2::XMLElement* pPool = pSpawns->FirstChildElement("pool");
+    pPool; pPool = pPool->NextSiblingElement("pool"))
+  {
+    const char* marker = pPool->Attribute("marker");
+    if(marker == nullptr || marker[0] == 0)continue; //no marker
+    if(strchr("FWCPTAGBM", marker[0]))continue; //already means something
+
+    SSpawnPool pool; //replaces the default, if any
+    pool.m_chMarker = marker[0];
+
+    for(tinyxml2::XMLElement* pBand = pPool->FirstChildElement("band");
+      pBand; pBand = pBand->NextSiblingElement("band"))
+    {
+      std::vector<std::pair<eSprite, float>> vecEnemies; //enemies and weights
+
+      for(tinyxml2::XMLElement* pSpawn = pBand->FirstChildElement("spawn");
+        pSpawn; pSpawn = pSpawn->NextSiblingElement("spawn"))
+      {
+        const char* enemy = pSpawn->Attribute("enemy");
+        if(enemy == nullptr)continue; //no enemy
+
+        auto it = std::find_if(vecSprites.begin(), vecSprites.end(),
+          [&](const std::pair<eSprite, const char*>& p){return strcmp(p.second, enemy) == 0;});
+
+        if(it == vecSprites.end() || //unknown sprite
+          std::find(std::begin(spawnable), std::end(spawnable), it->first) == std::end(spawnable))
+          continue; //or not an enemy
+
+        vecEnemies.push_back({it->first, pSpawn->FloatAttribute("weight", 1.0f)});
+      } //for
+
+      SetBand(pool, pBand->UnsignedAttribute("difficulty", 0), vecEnemies);
+    } //for
+
+    const int i = Find(pool.m_chMarker); //existing pool
+    if(i < 0)m_vecPools.push_back(pool);
+    else m_vecPools[i] = pool;
+  } //for
+} //Load
+
+/// Find the spawn pool for a map character.
+/// \param c Map character.
+/// \return Index of the pool, or -1 if the character isn't a marker.
+
+const int CSpawnPool::Find(char c){
+  for(size_t i=0; i<m_vecPools.size(); i++)
+    if(m_vecPools[i].m_chMarker == c)
+      return (int)i;
+
+  return -1;
+} //Find
+
+/// Pick an enemy for each marker tile and add it to a spawn manifest. First
+/// find each pool's band for the difficulty, which is the last one that
+/// starts at or below it, then sample all of the markers in one pass. A
+/// marker whose band is missing or has no weight spawns nothing.
+/// \param vecMarkers Marker tiles in map order.
+/// \param difficulty Difficulty.
+/// \param rng Random number generator.
+/// \param m [out] Spawn manifest.
+
+void CSpawnPool::Resolve(const std::vector<SSpawnMarker>& vecMarkers,
+  UINT difficulty, CRng& rng, SSpawnManifest& m)
+{
+  std::vector<const SSpawnBand*> band(m_vecPools.size(), nullptr); //band for each pool
+
+  for(size_t i=0; i<m_vecPools.size(); i++)
+    for(const SSpawnBand& b: m_vecPools[i].m_vecBands)
+      if(b.m_nDifficulty <= difficulty)
+        band[i] = &b; //bands are in increasing order
+
+  for(const SSpawnMarker& s: vecMarkers){
+    const SSpawnBand* p = band[s.m_nPool]; //shorthand
+
+    if(p && !p->m_cAlias.empty())
+      m.Add(p->m_vecEnemies[p->m_cAlias.Sample(rng)], s.m_vPos);
+  } //for
+} //Resolve
@@ -0,0 +1,69 @@
+/// \file SpawnPool.h
+/// \brief Interface for the spawn pools CSpawnPool.
+
+#ifndef __L4RC_GAME_SPAWNPOOL_H__
+#define __L4RC_GAME_SPAWNPOOL_H__
+
+#include "GameDefines.h"
+#include "AliasTable.h"
+#include "Rng.h"
+
+#include <utility>
+#include <vector>
+
+namespace tinyxml2{class XMLElement;}
+struct SSpawnManifest; //forward declaration
+
+/// \brief A difficulty band.
+///
+/// The enemies that a spawn pool picks from, with their weights, from a
+/// given difficulty up to the next band's.
+
+struct SSpawnBand{
+  UINT m_nDifficulty = 0; ///< Lowest difficulty that the band is used at.
+  std::vector<eSprite> m_vecEnemies; ///< Enemy types.
+  CAliasTable m_cAlias; ///< Alias table over the enemy weights.
+}; //SSpawnBand
+
+/// \brief A spawn pool.
+///
+/// The difficulty bands for the tiles marked with a given map character,
+/// in increasing order of difficulty.
+
+struct SSpawnPool{
+  char m_chMarker = 0; ///< Map character.
+  std::vector<SSpawnBand> m_vecBands; ///< Difficulty bands.
+}; //SSpawnPool
+
+/// \brief A map tile that spawns a random enemy.
+
+struct SSpawnMarker{
+  Vector2 m_vPos; ///< Position.
+  UINT m_nPool = 0; ///< Index of spawn pool.
+}; //SSpawnMarker
+
+/// \brief The spawn pools.
+///
+/// The map characters that spawn a random enemy, such as `E` and `R`, each
+/// have a spawn pool, read from the `spawns` tag in `gamesettings.xml` once
+/// at startup and compiled into alias tables. The tile manager collects the
+/// marker tiles while it reads a map, then resolves them all in one pass
+/// using the band for the current difficulty. Pools that are missing from
+/// the settings keep built-in defaults, and the settings can add new markers.
+
+class CSpawnPool{
+  private:
+    static std::vector<SSpawnPool> m_vecPools; ///< Spawn pools.
+
+    static void SetBand(SSpawnPool&, UINT,
+      const std::vector<std::pair<eSprite, float>>&); ///< Add or replace a band.
+
+  public:
+    static void Load(tinyxml2::XMLElement*,
+      const std::vector<std::pair<eSprite, const char*>>&); ///< Load pools from settings.
+    static const int Find(char); ///< Find the pool for a map character.
+    static void Resolve(const std::vector<SSpawnMarker>&, UINT, CRng&,
+      SSpawnManifest&); ///< Pick enemies for marker tiles.
+}; //CSpawnPool
+
+#endif //__L4RC_GAME_SPAWNPOOL_H__
@@ -1,54 +1,100 @@
-/// \file TileManager.h
-/// \brief Interface for the tile manager CTileManager.
-
-#pragma once
-
-#include <vector>
-
-#include "Common.h"
-#include "Settings.h"
-#include "Sprite.h"
-#include "GameDefines.h"
-#include "Component.h"
-#include "ComponentIncludes.h"
-
-/// \brief The tile manager.
-///
-/// The tile manager is responsible for the tile-based background.
-
-class CTileManager: 
-  public CCommon, 
-  public LSettings,
-  public LComponent     //added for use of timer
-{
-  private:
-    size_t m_nWidth = 0; ///< Number of tiles wide.
-    size_t m_nHeight = 0; ///< Number of tiles high.
-
-    float m_fTileSize = 0.0f; ///< Tile width and height.
-
-    char** m_chMap = nullptr; ///< The level map.
-
-    std::vector<BoundingBox> m_vecWalls; ///< AABBs for the walls.
-    std::vector<Vector2> m_vecTurrets; ///< Turret positions.
-    std::vector<Vector2> m_vecMGTurrets; ///< MG Turret positions.
-    Vector2 m_vPlayer; ///< Player location.
-    std::vector<Vector2> m_vecAnts; ///< Ant positions.
-    std::vector<Vector2> m_vecGhosts; ///< Ghosts positions.
-    std::vector<Vector2> m_vecBoss; ///< Boss location
-    bool iterated = false;
-
-    void MakeBoundingBoxes(); ///< Make bounding boxes for walls.
-
-  public:
-    CTileManager(size_t); ///< Constructor.
-    ~CTileManager(); ///< Destructor.
-
-    void LoadMap(char*); ///< Load a map.
-    void Draw(eSprite); ///< Draw the map with a given tile.
-    void DrawBoundingBoxes(eSprite); ///< Draw the bounding boxes.
-    void GetObjects(std::vector<Vector2>&, std::vector<Vector2>&, std::vector<Vector2>&, Vector2&, std::vector<Vector2>&, std::vector<Vector2>&); ///< Get objects.
-
-    const bool Visible(const Vector2&, const Vector2&, float) const; ///< Check visibility.
-    const bool CollideWithWall(BoundingSphere, Vector2&, float&) const; ///< Object-wall collision test.
+/// \file TileManager.h
+/// \brief Interface for the tile manager CTileManager.
+
+#pragma once
+
+#include <vector>
+
+#include "Common.h"
+#include "Settings.h"
+#include "Sprite.h"
+#include "GameDefines.h"
+#include "Component.h"
+#include "ComponentIncludes.h"
+
+/// \brief A spawn manifest.
+///
+/// The positions of the objects listed on a map, grouped by object type.
+/// The tile manager fills this in when it loads a map, and the object manager
+/// reads it in place to create the objects. The vectors are cleared rather
+/// than freed between levels so that they keep their capacity.
+
+struct SSpawnManifest{
+  Vector2 m_vPlayer; ///< Player position.
+  std::vector<Vector2> m_vecTurrets; ///< Turret positions.
+  std::vector<Vector2> m_vecMGTurrets; ///< MG Turret positions.
+  std::vector<Vector2> m_vecAnts; ///< Ant positions.
+  std::vector<Vector2> m_vecGhosts; ///< Ghost positions.
+  std::vector<Vector2> m_vecBoss; ///< Boss positions.
+
+  void clear(); ///< Clear all positions.
+  void Add(eSprite, const Vector2&); ///< Add an object.
+  const size_t size() const; ///< Number of objects, including the player.
+}; //SSpawnManifest
+
+/// \brief A tile map snapshot.
+///
+/// A flat copy of everything that the tile manager makes when it loads a
+/// map: the map itself row by row, the wall AABBs, and the spawn manifest.
+/// Restoring one of these is a handful of block copies, which is a lot
+/// quicker than reading and parsing the map file and merging the walls.
+
+struct STileSnapshot{
+  size_t m_nWidth = 0; ///< Number of tiles wide.
+  size_t m_nHeight = 0; ///< Number of tiles high.
+  std::vector<char> m_vecMap; ///< The level map, row by row.
+  std::vector<BoundingBox> m_vecWalls; ///< AABBs for the walls.
+  SSpawnManifest m_sManifest; ///< Object positions from the map.
+}; //STileSnapshot
+
+/// \brief The tile manager.
+///
+/// The tile manager is responsible for the tile-based background.
+
+class CTileManager: 
+  public CCommon, 
+  public LSettings,
+  public LComponent     //added for use of timer
+{
+  private:
+    size_t m_nWidth = 0; ///< Number of tiles wide.
+    size_t m_nHeight = 0; ///< Number of tiles high.
+
+    float m_fTileSize = 0.0f; ///< Tile width and height.
+    UINT m_nVersion = 0; ///< Changes whenever the map does.
+    UINT m_nLoadVersion = 0; ///< Version when the map was loaded or restored.
+    std::vector<size_t> m_vecEdits; ///< Tiles changed since then, in order.
+
+    char** m_chMap = nullptr; ///< The level map.
+
+    std::vector<BoundingBox> m_vecWalls; ///< AABBs for the walls.
+    SSpawnManifest m_sManifest; ///< Object positions from the map.
+
+    void MakeBoundingBoxes(); ///< Make bounding boxes for walls.
+
+  public:
+    CTileManager(size_t); ///< Constructor.
+    ~CTileManager(); ///< Destructor.
+
+    void LoadMap(char*); ///< Load a map.
+    void Save(STileSnapshot&) const; ///< Save the map to a snapshot.
+    void Restore(const STileSnapshot&); ///< Restore the map from a snapshot.
+    void Draw(eSprite); ///< Draw the map with a given tile.
+    void DrawBoundingBoxes(eSprite); ///< Draw the bounding boxes.
+    void SetTile(size_t, size_t, char); ///< Change a tile.
+    const SSpawnManifest& GetManifest() const; ///< Get spawn manifest.
+
+    const size_t GetWidth() const; ///< Get number of tiles wide.
+    const size_t GetHeight() const; ///< Get number of tiles high.
+    const float GetTileSize() const; ///< Get tile width and height.
+    const UINT GetVersion() const; ///< Get map version.
+    const UINT GetLoadVersion() const; ///< Get map version when loaded.
+    const std::vector<size_t>& GetEdits() const; ///< Get tiles changed since loaded.
+    const bool IsWall(size_t, size_t) const; ///< Is a wall tile.
+    const char GetChar(size_t, size_t) const; ///< Get a tile's map character.
+    const bool GetTile(const Vector2&, size_t&, size_t&) const; ///< Get tile under a point.
+    const Vector2 GetTileCenter(size_t, size_t) const; ///< Get center of a tile.
+
+    const bool Visible(const Vector2&, const Vector2&, float) const; ///< Check visibility.
+    const bool CollideWithWall(BoundingSphere, Vector2&, float&) const; ///< Object-wall collision test.
 }; //CTileManager
\ No newline at end of file